@@ -0,0 +1,92 @@
+// A simple controller plugin: proportional-derivative control of every joints toward zero.
+// It is restricted to fully actuated robots without freeflyer, namely whose motors are actuating
+// every joints in order, so that the command is directly computed from the configuration.
+// The gains are specified through the option 'config' of ControllerPlugin as "<kp> <kd>".
+//
+// The plugin only depends on the self-contained C interface of Jiminy. It is loaded as follows:
+//
+//     auto controller = std::make_shared<ControllerPlugin>();
+//     configHolder_t ctrlOptions = controller->getOptions();
+//     boost::get<std::string>(ctrlOptions.at("libraryPath")) = "/path/to/jiminy_controller_plugin";
+//     boost::get<std::string>(ctrlOptions.at("config")) = "50.0 2.0";
+//     controller->setOptions(ctrlOptions);
+//     controller->initialize(robot);
+
+#include <cstdlib>
+#include <new>
+
+#include "jiminy/core/control/ControllerPluginApi.h"
+
+
+namespace
+{
+    struct PdController
+    {
+        uint64_t nmotors;
+        double kp;
+        double kd;
+    };
+
+    void * create(jiminy_controller_plugin_context_t const * context)
+    {
+        // The configuration is directly used as command, which requires full actuation
+        if (context->nq != context->nv || context->nv != context->nmotors)
+        {
+            return nullptr;
+        }
+
+        // Parse the gains
+        char * end = nullptr;
+        double const kp = std::strtod(context->config, &end);
+        if (end == context->config)
+        {
+            return nullptr;
+        }
+        char const * kdStart = end;
+        double const kd = std::strtod(kdStart, &end);
+        if (end == kdStart)
+        {
+            return nullptr;
+        }
+
+        return new (std::nothrow) PdController{context->nmotors, kp, kd};
+    }
+
+    void destroy(void * instance)
+    {
+        delete static_cast<PdController *>(instance);
+    }
+
+    int32_t computeCommand(void         * instance,
+                           double         /* t */,
+                           double const * q,
+                           double const * v,
+                           double const * /* sensorsData */,
+                           double       * command)
+    {
+        PdController const * controller = static_cast<PdController const *>(instance);
+        for (uint64_t i = 0; i < controller->nmotors; ++i)
+        {
+            command[i] = - controller->kp * q[i] - controller->kd * v[i];
+        }
+        return 0;
+    }
+
+    jiminy_controller_plugin_t const PD_CONTROLLER_PLUGIN{
+        JIMINY_CONTROLLER_PLUGIN_ABI_VERSION,
+        &create,
+        &destroy,
+        nullptr,  // No internal state to reset
+        &computeCommand,
+        nullptr,  // No internal dynamics
+        nullptr,  // No internal state to snapshot
+        nullptr,
+        nullptr
+    };
+}
+
+extern "C" JIMINY_CONTROLLER_PLUGIN_EXPORT
+jiminy_controller_plugin_t const * jiminy_controller_plugin(void)
+{
+    return &PD_CONTROLLER_PLUGIN;
+}
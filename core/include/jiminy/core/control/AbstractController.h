@@ -180,6 +180,14 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         configHolder_t getOptions(void) const;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Get the version of the options of the controller, stamped every time they
+        ///             are updated.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t const & getOptionsVersion(void) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
         /// \brief      Set the configuration options of the controller.
@@ -191,7 +199,7 @@ namespace jiminy
         /// \return     Return code to determine whether the execution of the method was successful.
         ///
         ///////////////////////////////////////////////////////////////////////////////////////////////
-        void setOptions(configHolder_t const & ctrlOptions);
+        virtual void setOptions(configHolder_t const & ctrlOptions);
 
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
@@ -248,6 +256,40 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         virtual hresult_t reset(bool_t const & resetDynamicTelemetry = false);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Backup the internal state of the controller, namely everything that may
+        ///             evolve during a simulation and affect the command or the internal dynamics.
+        ///
+        /// \details    The state is empty by default. Controllers having an internal state must
+        ///             override both `saveState` and `restoreState`, otherwise restoring the state
+        ///             of the engine does not rewind them. Memory is only reallocated if the size
+        ///             of the state has changed.
+        ///
+        /// \remark     This method is not intended to be called manually. The Engine is taking care
+        ///             of it when its own `saveState` method is called.
+        ///
+        /// \param[out] state   Internal state of the controller
+        ///
+        /// \return     Return code to determine whether the execution of the method was successful.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t saveState(vectorN_t & state) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Restore the internal state of the controller saved previously by `saveState`.
+        ///
+        /// \remark     This method is not intended to be called manually. The Engine is taking care
+        ///             of it when its own `restoreState` method is called.
+        ///
+        /// \param[in]  state   Internal state of the controller
+        ///
+        /// \return     Return code to determine whether the execution of the method was successful.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t restoreState(vectorN_t const & state);
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
         /// \brief      Get isInitialized_.
@@ -271,6 +313,17 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         bool_t const & getIsTelemetryConfigured(void) const;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Get hasInternalDynamics_.
+        ///
+        /// \details    It is a flag used to determine if the controller actually implements some
+        ///             internal dynamics. If not, the engine does not call 'internalDynamics' at all,
+        ///             which is especially valuable if it is implemented in Python.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        bool_t const & getHasInternalDynamics(void) const;
+
     public:
         std::unique_ptr<controllerOptions_t const> baseControllerOptions_;    ///< Structure with the parameters of the controller
         std::weak_ptr<Robot const> robot_;                                    ///< Robot for which to compute the command and internal dynamics must be computed
@@ -279,7 +332,9 @@ namespace jiminy
     protected:
         bool_t isInitialized_;                  ///< Flag to determine whether the controller has been initialized or not
         bool_t isTelemetryConfigured_;          ///< Flag to determine whether the telemetry of the controller has been initialized or not
+        bool_t hasInternalDynamics_;            ///< Flag to determine whether 'internalDynamics' must be called or can be skipped
         configHolder_t ctrlOptionsHolder_;      ///< Dictionary with the parameters of the controller
+        std::size_t optionsVersion_;            ///< Version of the options of the controller
         TelemetrySender telemetrySender_;       ///< Telemetry sender of the controller used to register and update telemetry variables
 
     private:
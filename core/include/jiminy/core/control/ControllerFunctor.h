@@ -47,6 +47,9 @@ namespace jiminy
         ///                      vectorN_t              & command)
         ///             where I is range(n), with n the number of different type of sensor.
         ///
+        ///             'internalDynamicsFct' may be an empty std::function or a null function
+        ///             pointer, in which case the engine skips the internal dynamics altogether.
+        ///
         /// \param[in]  commandFct              'Callable' computing the command
         /// \param[in]  internalDynamicsFct     'Callable' computing the internal dynamics
         ///
@@ -1,10 +1,29 @@
 #include <cassert>
+#include <type_traits>
 
 #include "jiminy/core/robot/Robot.h"
 
 
 namespace jiminy
 {
+    namespace internal
+    {
+        /// \brief Whether a 'callable' is actually set, namely it is neither an empty
+        ///        std::function nor a null function pointer.
+        template<typename F>
+        bool_t isCallableSet(F const & fct)
+        {
+            if constexpr (std::is_constructible<bool_t, F const &>::value)
+            {
+                return static_cast<bool_t>(fct);
+            }
+            else
+            {
+                return true;
+            }
+        }
+    }
+
     template<typename F1, typename F2>
     ControllerFunctor<F1, F2>::ControllerFunctor(F1 & commandFct,
                                                  F2 & internalDynamicsFct) :
@@ -12,7 +31,7 @@ namespace jiminy
     commandFct_(commandFct),
     internalDynamicsFct_(internalDynamicsFct)
     {
-        // Empty on purpose
+        hasInternalDynamics_ = internal::isCallableSet(internalDynamicsFct_);
     }
 
     template<typename F1, typename F2>
@@ -22,7 +41,7 @@ namespace jiminy
     commandFct_(std::move(commandFct)),
     internalDynamicsFct_(std::move(internalDynamicsFct))
     {
-        // Empty on purpose
+        hasInternalDynamics_ = internal::isCallableSet(internalDynamicsFct_);
     }
 
     template<typename F1, typename F2>
@@ -54,7 +73,10 @@ namespace jiminy
             return hresult_t::ERROR_INIT_FAILED;
         }
 
-        internalDynamicsFct_(t, q, v, sensorsData_, uCustom);  // The sensor data are already up-to-date
+        if (hasInternalDynamics_)
+        {
+            internalDynamicsFct_(t, q, v, sensorsData_, uCustom);  // The sensor data are already up-to-date
+        }
 
         return hresult_t::SUCCESS;
     }
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief          Controller whose implementation is loaded at runtime from a shared library.
+///
+///                 The library must implement the C interface defined in 'ControllerPluginApi.h'.
+///                 It is loaded by the controller itself, so that the command and the internal
+///                 dynamics are evaluated natively in the thread of the engine, without any
+///                 Python involvement whatsoever.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_CONTROLLER_PLUGIN_H
+#define JIMINY_CONTROLLER_PLUGIN_H
+
+#include <boost/dll/shared_library.hpp>
+
+#include "jiminy/core/control/AbstractController.h"
+#include "jiminy/core/control/ControllerPluginApi.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    class ControllerPlugin : public AbstractController
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Dictionary gathering the configuration options of the controller
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual configHolder_t getDefaultControllerOptions(void) override
+        {
+            // Add extra options or update default values
+            configHolder_t config = AbstractController::getDefaultControllerOptions();
+
+            config["libraryPath"] = std::string("");
+            config["entryPoint"] = std::string(JIMINY_CONTROLLER_PLUGIN_ENTRY_POINT);
+            config["config"] = std::string("");
+
+            return config;
+        };
+
+        struct controllerPluginOptions_t : public controllerOptions_t
+        {
+            std::string const libraryPath;  ///< Path or name of the library. Platform-specific prefix and extension can be omitted.
+            std::string const entryPoint;   ///< Name of the symbol returning the descriptor of the plugin
+            std::string const config;       ///< Arbitrary configuration string forwarded to the plugin at creation
+
+            controllerPluginOptions_t(configHolder_t const & options) :
+            controllerOptions_t(options),
+            libraryPath(boost::get<std::string>(options.at("libraryPath"))),
+            entryPoint(boost::get<std::string>(options.at("entryPoint"))),
+            config(boost::get<std::string>(options.at("config")))
+            {
+                // Empty on purpose
+            }
+        };
+
+    public:
+        ControllerPlugin(void);
+        virtual ~ControllerPlugin(void);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Reset the internal state of the controller.
+        ///
+        /// \details    The library is (re)loaded and a new instance of the plugin is created if the
+        ///             options or the dimensions of the robot have changed since the last time.
+        ///             Otherwise, the internal state of the current instance is reset.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t reset(bool_t const & resetDynamicTelemetry = false) override;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Backup and restore the internal state of the instance of the plugin.
+        ///
+        /// \details    The state is empty if the plugin does not implement 'stateSize', in which
+        ///             case it is assumed to have no internal state evolving during a simulation.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t saveState(vectorN_t & state) const override;
+        virtual hresult_t restoreState(vectorN_t const & state) override;
+
+        virtual hresult_t computeCommand(float64_t const & t,
+                                         vectorN_t const & q,
+                                         vectorN_t const & v,
+                                         vectorN_t       & command) override;
+
+        virtual hresult_t internalDynamics(float64_t const & t,
+                                           vectorN_t const & q,
+                                           vectorN_t const & v,
+                                           vectorN_t       & uCustom) override;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Set the configuration options of the controller.
+        ///
+        /// \details    Note that one must reset Jiminy Engine for this to take effect, which reloads
+        ///             the library.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void setOptions(configHolder_t const & ctrlOptions) override;
+
+    private:
+        hresult_t loadPlugin(Robot const & robot);
+        void unloadPlugin(void);
+
+    private:
+        std::unique_ptr<controllerPluginOptions_t const> controllerOptions_;
+        boost::dll::shared_library library_;            ///< Shared library implementing the plugin
+        jiminy_controller_plugin_t const * plugin_;     ///< Descriptor of the plugin, owned by the library
+        void * instance_;                               ///< Instance of the plugin, owned by the controller
+        jiminy_controller_plugin_context_t context_;    ///< Dimensions of the robot for which the instance has been created
+        vectorN_t const * sensorsDataFlat_;             ///< Contiguous buffer of sensor measurements of the robot
+        bool_t isPluginStale_;                          ///< Whether the library must be reloaded at next reset
+    };
+}
+
+#endif //end of JIMINY_CONTROLLER_PLUGIN_H
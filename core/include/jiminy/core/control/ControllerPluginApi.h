@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief          C interface that must be implemented by controllers compiled as plugins.
+///
+///                 A plugin is a shared library exporting, with C linkage, an entry point that
+///                 returns a pointer to a static 'jiminy_controller_plugin_t' descriptor:
+///
+///                     extern "C" JIMINY_CONTROLLER_PLUGIN_EXPORT
+///                     jiminy_controller_plugin_t const * jiminy_controller_plugin(void);
+///
+///                 See 'core/examples/controller_plugin' for a complete example.
+///
+///                 The name of the entry point can be changed through the options of
+///                 ControllerPlugin, so that a single library may ship several controllers.
+///
+///                 Only plain C types are crossing the library boundary, so that plugins do not
+///                 have to be compiled with the same compiler, standard library or dependencies
+///                 than Jiminy itself. This header must remain self-contained for this reason.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_CONTROLLER_PLUGIN_API_H
+#define JIMINY_CONTROLLER_PLUGIN_API_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Version of the interface. It must be bumped every time the layout of the structures
+///        below is modified, since it would break the binary compatibility of existing plugins.
+#define JIMINY_CONTROLLER_PLUGIN_ABI_VERSION 2U
+
+/// \brief Default name of the entry point of a plugin.
+#define JIMINY_CONTROLLER_PLUGIN_ENTRY_POINT "jiminy_controller_plugin"
+
+/// \brief Qualifier exporting the entry point of a plugin from the shared library.
+#if defined(_WIN32) || defined(__CYGWIN__)
+#define JIMINY_CONTROLLER_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define JIMINY_CONTROLLER_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/// \brief Dimensions of the robot, and user-specified configuration of the plugin.
+typedef struct
+{
+    uint64_t nq;                ///< Size of the configuration vector
+    uint64_t nv;                ///< Size of the velocity vector, and of 'uCustom'
+    uint64_t nmotors;           ///< Number of motors, namely size of 'command'
+    uint64_t nsensorsData;      ///< Size of the contiguous buffer of sensor measurements
+    char const * config;        ///< Arbitrary null-terminated string forwarded as-is from the options
+} jiminy_controller_plugin_context_t;
+
+/// \brief Descriptor of a plugin. The functions returning 'int32_t' must return 0 on success.
+typedef struct
+{
+    uint32_t abiVersion;        ///< Must be set to JIMINY_CONTROLLER_PLUGIN_ABI_VERSION
+
+    /// \brief Create a new instance of the controller. Return NULL on failure.
+    void * (*create)(jiminy_controller_plugin_context_t const * context);
+
+    /// \brief Destroy an instance previously returned by 'create'.
+    void (*destroy)(void * instance);
+
+    /// \brief Reset the internal state of an instance. Optional, can be NULL.
+    int32_t (*reset)(void * instance);
+
+    /// \brief Compute the motor command.
+    ///
+    /// \details 'sensorsData' gathers the measurements of every sensor, as laid out by
+    ///          Robot::getSensorsDataFlat. All the buffers are only valid during the call.
+    int32_t (*computeCommand)(void         * instance,
+                              double         t,
+                              double const * q,
+                              double const * v,
+                              double const * sensorsData,
+                              double       * command);
+
+    /// \brief Compute the internal dynamics. Optional, can be NULL, in which case the engine
+    ///        skips it altogether.
+    int32_t (*internalDynamics)(void         * instance,
+                                double         t,
+                                double const * q,
+                                double const * v,
+                                double const * sensorsData,
+                                double       * uCustom);
+
+    /// \brief Size of the internal state of an instance, in number of doubles. Optional, can be
+    ///        NULL if the instance has no internal state evolving during a simulation, in which
+    ///        case 'saveState' and 'restoreState' are ignored. Otherwise, both must be provided.
+    ///
+    /// \details The internal state is used to snapshot and restore a running simulation. It must
+    ///          gather everything that may affect the command or the internal dynamics later on.
+    uint64_t (*stateSize)(void const * instance);
+
+    /// \brief Copy the internal state of an instance in 'state', which has 'stateSize' elements.
+    int32_t (*saveState)(void const * instance, double * state);
+
+    /// \brief Restore the internal state of an instance from 'state', which has 'stateSize' elements.
+    int32_t (*restoreState)(void * instance, double const * state);
+} jiminy_controller_plugin_t;
+
+/// \brief Signature of the entry point of a plugin.
+typedef jiminy_controller_plugin_t const * (*jiminy_controller_plugin_entry_t)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //end of JIMINY_CONTROLLER_PLUGIN_API_H
@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief          Controller evaluating a feed-forward neural network natively.
+///
+///                 The network maps the measurements of every sensor of the robot, as laid out
+///                 by Robot::getSensorsDataFlat, to the motor command. It is typically a policy
+///                 trained by reinforcement learning, which can then be evaluated at every
+///                 update of the controller without leaving the engine loop.
+///
+///                 The parameters of the network can be specified either directly through the
+///                 options 'weights' and 'biases', or loaded from a binary file through the
+///                 option 'weightsPath'. The binary file is packed without any padding, in
+///                 native byte order. Its layout is the following:
+///                     char_t[4]      magic number "JMLP"
+///                     uint32_t       version, which must be 1
+///                     uint32_t       number of layers
+///                     for each layer:
+///                         uint32_t   number of outputs 'n'
+///                         uint32_t   number of inputs 'm'
+///                         float64_t  weights[n * m], in row-major order
+///                         float64_t  biases[n]
+///                 Such a file can be written by 'saveNetwork', or equivalently with numpy:
+///                     f.write(b"JMLP")
+///                     np.array([1, len(weights)], dtype=np.uint32).tofile(f)
+///                     for w, b in zip(weights, biases):
+///                         np.array(w.shape, dtype=np.uint32).tofile(f)
+///                         np.ascontiguousarray(w, dtype=np.float64).tofile(f)
+///                         np.asarray(b, dtype=np.float64).tofile(f)
+///
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_MLP_CONTROLLER_H
+#define JIMINY_MLP_CONTROLLER_H
+
+#include "jiminy/core/control/AbstractController.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    class MlpController : public AbstractController
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Dictionary gathering the configuration options of the controller
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual configHolder_t getDefaultControllerOptions(void) override
+        {
+            // Add extra options or update default values
+            configHolder_t config = AbstractController::getDefaultControllerOptions();
+
+            config["weightsPath"] = std::string("");
+            config["weights"] = std::vector<matrixN_t>();
+            config["biases"] = std::vector<vectorN_t>();
+            config["activation"] = std::string("tanh");
+            config["inputOffset"] = vectorN_t();
+            config["inputScale"] = vectorN_t();
+            config["outputScale"] = vectorN_t();
+
+            return config;
+        };
+
+        struct controllerMlpOptions_t : public controllerOptions_t
+        {
+            std::string const weightsPath;              ///< Path of the binary file storing the parameters of the network. It takes precedence over 'weights' and 'biases' if not empty.
+            std::vector<matrixN_t> const weights;       ///< Weights of each layer, with shape (number of outputs, number of inputs)
+            std::vector<vectorN_t> const biases;        ///< Biases of each layer
+            std::string const activation;               ///< Activation function of the hidden layers. It must be either 'tanh', 'relu' or 'identity'.
+            vectorN_t const inputOffset;                ///< Offset subtracted from the sensor measurements. Empty to disable.
+            vectorN_t const inputScale;                 ///< Scale applied to the sensor measurements after removing the offset. Empty to disable.
+            vectorN_t const outputScale;                ///< Scale applied to the output of the network to get the command. Empty to disable.
+
+            controllerMlpOptions_t(configHolder_t const & options) :
+            controllerOptions_t(options),
+            weightsPath(boost::get<std::string>(options.at("weightsPath"))),
+            weights(boost::get<std::vector<matrixN_t> >(options.at("weights"))),
+            biases(boost::get<std::vector<vectorN_t> >(options.at("biases"))),
+            activation(boost::get<std::string>(options.at("activation"))),
+            inputOffset(boost::get<vectorN_t>(options.at("inputOffset"))),
+            inputScale(boost::get<vectorN_t>(options.at("inputScale"))),
+            outputScale(boost::get<vectorN_t>(options.at("outputScale")))
+            {
+                // Empty on purpose
+            }
+        };
+
+    public:
+        MlpController(void);
+        virtual ~MlpController(void) = default;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Reset the internal state of the controller.
+        ///
+        /// \details    The parameters of the network are (re)loaded if the options have changed, and
+        ///             their dimensions are checked against the robot.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t reset(bool_t const & resetDynamicTelemetry = false) override;
+
+        virtual hresult_t computeCommand(float64_t const & t,
+                                         vectorN_t const & q,
+                                         vectorN_t const & v,
+                                         vectorN_t       & command) override;
+
+        virtual hresult_t internalDynamics(float64_t const & t,
+                                           vectorN_t const & q,
+                                           vectorN_t const & v,
+                                           vectorN_t       & uCustom) override;
+
+        virtual void setOptions(configHolder_t const & ctrlOptions) override;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Write the parameters of a network in a binary file that can be loaded through
+        ///             the option 'weightsPath'.
+        ///
+        /// \param[in]  filename    Path of the file. It is overwritten if it already exists.
+        /// \param[in]  weights     Weights of each layer, with shape (number of outputs, number of inputs)
+        /// \param[in]  biases      Biases of each layer
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        static hresult_t saveNetwork(std::string            const & filename,
+                                     std::vector<matrixN_t> const & weights,
+                                     std::vector<vectorN_t> const & biases);
+
+    private:
+        using matrixRowMajorN_t = Eigen::Matrix<float64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+        enum class activation_t : uint8_t
+        {
+            IDENTITY = 0,
+            TANH = 1,
+            RELU = 2
+        };
+
+        hresult_t loadNetwork(std::vector<matrixRowMajorN_t> & weights,
+                              std::vector<vectorN_t>         & biases) const;
+
+    private:
+        std::unique_ptr<controllerMlpOptions_t const> controllerOptions_;
+        /* Weights are stored in row-major order, so that each output is a contiguous
+           dot product, which vectorizes well for the small batch size of one sample. */
+        std::vector<matrixRowMajorN_t> weights_;    ///< Weights of each layer
+        std::vector<vectorN_t> biases_;             ///< Biases of each layer
+        std::vector<vectorN_t> activations_;        ///< Preallocated output of each layer
+        vectorN_t input_;                           ///< Preallocated normalized input
+        activation_t activation_;                   ///< Activation function of the hidden layers
+        vectorN_t const * sensorsDataFlat_;         ///< Contiguous buffer of sensor measurements of the robot
+        bool_t isNetworkStale_;                     ///< Whether the network must be reloaded at next reset
+    };
+}
+
+#endif //end of JIMINY_MLP_CONTROLLER_H
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief          Low-level Proportional-Derivative controller.
+///
+///                 It computes the motor command natively from the measurements of the encoders
+///                 attached to the actuated joints, following the same control law as the PD
+///                 controller block of gym_jiminy:
+///                     command = - kp * ((q - qTarget) + kd * (v - vTarget)) + uTarget
+///                 where 'uTarget' is an optional feed-forward effort, which turns it into a
+///                 basic impedance controller.
+///
+///                 The targets are stored in buffers owned by the controller, that a higher-level
+///                 policy can update in-place at its own rate, typically in-between two steps
+///                 of the engine. The inner loop is evaluated at every update of the controller
+///                 without leaving C++.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef JIMINY_PD_CONTROLLER_H
+#define JIMINY_PD_CONTROLLER_H
+
+#include "jiminy/core/control/AbstractController.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    class PDController : public AbstractController
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Dictionary gathering the configuration options of the controller
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual configHolder_t getDefaultControllerOptions(void) override
+        {
+            // Add extra options or update default values
+            configHolder_t config = AbstractController::getDefaultControllerOptions();
+
+            config["kp"] = vectorN_t(vectorN_t::Zero(1));
+            config["kd"] = vectorN_t(vectorN_t::Zero(1));
+
+            return config;
+        };
+
+        struct controllerPDOptions_t : public controllerOptions_t
+        {
+            vectorN_t const kp;     ///< Position-proportional gain in motor order. A single value is applied to every motor.
+            vectorN_t const kd;     ///< Velocity-proportional gain relative to 'kp' in motor order. A single value is applied to every motor.
+
+            controllerPDOptions_t(configHolder_t const & options) :
+            controllerOptions_t(options),
+            kp(boost::get<vectorN_t>(options.at("kp"))),
+            kd(boost::get<vectorN_t>(options.at("kd")))
+            {
+                // Empty on purpose
+            }
+        };
+
+    public:
+        PDController(void);
+        virtual ~PDController(void) = default;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Reset the internal state of the controller.
+        ///
+        /// \details    The mapping from motors to encoders is updated, and the targets are reset
+        ///             to zero. The memory of the targets is only reallocated if the number of
+        ///             motors has changed.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t reset(bool_t const & resetDynamicTelemetry = false) override;
+
+        virtual hresult_t computeCommand(float64_t const & t,
+                                         vectorN_t const & q,
+                                         vectorN_t const & v,
+                                         vectorN_t       & command) override;
+
+        virtual hresult_t internalDynamics(float64_t const & t,
+                                           vectorN_t const & q,
+                                           vectorN_t const & v,
+                                           vectorN_t       & uCustom) override;
+
+        virtual void setOptions(configHolder_t const & ctrlOptions) override;
+
+        /// \brief The state gathers the position, velocity and effort targets, in this order.
+        virtual hresult_t saveState(vectorN_t & state) const override;
+        virtual hresult_t restoreState(vectorN_t const & state) override;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Set the target position, velocity and feed-forward effort of the motors.
+        ///
+        /// \param[in]  qTarget     Target position in motor order
+        /// \param[in]  vTarget     Target velocity in motor order
+        /// \param[in]  uTarget     Feed-forward effort in motor order. Optional: Zero by default.
+        ///
+        /// \return     Return code to determine whether the execution of the method was successful.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        hresult_t setTarget(vectorN_t const & qTarget,
+                            vectorN_t const & vTarget,
+                            vectorN_t const & uTarget = vectorN_t());
+
+        /// \brief Targets that can be updated in-place, in motor order.
+        vectorN_t & getPositionTarget(void);
+        vectorN_t & getVelocityTarget(void);
+        vectorN_t & getEffortTarget(void);
+
+    private:
+        std::unique_ptr<controllerPDOptions_t const> controllerOptions_;
+        vectorN_t kp_;                              ///< Position-proportional gain of every motor
+        vectorN_t kd_;                              ///< Relative velocity-proportional gain of every motor
+        vectorN_t qTarget_;                         ///< Target position of every motor
+        vectorN_t vTarget_;                         ///< Target velocity of every motor
+        vectorN_t uTarget_;                         ///< Feed-forward effort of every motor
+        std::vector<Eigen::Index> encodersIdx_;     ///< Position of the encoder of every motor in the contiguous buffer of sensor measurements
+        vectorN_t const * sensorsDataFlat_;         ///< Contiguous buffer of sensor measurements of the robot
+    };
+}
+
+#endif //end of JIMINY_PD_CONTROLLER_H
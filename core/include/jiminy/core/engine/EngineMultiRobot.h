@@ -2,8 +2,11 @@
 #define JIMINY_ENGINE_MULTIROBOT_H
 
 #include <functional>
+#include <random>
 
 #include "jiminy/core/telemetry/TelemetrySender.h"
+#include "jiminy/core/robot/Robot.h"
+#include "jiminy/core/stepper/AbstractStepper.h"
 #include "jiminy/core/Types.h"
 #include "jiminy/core/Constants.h"
 
@@ -53,13 +56,35 @@ namespace jiminy
 
     using forceCouplingRegister_t = std::vector<forceCoupling_t>;
 
+    struct multiRateState_t
+    {
+    public:
+        std::vector<std::unique_ptr<AbstractStepper> > steppers;  ///< Dedicated stepper of each system
+        std::vector<std::size_t> systemsOrder;                   ///< Order in which the systems are integrated
+        std::vector<bool_t> isSystemIntegrated;                  ///< Whether each system has been integrated up to tNext
+        float64_t tNext;                                         ///< End time of the current macro step
+        std::vector<vectorN_t> qSplitNext;                       ///< Position of each system at tNext
+        std::vector<vectorN_t> vSplitNext;                       ///< Velocity of each system at tNext
+        std::vector<vectorN_t> sSplitNext;                       ///< Internal state of the motors of each system at tNext
+        std::vector<vectorN_t> dqSplit;                          ///< Internal buffer storing the position increment of each system
+        std::vector<vectorN_t> qSystem;                          ///< Internal buffer storing the position of the system being integrated
+        std::vector<vectorN_t> vSystem;                          ///< Internal buffer storing the velocity of the system being integrated
+        std::vector<vectorN_t> sSystem;                          ///< Internal buffer storing the internal state of the motors of the system being integrated
+        std::vector<vectorN_t> aSystem;                          ///< Internal buffer storing the acceleration of the system being integrated
+        std::vector<vectorN_t> dsSystem;                         ///< Internal buffer storing the time derivative of the internal state of the motors of the system being integrated
+        std::vector<std::vector<std::size_t> > forcesCouplingIdx;  ///< Indices of the coupling forces involving each system
+        std::vector<std::vector<std::size_t> > coupledSystemsIdx;  ///< Indices of the other systems coupled to each system
+    };
+
     struct stepperState_t
     {
     public:
         void reset(float64_t              const & dtInit,
                    std::vector<vectorN_t> const & qSplitInit,
                    std::vector<vectorN_t> const & vSplitInit,
-                   std::vector<vectorN_t> const & aSplitInit)
+                   std::vector<vectorN_t> const & sSplitInit,
+                   std::vector<vectorN_t> const & aSplitInit,
+                   std::vector<vectorN_t> const & dsSplitInit)
         {
             iter = 0U;
             iterFailed = 0U;
@@ -68,10 +93,13 @@ namespace jiminy
             dt = dtInit;
             dtLargest = dtInit;
             dtLargestPrev = dtInit;
+            dtSplit.assign(qSplitInit.size(), dtInit);
             tError = 0.0;
             qSplit = qSplitInit;
             vSplit = vSplitInit;
+            sSplit = sSplitInit;
             aSplit = aSplitInit;
+            dsSplit = dsSplitInit;
         }
 
     public:
@@ -83,9 +111,47 @@ namespace jiminy
         float64_t dt;
         float64_t dtLargest;
         float64_t dtLargestPrev;
+        std::vector<float64_t> dtSplit;  ///< Step size of each system, only used for multi-rate integration
         std::vector<vectorN_t> qSplit;
         std::vector<vectorN_t> vSplit;
+        std::vector<vectorN_t> sSplit;   ///< Internal state of the motors of each system
         std::vector<vectorN_t> aSplit;
+        std::vector<vectorN_t> dsSplit;  ///< Time derivative of the internal state of the motors of each system
+    };
+
+    struct constraintState_t
+    {
+    public:
+        bool_t isEnabled;
+        vectorN_t lambda;            ///< Lambda multipliers, used to warm-start the constraint solver
+        vectorN_t configurationRef;  ///< Reference configuration, only relevant for joint bounds
+        bool_t isReversed;           ///< Rotation direction, only relevant for joint bounds
+    };
+
+    struct systemSnapshot_t
+    {
+    public:
+        systemState_t state;
+        systemState_t statePrev;
+        std::vector<bool_t> forcesImpulseActive;
+        float64_t forcesImpulseBreakNext;            ///< Time of the next breakpoint associated with the impulse forces, INF if none
+        forceVector_t forcesProfilePrev;             ///< Last value of every force profile
+        vectorN_t contactFramesDepth;
+        vectorN_t contactFramesDepthRate;
+        std::vector<constraintState_t> constraints;  ///< State of every constraint, in iteration order of the constraints holder
+        sensorsState_t sensors;
+        vectorN_t controller;                        ///< Internal state of the controller
+    };
+
+    struct engineState_t
+    {
+    public:
+        stepperState_t stepper;
+        stepperDenseOutput_t stepperDenseOutput;  ///< Continuous extension of the last step of the stepper
+        std::vector<systemSnapshot_t> systems;
+        vector_aligned_t<forceVector_t> fPrev;
+        vector_aligned_t<motionVector_t> aPrev;
+        std::mt19937 randomGenerator;  ///< State of the global random number generator
     };
 
     class EngineMultiRobot
@@ -155,7 +221,10 @@ namespace jiminy
             config["timeout"] = 0.0;  // <= 0.0: disable
             config["sensorsUpdatePeriod"] = 0.0;
             config["controllerUpdatePeriod"] = 0.0;
-            config["logInternalStepperSteps"] = false;
+            config["logInternalStepperSteps"] = false;  // Not supported by multi-rate integration
+            config["detectContactEvents"] = false;  // Only supported by Runge-Kutta steppers
+            config["denseOutput"] = false;  // Only supported by Runge-Kutta steppers in discrete mode, without multi-rate integration
+            config["multiRate"] = false;  // Only supported in discrete mode
 
             return config;
         };
@@ -266,6 +335,9 @@ namespace jiminy
             float64_t   const sensorsUpdatePeriod;
             float64_t   const controllerUpdatePeriod;
             bool_t      const logInternalStepperSteps;
+            bool_t      const detectContactEvents;
+            bool_t      const denseOutput;
+            bool_t      const multiRate;
 
             stepperOptions_t(configHolder_t const & options) :
             verbose(boost::get<bool_t>(options.at("verbose"))),
@@ -280,7 +352,10 @@ namespace jiminy
             timeout(boost::get<float64_t>(options.at("timeout"))),
             sensorsUpdatePeriod(boost::get<float64_t>(options.at("sensorsUpdatePeriod"))),
             controllerUpdatePeriod(boost::get<float64_t>(options.at("controllerUpdatePeriod"))),
-            logInternalStepperSteps(boost::get<bool_t>(options.at("logInternalStepperSteps")))
+            logInternalStepperSteps(boost::get<bool_t>(options.at("logInternalStepperSteps"))),
+            detectContactEvents(boost::get<bool_t>(options.at("detectContactEvents"))),
+            denseOutput(boost::get<bool_t>(options.at("denseOutput"))),
+            multiRate(boost::get<bool_t>(options.at("multiRate")))
             {
                 // Empty on purpose
             }
@@ -330,6 +405,26 @@ namespace jiminy
             {
                 // Empty on purpose
             }
+
+            /// \brief Copy the options, except for a single group of options read from the configuration.
+            engineOptions_t(engineOptions_t const & other,
+                            configHolder_t  const & options,
+                            std::string     const & group) :
+            telemetry(group == "telemetry" ?
+                telemetryOptions_t(boost::get<configHolder_t>(options.at("telemetry"))) : other.telemetry),
+            stepper(group == "stepper" ?
+                stepperOptions_t(boost::get<configHolder_t>(options.at("stepper"))) : other.stepper),
+            world(group == "world" ?
+                worldOptions_t(boost::get<configHolder_t>(options.at("world"))) : other.world),
+            joints(group == "joints" ?
+                jointOptions_t(boost::get<configHolder_t>(options.at("joints"))) : other.joints),
+            constraints(group == "constraints" ?
+                constraintOptions_t(boost::get<configHolder_t>(options.at("constraints"))) : other.constraints),
+            contacts(group == "contacts" ?
+                contactOptions_t(boost::get<configHolder_t>(options.at("contacts"))) : other.contacts)
+            {
+                // Empty on purpose
+            }
         };
 
     public:
@@ -415,8 +510,10 @@ namespace jiminy
         ///
         /// \param[in] resetRandomNumbers Whether or not to reset the random number generators.
         /// \param[in] removeAllForce Whether or not to remove registered external forces.
-        void reset(bool_t const & resetRandomNumbers = false,
-                   bool_t const & removeAllForce = false);
+        ///
+        /// \return Error code if resetting the controller of any system failed.
+        hresult_t reset(bool_t const & resetRandomNumbers = false,
+                        bool_t const & removeAllForce = false);
 
         /// \brief Reset the engine and compute initial state.
         ///
@@ -448,6 +545,35 @@ namespace jiminy
         ///          variables or forces.
         void stop(void);
 
+        /// \brief Save the complete internal state of the running simulation.
+        ///
+        /// \details It includes the state of the stepper and its continuous extension, the state
+        ///          of every system including the internal state of the motors, the history of
+        ///          the sensors, the internal state of the controllers, the active impulse
+        ///          forces, the last value of the force profiles, the state of the constraints,
+        ///          and the global random number generator. The memory is only reallocated the
+        ///          first time, so that saving the state repeatedly into the same object is cheap.
+        ///
+        /// \warning The internal state of the controllers is opaque to the engine, so that it is
+        ///          only captured if they implement `AbstractController::saveState`. The
+        ///          callbacks are not part of it at all.
+        ///
+        /// \param[out] engineState State of the simulation.
+        hresult_t saveState(engineState_t & engineState);
+
+        /// \brief Restore the internal state of the simulation saved previously by `saveState`.
+        ///
+        /// \details It is much faster than restarting the simulation from scratch, and it makes
+        ///          it possible to branch several rollouts from the same state. The simulation
+        ///          must be running, with the same systems, forces and sensors as when saving it.
+        ///
+        /// \warning The telemetry log is not rewound. Everything recorded since saving the state
+        ///          is kept, and the log carries on from the restored time, so that its time is no
+        ///          longer monotonic. One must reset the engine to start a new log.
+        ///
+        /// \param[in] engineState State of the simulation.
+        hresult_t restoreState(engineState_t const & engineState);
+
         /// \brief Run a simulation of duration tEnd, starting at xInit.
         ///
         /// \param[in] tEnd End time, i.e. amount of time to simulate.
@@ -484,8 +610,32 @@ namespace jiminy
         hresult_t getForcesProfile(std::string const & systemName,
                                    forceProfileRegister_t const * & forcesProfilePtr) const;
 
-        configHolder_t getOptions(void) const;
+        configHolder_t const & getOptions(void) const;
         hresult_t setOptions(configHolder_t const & engineOptions);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Update a single option of the engine.
+        ///
+        /// \details    It is much cheaper than getting, updating and setting back the whole
+        ///             configuration, which makes it suitable for changing a few options, such
+        ///             as the friction coefficient of the ground, before every episode. Only the
+        ///             group of options containing the option is checked and updated, since the
+        ///             options of different groups are independent.
+        ///
+        /// \remark     There is no equivalent for the robot, nor for its motors and sensors. Their
+        ///             options are read by the robot when updated, often to regenerate the model or
+        ///             to resize buffers, which costs much more than copying their configuration.
+        ///
+        /// \param[in]  path    Names of the nested options separated by '/', e.g. "contacts/friction".
+        /// \param[in]  value   New value of the option. It must have the same type as the current one.
+        ///
+        /// \return     Return code to determine whether the execution of the method was successful.
+        ///             The option is left unchanged if the new value is invalid.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        hresult_t setOption(std::string   const & path,
+                            configField_t const & value);
         bool_t getIsTelemetryConfigured(void) const;
         std::vector<std::string> getSystemsNames(void) const;
         hresult_t getSystemIdx(std::string const & systemName,
@@ -506,9 +656,17 @@ namespace jiminy
         hresult_t computeSystemsDynamics(float64_t              const & t,
                                          std::vector<vectorN_t> const & qSplit,
                                          std::vector<vectorN_t> const & vSplit,
-                                         std::vector<vectorN_t>       & aSplit);
+                                         std::vector<vectorN_t> const & sSplit,
+                                         std::vector<vectorN_t>       & aSplit,
+                                         std::vector<vectorN_t>       & dsSplit);
 
     protected:
+        /// \brief Check that a group of options of the engine is valid, e.g. "stepper".
+        hresult_t checkOptions(std::string    const & group,
+                               configHolder_t const & groupOptions) const;
+        /// \brief Update the info extracted from the options of the engine.
+        void refreshOptionsProxies(void);
+
         hresult_t configureTelemetry(void);
         void updateTelemetry(void);
 
@@ -536,11 +694,113 @@ namespace jiminy
                                            std::shared_ptr<AbstractConstraintBase> & collisionConstraint,
                                            pinocchio::Force & fextLocal) const;
 
+        /// \brief Compute the force resulting from ground contact on every contact frames at once.
+        ///
+        /// \details It is a batched version of `computeContactDynamicsAtFrame` only available
+        ///          for spring-damper contact model. The contact forces, at parent joint, in
+        ///          the local frame, are stored in `systemData.contactFramesForces`.
+        ///
+        /// \param[in] system        System for which to perform computation.
+        /// \param[in] systemData    Internal data of the system.
+        /// \param[out] fext         External forces of the system to update.
+        void computeContactDynamicsAtFrames(systemHolder_t     const & system,
+                                            systemDataHolder_t       & systemData,
+                                            forceVector_t            & fext) const;
+
         /// \brief Compute the force resulting from ground contact for a given normal direction and depth.
         pinocchio::Force computeContactDynamics(vector3_t const & nGround,
                                                 float64_t const & depth,
                                                 vector3_t const & vContactInWorld) const;
 
+        /// \brief Compute the penetration depth of every contact frames of a given system, and
+        ///        its time derivative.
+        ///
+        /// \details It relies on the kinematics stored in pinocchio::Data, which must be up-to-date.
+        ///
+        /// \param[in] system        System for which to perform computation.
+        /// \param[out] depth        Penetration depth of each contact frame (negative if in contact).
+        /// \param[out] depthRate    Time derivative of the penetration depth of each contact frame.
+        void computeContactFramesDepth(systemHolder_t const & system,
+                                       vectorN_t            & depth,
+                                       vectorN_t            & depthRate) const;
+
+        /// \brief Detect contact events, ie touchdown or takeoff of contact frames, that occurred
+        ///        during the last successful step.
+        ///
+        /// \details The penetration depth of each contact frame is interpolated between the
+        ///          beginning and the end of the step by cubic Hermite polynomials, then the
+        ///          earliest zero crossing is located by root-finding. The depth at the end of the
+        ///          step is backed up only if no event has been detected.
+        ///
+        /// \param[in] dt          Duration of the last step.
+        /// \param[out] dtEvent    Duration from the beginning of the step to the earliest event.
+        /// \return Whether or not an event occurred strictly inside the step.
+        bool_t detectContactEvents(float64_t const & dt,
+                                   float64_t       & dtEvent);
+
+        /// \brief Update the sensors and the telemetry at every update time that occurred strictly
+        ///        inside the last successful step, based on the dense output of the stepper.
+        ///
+        /// \details The position, velocity and acceleration of the systems at each update time are
+        ///          interpolated from the stages of the last step, whereas the efforts and external
+        ///          forces are linearly interpolated between both ends of the step. The dynamics is
+        ///          never evaluated, so that the controller, the force profiles and the constraint
+        ///          solver are not affected. Only the kinematics is updated, then restored at the
+        ///          end of the step. Consequently, the other quantities logged at these update times,
+        ///          e.g. the contact forces, are those of the end of the step.
+        ///          It must be called once the systems have been synchronized with the stepper.
+        ///
+        /// \param[in] tStepStart  Start time of the last step.
+        /// \param[in] tNext       Time of the next breakpoint, which is handled separately.
+        void updateDenseOutputSamples(float64_t const & tStepStart,
+                                      float64_t const & tNext);
+
+        /// \brief Integrate each system independently up to the next breakpoint, each of them
+        ///        with its own step size.
+        ///
+        /// \details The systems are integrated one after the other, from the one having the largest
+        ///          step size to the one having the smallest (slowest-first). The state of the systems
+        ///          that have already been integrated is interpolated linearly over the macro step to
+        ///          evaluate the coupling forces, whereas the state of the others is extrapolated at
+        ///          constant acceleration. The dynamics of every system is evaluated once all of them
+        ///          reached the next breakpoint, so that they are synchronized again. If the macro
+        ///          step fails, the state and the kinematics of the systems are restored at its
+        ///          beginning.
+        ///
+        /// \param[in] tNext                     Time of the next breakpoint.
+        /// \param[in, out] successiveIterFailed Number of successive failed steps.
+        /// \param[out] isNan                    Whether the integration failed miserably.
+        void stepMultiRate(float64_t const & tNext,
+                           uint32_t        & successiveIterFailed,
+                           bool_t          & isNan);
+
+        /// \brief Dynamics of a single system used for multi-rate integration, the state of the
+        ///        other systems being estimated from the current macro step.
+        ///
+        /// \details Only the systems coupled to the one being integrated through coupling forces
+        ///          are estimated, and only their frame placements and velocities are updated.
+        ///          The external forces and efforts of the other systems are not affected.
+        void computeSystemDynamicsMultiRate(std::size_t            const & systemIdx,
+                                            float64_t              const & t,
+                                            std::vector<vectorN_t> const & qSplit,
+                                            std::vector<vectorN_t> const & vSplit,
+                                            std::vector<vectorN_t> const & sSplit,
+                                            std::vector<vectorN_t>       & aSplit,
+                                            std::vector<vectorN_t>       & dsSplit);
+
+        /// \brief Compute the efforts and the acceleration of a single system, assuming that its
+        ///        kinematics, internal dynamics and external forces are up-to-date.
+        void computeSystemDynamics(systemHolder_t           & system,
+                                   systemDataHolder_t       & systemData,
+                                   forceVector_t            & fPrevJoints,
+                                   motionVector_t           & aPrevJoints,
+                                   float64_t          const & t,
+                                   vectorN_t          const & q,
+                                   vectorN_t          const & v,
+                                   vectorN_t          const & s,
+                                   vectorN_t                & a,
+                                   vectorN_t                & ds);
+
         void computeCommand(systemHolder_t  & system,
                             float64_t const & t,
                             vectorN_t const & q,
@@ -561,6 +821,13 @@ namespace jiminy
                                    vectorN_t          const & q,
                                    vectorN_t          const & v,
                                    forceVector_t            & fext);
+        /// \brief Compute a single coupling force and apply it on the requested systems.
+        void computeForceCoupling(forceCoupling_t        const & forceCoupling,
+                                  float64_t              const & t,
+                                  std::vector<vectorN_t> const & qSplit,
+                                  std::vector<vectorN_t> const & vSplit,
+                                  bool_t                 const & isAppliedToFirst,
+                                  bool_t                 const & isAppliedToSecond);
         void computeForcesCoupling(float64_t              const & t,
                                    std::vector<vectorN_t> const & qSplit,
                                    std::vector<vectorN_t> const & vSplit);
@@ -609,6 +876,23 @@ namespace jiminy
         hresult_t writeLogCsv(std::string const & filename);
         hresult_t writeLogHdf5(std::string const & filename);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Get the serialized value of a telemetry constant, only generating it again
+        ///             if the object it has been generated from has changed since the last call.
+        ///
+        /// \param[in]  key         Name of the telemetry constant
+        /// \param[in]  version     Version of the object from which it is generated, or hash of its
+        ///                         content if it cannot be tracked otherwise
+        /// \param[in]  serialize   Function generating the serialized value
+        ///
+        /// \return     Serialized value of the telemetry constant
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        std::string const & getTelemetryConstantCached(std::string                      const & key,
+                                                       std::size_t                      const & version,
+                                                       std::function<std::string(void)> const & serialize);
+
     private:
         template<typename Scalar, int Options, template<typename, int> class JointCollectionTpl,
                  typename ConfigVectorType, typename TangentVectorType>
@@ -647,16 +931,25 @@ namespace jiminy
         bool_t isTelemetryConfigured_;
         bool_t isSimulationRunning_;
         configHolder_t engineOptionsHolder_;
+        std::size_t optionsVersion_;  ///< Version of the options of the engine, also stamped when adding or removing systems
 
     private:
         std::unique_ptr<Timer> timer_;
         contactModel_t contactModel_;
         TelemetrySender telemetrySender_;
         std::shared_ptr<TelemetryData> telemetryData_;
+        std::unordered_map<std::string, std::pair<std::size_t, std::string> > telemetryConstantsCache_;  ///< Serialized telemetry constants, along with the version of the object they have been generated from
         std::unique_ptr<TelemetryRecorder> telemetryRecorder_;
         std::unique_ptr<AbstractStepper> stepper_;
+        multiRateState_t multiRateState_;
         float64_t stepperUpdatePeriod_;
+        float64_t stepperBreakpointPeriod_;
         stepperState_t stepperState_;
+        std::vector<vectorN_t> qSplitInterp_;
+        std::vector<vectorN_t> vSplitInterp_;
+        std::vector<vectorN_t> sSplitInterp_;
+        std::vector<vectorN_t> aSplitInterp_;
+        std::vector<vectorN_t> dsSplitInterp_;
         vector_aligned_t<systemDataHolder_t> systemsDataHolder_;
         forceCouplingRegister_t forcesCoupling_;
         vector_aligned_t<forceVector_t> fPrev_;
@@ -118,6 +118,8 @@ namespace jiminy
         vectorN_t q;
         vectorN_t v;
         vectorN_t a;
+        vectorN_t s;   ///< Internal state of the motors
+        vectorN_t ds;  ///< Time derivative of the internal state of the motors
         vectorN_t command;
         vectorN_t u;
         vectorN_t uMotor;
@@ -129,6 +131,29 @@ namespace jiminy
         bool_t isInitialized_;
     };
 
+    struct contactFramesBatch_t
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    public:
+        contactFramesBatch_t(void);
+
+        void resize(Eigen::Index const & nFrames);
+
+    public:
+        matrix3N_t pos;           ///< Position of the contact frames in world frame
+        matrix3N_t vel;           ///< Linear velocity of the contact frames in world frame
+        matrix3N_t nGround;       ///< Normal of the ground at the contact frames in world frame
+        matrix3N_t vTangential;   ///< Tangential velocity of the contact frames in world frame
+        matrix3N_t fextInWorld;   ///< Ground reaction forces at the contact frames in world frame
+        vectorN_t zGround;        ///< Height of the ground at the contact frames
+        vectorN_t depth;          ///< Penetration depth of the contact frames (negative if in contact)
+        vectorN_t vDepth;         ///< Penetration speed of the contact frames
+        vectorN_t fextNormal;     ///< Norm of the normal component of the ground reaction forces
+        vectorN_t fextTangential; ///< Ratio of the tangential component of the ground reaction forces
+    };
+
     struct systemDataHolder_t
     {
     public:
@@ -146,8 +171,12 @@ namespace jiminy
         std::unique_ptr<AbstractConstraintSolver> constraintSolver;
         constraintsHolder_t constraintsHolder;                         ///< Store copy of constraints register for fast access.
         forceVector_t contactFramesForces;                             ///< Contact forces for each contact frames in local frame
+        contactFramesBatch_t contactFramesBatch;                       ///< Structure-of-arrays buffers used to compute the contact forces of every contact frames at once
+        vectorN_t contactFramesDepth;                                  ///< Penetration depth of each contact frames at the end of the last successful step, used for contact events detection
+        vectorN_t contactFramesDepthRate;                              ///< Time derivative of the penetration depth of each contact frames at the end of the last successful step
+        vectorN_t contactFramesDepthNext;                              ///< Buffer storing the penetration depth of each contact frames at the end of the step being checked
+        vectorN_t contactFramesDepthRateNext;                          ///< Buffer storing the time derivative of the penetration depth at the end of the step being checked
         vector_aligned_t<forceVector_t> collisionBodiesForces;         ///< Contact forces for each geometries of each collision bodies in local frame
-        matrix6N_t jointJacobian;                                      ///< Buffer used for intermediary computation of `data.u`
 
         std::vector<std::string> positionFieldnames;
         std::vector<std::string> velocityFieldnames;
@@ -159,6 +188,8 @@ namespace jiminy
 
         systemState_t state;       ///< Internal buffer with the state for the integration loop
         systemState_t statePrev;   ///< Internal state for the integration loop at the end of the previous iteration
+        systemState_t stateEnd;    ///< Backup of the state at the end of the step while sampling its dense output
+        systemState_t stateMacroStepStart;  ///< Backup of the state at the beginning of the macro step for multi-rate integration
     };
 }
 
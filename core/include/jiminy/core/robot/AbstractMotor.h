@@ -32,9 +32,12 @@ namespace jiminy
     ///////////////////////////////////////////////////////////////////////////////////////////////
     struct MotorSharedDataHolder_t
     {
-        vectorN_t data_;                           ///< Buffer with current actual motor effort
-        std::vector<AbstractMotorBase *> motors_;  ///< Vector of pointers to the motors.
-        std::size_t num_;                          ///< Number of motors
+        vectorN_t data_;                                                ///< Buffer with current actual motor effort
+        vectorN_t state_;                                               ///< Buffer with the internal state of every motor, integrated by the stepper of the engine
+        vectorN_t stateDerivative_;                                     ///< Buffer with the time derivative of the internal state of every motor
+        std::vector<AbstractMotorBase *> motors_;                       ///< Vector of pointers to the motors.
+        std::vector<std::vector<AbstractMotorBase *> > motorsGroups_;  ///< Motors gathered by type, so that they can be evaluated in batches
+        std::size_t num_;                                               ///< Number of motors
     };
 
     class AbstractMotorBase : public std::enable_shared_from_this<AbstractMotorBase>
@@ -114,6 +117,17 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         virtual hresult_t resetAll(void);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Attach a new motor of the same type and with the same name to another
+        ///             robot, then initialize it for the same joint.
+        ///
+        /// \details    It is used to clone a robot. The options are not copied, since the robot is
+        ///             taking care of it.
+        ///
+        /// \param[in]  robot   Robot to which the new motor must be attached
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t attachCopy(Robot & robot) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief      Get the configuration options of the motor.
         ///
@@ -121,6 +135,11 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         configHolder_t getOptions(void) const;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get the version of the options of the motor, stamped every time they are updated.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t const & getOptionsVersion(void) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief      Get the actual effort of the motor at the current time.
         ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -166,6 +185,22 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         std::size_t const & getIdx(void) const;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get stateSize_.
+        ///
+        /// \details    It is the dimension of the internal state of the motor, zero for stateless
+        ///             motors.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        Eigen::Index const & getStateSize(void) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get stateIdx_.
+        ///
+        /// \details    It is the index of the internal state of the motor in the state buffer shared
+        ///             by every motor of the robot.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        Eigen::Index const & getStateIdx(void) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief      Get jointName_.
         ///
@@ -219,7 +254,8 @@ namespace jiminy
         /// \brief      Request the motor to update its actual effort based of the input data.
         ///
         /// \details    It assumes that the internal state of the robot is consistent with the
-        ///             input arguments.
+        ///             input arguments. Motors having an internal state must also write its time
+        ///             derivative, which is integrated by the stepper of the engine.
         ///
         /// \param[in]  t        Current time.
         /// \param[in]  q        Current configuration of the motor.
@@ -257,6 +293,39 @@ namespace jiminy
                                    vectorN_t const & a,
                                    vectorN_t const & command);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Request a group of motors of the same type to update their actual effort.
+        ///
+        /// \details    By default, it calls `computeEffort` for each motor successively. It is meant
+        ///             to be overwritten by motor types able to evaluate all their motors at once.
+        ///
+        /// \param[in]  t        Current time.
+        /// \param[in]  q        Current configuration vector of the robot.
+        /// \param[in]  v        Current velocity vector of the robot.
+        /// \param[in]  a        Current acceleration vector of the robot.
+        /// \param[in]  command  Current command effort vector of the robot.
+        /// \param[in]  motors   Motors of the group, all of them having the same type as this one.
+        ///
+        /// \return     Return code to determine whether the execution of the method was successful.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t computeEffortBatch(float64_t const & t,
+                                             vectorN_t const & q,
+                                             vectorN_t const & v,
+                                             vectorN_t const & a,
+                                             vectorN_t const & command,
+                                             std::vector<AbstractMotorBase *> const & motors);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Reset the internal state of a group of motors of the same type, and prepare
+        ///             their batched evaluation.
+        ///
+        /// \details    It is called by `resetAll` after refreshing the proxies. It does nothing by
+        ///             default.
+        ///
+        /// \param[in]  motors   Motors of the group, all of them having the same type as this one.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t resetBatch(std::vector<AbstractMotorBase *> const & motors);
+
     protected:
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief      Get a reference to the last data buffer corresponding to the actual effort
@@ -264,6 +333,17 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         float64_t & data(void);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get a reference to the segment of the shared buffers corresponding to the
+        ///             internal state of the motor and its time derivative.
+        ///
+        /// \details    The state is owned by the stepper of the engine: the motor must never update
+        ///             it, but only write its time derivative in `computeEffort`.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        Eigen::VectorBlock<vectorN_t> state(void);
+        Eigen::VectorBlock<vectorN_t const> state(void) const;
+        Eigen::VectorBlock<vectorN_t> stateDerivative(void);
+
     private:
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief    Attach the sensor to a robot
@@ -284,12 +364,15 @@ namespace jiminy
 
     protected:
         configHolder_t motorOptionsHolder_;                          ///< Dictionary with the parameters of the motor
+        std::size_t optionsVersion_;                                 ///< Version of the options of the motor
         bool_t isInitialized_;                                       ///< Flag to determine whether the controller has been initialized or not
         bool_t isAttached_;                                          ///< Flag to determine whether the motor is attached to a robot
         std::weak_ptr<Robot const> robot_;                           ///< Robot for which the command and internal dynamics
         std::function<hresult_t(AbstractMotorBase &)> notifyRobot_;  ///< Notify the robot that the configuration of the sensors have changed
         std::string name_;                                           ///< Name of the motor
         std::size_t motorIdx_;                                       ///< Index of the motor in the measurement buffer
+        Eigen::Index stateSize_;                                     ///< Dimension of the internal state of the motor, to be set by the constructor of motors having one
+        Eigen::Index stateIdx_;                                      ///< Index of the internal state of the motor in the shared state buffer
         std::string jointName_;
         jointIndex_t jointModelIdx_;
         joint_t jointType_;
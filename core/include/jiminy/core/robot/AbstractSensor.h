@@ -17,8 +17,6 @@
 #include "jiminy/core/Macros.h"
 #include "jiminy/core/Types.h"
 
-#include <boost/circular_buffer.hpp>
-
 
 namespace jiminy
 {
@@ -41,9 +39,34 @@ namespace jiminy
     ///////////////////////////////////////////////////////////////////////////////////////////////
     struct SensorSharedDataHolder_t
     {
-        boost::circular_buffer<float64_t> time_;     ///< Circular buffer of the stored timesteps
-        boost::circular_buffer<matrixN_t> data_;     ///< Circular buffer of past sensor real data
+        /// \brief Position in the ring buffers of the i-th oldest stored timestep.
+        Eigen::Index idx(Eigen::Index const & i) const
+        {
+            return (head_ + i) % time_.size();
+        }
+
+        /// \brief Time of the i-th oldest stored timestep.
+        float64_t & time(Eigen::Index const & i)
+        {
+            return time_[idx(i)];
+        }
+
+        /// \brief Real data of every sensors at the i-th oldest stored timestep.
+        auto data(Eigen::Index const & i)
+        {
+            Eigen::Index const num = static_cast<Eigen::Index>(num_);
+            return data_.middleCols(idx(i) * num, num);
+        }
+
+        vectorN_t time_;                             ///< Ring buffer of the stored timesteps
+        matrixN_t data_;                             ///< Ring buffer of past sensor real data, storing contiguously the data of every sensors for each timestep
+        Eigen::Index head_;                          ///< Position of the oldest stored timestep in the ring buffers
+        Eigen::Index size_;                          ///< Number of stored timesteps
+        int64_t dropped_;                            ///< Total number of timesteps removed from the front of the ring buffers since the last reset
         matrixN_t dataMeasured_;                     ///< Buffer of current sensor measurement data
+        matrixN_t noiseStd_;                         ///< Standard deviation of the additive white noise of every sensors, empty if none of them is noisy
+        matrixN_t bias_;                             ///< Additive bias of every sensors, empty if none of them is biased
+        bool_t isNoiseAndBiasOutdated_;              ///< Whether the options of a sensor changed since the noise and bias were gathered
         std::vector<AbstractSensorBase *> sensors_;  ///< Vector of pointers to the sensors
         std::size_t num_;                            ///< Number of sensors of that type
         float64_t delayMax_;                         ///< Maximum delay over all the sensors
@@ -136,6 +159,17 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         virtual hresult_t refreshProxies(void) = 0;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Attach a new sensor of the same type and with the same name to another
+        ///             robot, then initialize it at the same location.
+        ///
+        /// \details    It is used to clone a robot. The options are not copied, since the robot is
+        ///             taking care of it.
+        ///
+        /// \param[in]  robot   Robot to which the new sensor must be attached
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t attachCopy(Robot & robot) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
         /// \brief      Configure the telemetry of the sensor.
@@ -204,6 +238,13 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         configHolder_t getOptions(void) const;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Get the version of the options of the sensor, stamped every time they are updated.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t const & getOptionsVersion(void) const;
+
         template<typename DerivedType>
         hresult_t set(Eigen::MatrixBase<DerivedType> const & value);
 
@@ -414,6 +455,7 @@ namespace jiminy
 
     protected:
         configHolder_t sensorOptionsHolder_;  ///< Dictionary with the parameters of the sensor
+        std::size_t optionsVersion_;          ///< Version of the options of the sensor
         bool_t isInitialized_;                ///< Flag to determine whether the sensor has been initialized or not
         bool_t isAttached_;                   ///< Flag to determine whether the sensor is attached to a robot
         bool_t isTelemetryConfigured_;        ///< Flag to determine whether the telemetry of the sensor has been initialized or not
@@ -442,6 +484,7 @@ namespace jiminy
         virtual hresult_t resetAll(void) override;
         void updateTelemetryAll(void) override final;
 
+        virtual hresult_t setOptions(configHolder_t const & sensorOptions) override;
         virtual hresult_t setOptionsAll(configHolder_t const & sensorOptions) override final;
         virtual std::size_t const & getIdx(void) const override final;
         virtual std::string const & getType(void) const override final;
@@ -460,6 +503,42 @@ namespace jiminy
         virtual Eigen::Ref<vectorN_t> get(void) override final;
         virtual Eigen::Ref<vectorN_t> data(void) override final;
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Record the real data of every sensors of that type at once.
+        ///
+        /// \details    By default, it calls `set` for each sensor successively. It is meant to be
+        ///             overwritten by sensor types able to gather the data of all their sensors
+        ///             directly, using indices cached when refreshing the proxies.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t setDataAll(float64_t     const & t,
+                                     vectorN_t     const & q,
+                                     vectorN_t     const & v,
+                                     vectorN_t     const & a,
+                                     vectorN_t     const & uMotor,
+                                     forceVector_t const & fExternal);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Add white noise and bias to the measurement buffer of every sensors of that
+        ///             type at once.
+        ///
+        /// \details    By default, it calls `measureData` for each sensor successively. It is meant to
+        ///             be overwritten by `skewDataBatch` for sensor types whose noise and bias are
+        ///             additive and that do not overwrite `measureData`.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void skewDataAll(void);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Add additive white noise and bias to the measurement buffer of every sensors
+        ///             of that type at once, with a single random draw for all of them.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        void skewDataBatch(void);
+
     private:
         virtual hresult_t attach(std::weak_ptr<Robot const> robot,
                                  SensorSharedDataHolder_t * sharedHolder) override final;
@@ -468,6 +547,8 @@ namespace jiminy
         virtual hresult_t interpolateData(void) override final;
         virtual hresult_t measureDataAll(void) override final;
         void clearDataBuffer(void);
+        void reserveDataBuffer(Eigen::Index const & capacity);
+        void refreshNoiseAndBias(void);
 
     public:
         /* Be careful, the static variables must be const since the 'static'
@@ -479,9 +560,10 @@ namespace jiminy
 
     protected:
         std::size_t sensorIdx_;
+        SensorSharedDataHolder_t * sharedHolder_;
 
     private:
-        SensorSharedDataHolder_t * sharedHolder_;
+        int64_t bufferCursor_;  ///< Timestep used for the last delayed lookup, counted since the last reset
     };
 }
 
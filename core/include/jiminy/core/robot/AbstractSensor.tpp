@@ -1,4 +1,5 @@
 #include <numeric>
+#include <algorithm>
 
 #include "jiminy/core/robot/Robot.h"
 #include "jiminy/core/Constants.h"
@@ -36,7 +37,8 @@ namespace jiminy
     AbstractSensorTpl<T>::AbstractSensorTpl(std::string const & name) :
     AbstractSensorBase(name),
     sensorIdx_(0),
-    sharedHolder_(nullptr)
+    sharedHolder_(nullptr),
+    bufferCursor_(0)
     {
         // Empty on purpose
     }
@@ -77,24 +79,31 @@ namespace jiminy
         sensorIdx_ = sharedHolder_->num_;
 
         // Make sure the shared data buffers are properly pre-allocated
-        if (sharedHolder_->time_.empty())
+        if (sharedHolder_->time_.size() == 0)
         {
-            sharedHolder_->time_.assign(1, 0.0);
-            sharedHolder_->data_.resize(1);
+            sharedHolder_->time_.setZero(1);
+            sharedHolder_->data_.resize(getSize(), 0);
+            sharedHolder_->head_ = 0;
+            sharedHolder_->size_ = 1;
+            sharedHolder_->dropped_ = 0;
         }
 
-        // Add a column for the sensor to the shared data buffers
-        for (matrixN_t & data : sharedHolder_->data_)
+        // Add a column for the sensor to every timesteps of the shared data buffers
+        Eigen::Index const num = static_cast<Eigen::Index>(sharedHolder_->num_);
+        Eigen::Index const capacity = sharedHolder_->time_.size();
+        matrixN_t data = matrixN_t::Zero(getSize(), capacity * (num + 1));
+        for (Eigen::Index i = 0; i < capacity; ++i)
         {
-            data.conservativeResize(getSize(), sharedHolder_->num_ + 1);
-            data.rightCols<1>().setZero();
+            data.middleCols(i * (num + 1), num) = sharedHolder_->data_.middleCols(i * num, num);
         }
+        sharedHolder_->data_.swap(data);
         sharedHolder_->dataMeasured_.conservativeResize(getSize(), sharedHolder_->num_ + 1);
         sharedHolder_->dataMeasured_.rightCols<1>().setZero();
 
         // Add the sensor to the shared memory
         sharedHolder_->sensors_.push_back(this);
         ++sharedHolder_->num_;
+        sharedHolder_->isNoiseAndBiasOutdated_ = true;
 
         // Update the flag
         isAttached_ = true;
@@ -113,22 +122,25 @@ namespace jiminy
             return hresult_t::ERROR_GENERIC;
         }
 
-        // Remove associated col in the shared data buffers
+        // Remove associated col at every timesteps of the shared data buffers
+        Eigen::Index const num = static_cast<Eigen::Index>(sharedHolder_->num_);
+        Eigen::Index const capacity = sharedHolder_->time_.size();
+        Eigen::Index const sensorIdx = static_cast<Eigen::Index>(sensorIdx_);
+        Eigen::Index const sensorShift = num - sensorIdx - 1;
+        matrixN_t data(getSize(), capacity * (num - 1));
+        for (Eigen::Index i = 0; i < capacity; ++i)
+        {
+            data.middleCols(i * (num - 1), sensorIdx) =
+                sharedHolder_->data_.middleCols(i * num, sensorIdx);
+            data.middleCols(i * (num - 1) + sensorIdx, sensorShift) =
+                sharedHolder_->data_.middleCols(i * num + sensorIdx + 1, sensorShift);
+        }
+        sharedHolder_->data_.swap(data);
         if (sensorIdx_ < sharedHolder_->num_ - 1)
         {
-            std::size_t const sensorShift = sharedHolder_->num_ - sensorIdx_ - 1;
-            for (matrixN_t & data : sharedHolder_->data_)
-            {
-                data.middleCols(sensorIdx_, sensorShift) =
-                    data.middleCols(sensorIdx_ + 1, sensorShift).eval();
-            }
             sharedHolder_->dataMeasured_.middleCols(sensorIdx_, sensorShift) =
                 sharedHolder_->dataMeasured_.middleCols(sensorIdx_ + 1, sensorShift).eval();
         }
-        for (matrixN_t & data : sharedHolder_->data_)
-        {
-            data.conservativeResize(Eigen::NoChange, sharedHolder_->num_ - 1);
-        }
         sharedHolder_->dataMeasured_.conservativeResize(Eigen::NoChange, sharedHolder_->num_ - 1);
 
         // Shift the sensor indices
@@ -142,6 +154,7 @@ namespace jiminy
         // Remove the sensor from the shared memory
         sharedHolder_->sensors_.erase(sharedHolder_->sensors_.begin() + sensorIdx_);
         --sharedHolder_->num_;
+        sharedHolder_->isNoiseAndBiasOutdated_ = true;
 
         // Clear the references to the robot and shared data
         robot_.reset();
@@ -176,11 +189,22 @@ namespace jiminy
             return hresult_t::ERROR_GENERIC;
         }
 
-        // Clear the shared data buffers
-        sharedHolder_->time_.assign(1, 0.0);
-        sharedHolder_->data_.resize(1);
-        sharedHolder_->data_[0].setZero();
+        /* Clear the shared data buffers.
+           Their capacity is preserved to avoid reallocating memory at the
+           beginning of every simulation. */
+        sharedHolder_->head_ = 0;
+        sharedHolder_->size_ = 1;
+        sharedHolder_->dropped_ = 0;
+        sharedHolder_->time(0) = 0.0;
+        sharedHolder_->data(0).setZero();
         sharedHolder_->dataMeasured_.setZero();
+        for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
+        {
+            static_cast<AbstractSensorTpl<T> *>(sensor)->bufferCursor_ = 0;
+        }
+
+        // Gather the additive white noise and bias of every sensors
+        refreshNoiseAndBias();
 
         // Compute max delay
         sharedHolder_->delayMax_ = std::accumulate(
@@ -205,6 +229,20 @@ namespace jiminy
         return hresult_t::SUCCESS;
     }
 
+    template<typename T>
+    hresult_t AbstractSensorTpl<T>::setOptions(configHolder_t const & sensorOptions)
+    {
+        hresult_t returnCode = AbstractSensorBase::setOptions(sensorOptions);
+
+        // The noise and bias must be gathered again before being applied
+        if (returnCode == hresult_t::SUCCESS && isAttached_)
+        {
+            sharedHolder_->isNoiseAndBiasOutdated_ = true;
+        }
+
+        return returnCode;
+    }
+
     template<typename T>
     hresult_t AbstractSensorTpl<T>::setOptionsAll(configHolder_t const & sensorOptions)
     {
@@ -285,66 +323,101 @@ namespace jiminy
     inline Eigen::Ref<vectorN_t> AbstractSensorTpl<T>::data(void)
     {
         // No guard, since this method is not public
-        return sharedHolder_->data_.back().col(sensorIdx_);
+        return sharedHolder_->data(sharedHolder_->size_ - 1).col(sensorIdx_);
     }
 
     template<typename T>
-    hresult_t AbstractSensorTpl<T>::interpolateData(void)
+    void AbstractSensorTpl<T>::reserveDataBuffer(Eigen::Index const & capacity)
     {
-        assert(sharedHolder_->time_.size() > 0 && "Do data to interpolate.");
-
-        // Sample the delay uniformly
-        float64_t const delay = baseSensorOptions_->delay + randUniform(0.0, baseSensorOptions_->jitter);
-
-        // Add STEPPER_MIN_TIMESTEP to timeDesired to avoid float comparison issues
-        float64_t const timeDesired = sharedHolder_->time_.back() - delay + STEPPER_MIN_TIMESTEP;
-
-        /* Determine the position of the closest right element.
-           Bisection method can be used since times are sorted. */
-        auto bisectLeft = [&](void) -> std::ptrdiff_t
+        // Copy the stored timesteps in chronological order in new ring buffers
+        Eigen::Index const num = static_cast<Eigen::Index>(sharedHolder_->num_);
+        vectorN_t time(capacity);
+        matrixN_t data(getSize(), capacity * num);
+        for (Eigen::Index i = 0; i < sharedHolder_->size_; ++i)
         {
-            std::ptrdiff_t left = 0;
-            std::ptrdiff_t right = sharedHolder_->time_.size() - 1;
-            std::ptrdiff_t mid = 0;
-
-            if (timeDesired >= sharedHolder_->time_.back())
-            {
-                return right;
-            }
-            else if (timeDesired < sharedHolder_->time_.front())
-            {
-                return -1;
-            }
+            time[i] = sharedHolder_->time(i);
+            data.middleCols(i * num, num) = sharedHolder_->data(i);
+        }
+        sharedHolder_->time_.swap(time);
+        sharedHolder_->data_.swap(data);
+        sharedHolder_->head_ = 0;
+    }
 
-            while (left < right)
+    template<typename T>
+    void AbstractSensorTpl<T>::refreshNoiseAndBias(void)
+    {
+        // Gather the additive white noise and bias of every sensors, if any
+        auto gatherSensorsOptions = [this](auto getOption, matrixN_t & optionAll)
+        {
+            optionAll.resize(0, 0);
+            for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
             {
-                mid = (left + right) / 2;
-                if (timeDesired < sharedHolder_->time_[mid])
-                {
-                    right = mid;
-                }
-                else if (timeDesired > sharedHolder_->time_[mid])
-                {
-                    left = mid + 1;
-                }
-                else
+                vectorN_t const & option = getOption(*sensor->baseSensorOptions_);
+                if (static_cast<uint64_t>(option.size()) == getSize())
                 {
-                    return mid;
+                    if (optionAll.size() == 0)
+                    {
+                        optionAll.setZero(getSize(), sharedHolder_->num_);
+                    }
+                    optionAll.col(sensor->getIdx()) = option;
                 }
             }
+        };
+        gatherSensorsOptions([](abstractSensorOptions_t const & options) -> vectorN_t const &
+                             {
+                                 return options.noiseStd;
+                             }, sharedHolder_->noiseStd_);
+        gatherSensorsOptions([](abstractSensorOptions_t const & options) -> vectorN_t const &
+                             {
+                                 return options.bias;
+                             }, sharedHolder_->bias_);
+
+        sharedHolder_->isNoiseAndBiasOutdated_ = false;
+    }
+
+    template<typename T>
+    hresult_t AbstractSensorTpl<T>::interpolateData(void)
+    {
+        assert(sharedHolder_->size_ > 0 && "Do data to interpolate.");
 
-            if (timeDesired < sharedHolder_->time_[mid])
+        SensorSharedDataHolder_t & holder = *sharedHolder_;
+        Eigen::Index const size = holder.size_;
+
+        // Sample the delay uniformly
+        float64_t const delay = baseSensorOptions_->delay + randUniform(0.0, baseSensorOptions_->jitter);
+
+        // Add STEPPER_MIN_TIMESTEP to timeDesired to avoid float comparison issues
+        float64_t const timeDesired = holder.time(size - 1) - delay + STEPPER_MIN_TIMESTEP;
+
+        /* Determine the position of the closest left element.
+           Times are sorted and the desired time is almost always increasing
+           from one update to the next, so the search starts from the position
+           found at the previous update. It is amortized constant time. */
+        Eigen::Index idxLeft;
+        if (timeDesired >= holder.time(size - 1))
+        {
+            idxLeft = size - 1;
+        }
+        else if (timeDesired < holder.time(0))
+        {
+            idxLeft = -1;
+        }
+        else
+        {
+            idxLeft = std::clamp(static_cast<Eigen::Index>(bufferCursor_ - holder.dropped_),
+                                 Eigen::Index(0), size - 2);
+            while (holder.time(idxLeft + 1) <= timeDesired)
             {
-                return mid - 1;
+                ++idxLeft;
             }
-            else
+            while (timeDesired < holder.time(idxLeft))
             {
-                return mid;
+                --idxLeft;
             }
-        };
+            bufferCursor_ = idxLeft + holder.dropped_;
+        }
 
-        int64_t const idxLeft = bisectLeft();
-        if (timeDesired >= 0.0 && static_cast<std::size_t>(idxLeft + 1) < sharedHolder_->time_.size())
+        if (timeDesired >= 0.0 && idxLeft + 1 < size)
         {
             if (idxLeft < 0)
             {
@@ -353,13 +426,15 @@ namespace jiminy
             }
             else if (baseSensorOptions_->delayInterpolationOrder == 0)
             {
-                get() = sharedHolder_->data_[idxLeft].col(sensorIdx_);
+                get() = holder.data(idxLeft).col(sensorIdx_);
             }
             else if (baseSensorOptions_->delayInterpolationOrder == 1)
             {
-                get() = 1 / (sharedHolder_->time_[idxLeft + 1] - sharedHolder_->time_[idxLeft]) *
-                        ((timeDesired - sharedHolder_->time_[idxLeft]) * sharedHolder_->data_[idxLeft + 1].col(sensorIdx_) +
-                        (sharedHolder_->time_[idxLeft + 1] - timeDesired) * sharedHolder_->data_[idxLeft].col(sensorIdx_));
+                float64_t const timeLeft = holder.time(idxLeft);
+                float64_t const timeRight = holder.time(idxLeft + 1);
+                get() = 1 / (timeRight - timeLeft) *
+                        ((timeDesired - timeLeft) * holder.data(idxLeft + 1).col(sensorIdx_) +
+                        (timeRight - timeDesired) * holder.data(idxLeft).col(sensorIdx_));
             }
             else
             {
@@ -372,26 +447,25 @@ namespace jiminy
             if (baseSensorOptions_->delay > EPS || baseSensorOptions_->jitter > EPS)
             {
                 // Return the oldest value since the buffer is not fully initialized yet
-                auto it = std::find_if(sharedHolder_->time_.begin(), sharedHolder_->time_.end(),
-                                       [] (float64_t const & t)
-                                       {
-                                           return t > 0;
-                                       });
-                if (it != sharedHolder_->time_.end())
+                Eigen::Index idx = 0;
+                while (idx < size && holder.time(idx) <= 0)
+                {
+                    ++idx;
+                }
+                if (idx < size)
                 {
-                    std::ptrdiff_t idx = std::distance(sharedHolder_->time_.begin(), it);
-                    idx = std::max(std::ptrdiff_t(0), idx - 1);
-                    get() = sharedHolder_->data_[idx].col(sensorIdx_);
+                    idx = std::max(Eigen::Index(0), idx - 1);
+                    get() = holder.data(idx).col(sensorIdx_);
                 }
                 else
                 {
-                    get() = sharedHolder_->data_.back().col(sensorIdx_);
+                    get() = holder.data(size - 1).col(sensorIdx_);
                 }
             }
             else
             {
                 // Return the most recent value available
-                get() = sharedHolder_->data_.back().col(sensorIdx_);
+                get() = holder.data(size - 1).col(sensorIdx_);
             }
         }
 
@@ -403,18 +477,78 @@ namespace jiminy
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
+        // Compute the real value at current time, namely taking into account the sensor delay
         for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
         {
-            // Compute the real value at current time, namely taking into account the sensor delay
             if (returnCode == hresult_t::SUCCESS)
             {
                 returnCode = sensor->interpolateData();
             }
+        }
+
+        // Shew the data with white noise and bias
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            skewDataAll();
+        }
+
+        return returnCode;
+    }
+
+    template<typename T>
+    void AbstractSensorTpl<T>::skewDataAll(void)
+    {
+        for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
+        {
+            sensor->measureData();
+        }
+    }
+
+    template<typename T>
+    void AbstractSensorTpl<T>::skewDataBatch(void)
+    {
+        // Gather the noise and bias again if the options of the sensors have changed
+        if (sharedHolder_->isNoiseAndBiasOutdated_)
+        {
+            refreshNoiseAndBias();
+        }
+
+        // Add white noise, without drawing any sample for noiseless components
+        if (sharedHolder_->noiseStd_.size())
+        {
+            sharedHolder_->dataMeasured_ += sharedHolder_->noiseStd_.unaryExpr(
+                [](float64_t const & noiseStd) -> float64_t
+                {
+                    if (noiseStd > 0.0)
+                    {
+                        return randNormal(0.0, noiseStd);
+                    }
+                    return 0.0;
+                });
+        }
+
+        // Add bias
+        if (sharedHolder_->bias_.size())
+        {
+            sharedHolder_->dataMeasured_ += sharedHolder_->bias_;
+        }
+    }
+
+    template<typename T>
+    hresult_t AbstractSensorTpl<T>::setDataAll(float64_t     const & t,
+                                               vectorN_t     const & q,
+                                               vectorN_t     const & v,
+                                               vectorN_t     const & a,
+                                               vectorN_t     const & uMotor,
+                                               forceVector_t const & fExternal)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
 
-            // Shew the data with white noise and bias
+        for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
+        {
             if (returnCode == hresult_t::SUCCESS)
             {
-                sensor->measureData();
+                returnCode = sensor->set(t, q, v, a, uMotor, fExternal);
             }
         }
 
@@ -441,63 +575,53 @@ namespace jiminy
            is available to handle the case where the solver goes back in time.
            Even though it can make the buffer quite large irrelevantly since
            the actual maximum step is given by engineOptions_->stepper.dtMax,
-           it is not a big deal in practice since `rotate`, `pop_front`, and
-           `push_back` have O(1) complexity. */
+           it is not a big deal in practice since the memory is allocated once
+           and only the ring indices are updated afterward. */
         float64_t const timeMin = t - sharedHolder_->delayMax_ - SIMULATION_MAX_TIMESTEP;
 
         // Internal buffer memory management
-        if (t + EPS > sharedHolder_->time_.back())
+        if (t + EPS > sharedHolder_->time(sharedHolder_->size_ - 1))
         {
-            if (timeMin > sharedHolder_->time_.front())
+            if (timeMin > sharedHolder_->time(0))
             {
                 // Remove some unecessary extra elements if appropriate
-                if (sharedHolder_->time_.size() > 1U + DELAY_MAX_BUFFER_EXCEED
-                && timeMin > sharedHolder_->time_[DELAY_MAX_BUFFER_EXCEED])
+                if (sharedHolder_->size_ > 1 + DELAY_MAX_BUFFER_EXCEED
+                && timeMin > sharedHolder_->time(DELAY_MAX_BUFFER_EXCEED))
                 {
-                    sharedHolder_->time_.erase_begin(DELAY_MAX_BUFFER_EXCEED);
-                    sharedHolder_->data_.erase_begin(DELAY_MAX_BUFFER_EXCEED);
-                    sharedHolder_->time_.rset_capacity(sharedHolder_->time_.size() + DELAY_MIN_BUFFER_RESERVE);
-                    sharedHolder_->data_.rset_capacity(sharedHolder_->data_.size() + DELAY_MIN_BUFFER_RESERVE);
+                    sharedHolder_->head_ = sharedHolder_->idx(DELAY_MAX_BUFFER_EXCEED);
+                    sharedHolder_->size_ -= DELAY_MAX_BUFFER_EXCEED;
+                    sharedHolder_->dropped_ += DELAY_MAX_BUFFER_EXCEED;
                 }
 
-                // Rotate the internal buffer
-                sharedHolder_->time_.rotate(sharedHolder_->time_.begin() + 1U);
-                sharedHolder_->data_.rotate(sharedHolder_->data_.begin() + 1U);
+                // Rotate the internal buffer, so that the oldest element becomes the most recent one
+                sharedHolder_->head_ = sharedHolder_->idx(1);
+                ++sharedHolder_->dropped_;
             }
             else
             {
                 // Increase capacity if required
-                if (sharedHolder_->time_.full())
+                if (sharedHolder_->size_ == sharedHolder_->time_.size())
                 {
-                    sharedHolder_->time_.rset_capacity(sharedHolder_->time_.size() + DELAY_MIN_BUFFER_RESERVE);
-                    sharedHolder_->data_.rset_capacity(sharedHolder_->data_.size() + DELAY_MIN_BUFFER_RESERVE);
+                    reserveDataBuffer(sharedHolder_->size_ + DELAY_MIN_BUFFER_RESERVE);
                 }
 
                 // Push back new empty buffer
-                sharedHolder_->time_.push_back(-1);
-                sharedHolder_->data_.push_back({getSize(), sharedHolder_->num_});
+                ++sharedHolder_->size_;
             }
         }
         else
         {
             /* Remove the extra last elements if for some reason the solver went back in time.
                It happens when an iteration fails using ode solvers relying on try_step mechanism. */
-            while (t + EPS < sharedHolder_->time_.back() && sharedHolder_->time_.size() > 1)
+            while (t + EPS < sharedHolder_->time(sharedHolder_->size_ - 1) && sharedHolder_->size_ > 1)
             {
-                sharedHolder_->time_.pop_back();
-                sharedHolder_->data_.pop_back();
+                --sharedHolder_->size_;
             }
         }
-        sharedHolder_->time_.back() = t;
+        sharedHolder_->time(sharedHolder_->size_ - 1) = t;
 
         // Update the last real data buffer
-        for (AbstractSensorBase * sensor : sharedHolder_->sensors_)
-        {
-            if (returnCode == hresult_t::SUCCESS)
-            {
-                returnCode = sensor->set(t, q, v, a, uMotor, fExternal);
-            }
-        }
+        returnCode = setDataAll(t, q, v, a, uMotor, fExternal);
 
         if (returnCode == hresult_t::SUCCESS)
         {
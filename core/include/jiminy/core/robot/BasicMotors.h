@@ -57,6 +57,7 @@ namespace jiminy
         auto shared_from_this() const { return shared_from(this); }
 
         hresult_t initialize(std::string const & jointName);
+        virtual hresult_t attachCopy(Robot & robot) const final override;
 
         virtual hresult_t setOptions(configHolder_t const & motorOptions) final override;
 
@@ -66,9 +67,166 @@ namespace jiminy
                                         float64_t const & v,
                                         float64_t const & a,
                                         float64_t command) final override;
+        virtual hresult_t computeEffortBatch(float64_t const & t,
+                                             vectorN_t const & q,
+                                             vectorN_t const & v,
+                                             vectorN_t const & a,
+                                             vectorN_t const & command,
+                                             std::vector<AbstractMotorBase *> const & motors) final override;
+        virtual hresult_t resetBatch(std::vector<AbstractMotorBase *> const & motors) final override;
+        void packBatch(std::vector<AbstractMotorBase *> const & motors);
+
+    private:
+        /// \brief Options and buffers packed over a group of motors, to evaluate them at once.
+        struct motorsBatch_t
+        {
+            std::vector<AbstractMotorBase *> motors;
+            vectorN_t mechanicalReduction;
+            vectorN_t commandLimit;
+            vectorN_t frictionViscousPositive;
+            vectorN_t frictionViscousNegative;
+            vectorN_t frictionDryPositive;
+            vectorN_t frictionDryNegative;
+            vectorN_t frictionDrySlope;
+            vectorN_t velocity;
+            vectorN_t command;
+            vectorN_t effort;
+        };
+
+    private:
+        std::unique_ptr<motorOptions_t const> motorOptions_;
+        bool_t isBatchOutdated_;  ///< Whether the options have changed since they have been packed
+        motorsBatch_t batch_;     ///< Only used if the motor is the first of its group
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief      DC or BLDC motor driven by a current loop.
+    ///
+    /// \details    The command is the desired motor torque. The current loop is modelled as a
+    ///             first-order system, whose target is saturated by the voltage available once
+    ///             the back-EMF has been subtracted, which gives rise to the torque-speed
+    ///             characteristic of the motor. The winding temperature follows a first-order
+    ///             thermal model driven by the Joule losses, and the winding resistance depends on
+    ///             it linearly.
+    ///
+    ///             The current and the temperature are the internal state of the motor. They are
+    ///             integrated by the stepper of the engine along with the state of the robot, so
+    ///             that they benefit from its error control and are never altered by rejected
+    ///             steps. Note that a large bandwidth of the current loop makes the dynamics stiff,
+    ///             which limits the step size of explicit schemes.
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class DCMotor : public AbstractMotorBase
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Dictionary gathering the configuration options shared between motors
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual configHolder_t getDefaultMotorOptions(void) override
+        {
+            // Add extra options or update default values
+            configHolder_t config = AbstractMotorBase::getDefaultMotorOptions();
+
+            config["torqueConstant"] = 0.1;
+            config["windingResistance"] = 0.5;
+            config["enableVoltageLimit"] = true;
+            config["voltageLimit"] = 48.0;
+            config["currentBandwidth"] = 2000.0;
+            config["thermalResistance"] = 2.0;
+            config["thermalCapacitance"] = 100.0;
+            config["ambientTemperature"] = 25.0;
+            config["resistanceTemperatureCoeff"] = 0.00393;
+
+            return config;
+        };
+
+        struct motorOptions_t : public abstractMotorOptions_t
+        {
+            float64_t const torqueConstant;              ///< Torque constant of the motor, which is also its back-EMF constant in SI units [N.m/A]
+            float64_t const windingResistance;           ///< Resistance of the winding at ambient temperature [Ohm]
+            bool_t    const enableVoltageLimit;          ///< Flag to enable the saturation of the current by the supply voltage
+            float64_t const voltageLimit;                ///< Supply voltage of the motor driver [V]
+            float64_t const currentBandwidth;            ///< Bandwidth of the current loop [rad/s]
+            float64_t const thermalResistance;           ///< Thermal resistance between the winding and the ambient air [K/W]
+            float64_t const thermalCapacitance;          ///< Thermal capacitance of the winding [J/K]
+            float64_t const ambientTemperature;          ///< Temperature of the ambient air [degC]
+            float64_t const resistanceTemperatureCoeff;  ///< Temperature coefficient of the winding resistance [1/K]
+
+            motorOptions_t(configHolder_t const & options) :
+            abstractMotorOptions_t(options),
+            torqueConstant(boost::get<float64_t>(options.at("torqueConstant"))),
+            windingResistance(boost::get<float64_t>(options.at("windingResistance"))),
+            enableVoltageLimit(boost::get<bool_t>(options.at("enableVoltageLimit"))),
+            voltageLimit(boost::get<float64_t>(options.at("voltageLimit"))),
+            currentBandwidth(boost::get<float64_t>(options.at("currentBandwidth"))),
+            thermalResistance(boost::get<float64_t>(options.at("thermalResistance"))),
+            thermalCapacitance(boost::get<float64_t>(options.at("thermalCapacitance"))),
+            ambientTemperature(boost::get<float64_t>(options.at("ambientTemperature"))),
+            resistanceTemperatureCoeff(boost::get<float64_t>(options.at("resistanceTemperatureCoeff")))
+            {
+                // Empty on purpose
+            }
+        };
+
+    public:
+        DCMotor(std::string const & name);
+        virtual ~DCMotor(void) = default;
+
+        auto shared_from_this() { return shared_from(this); }
+        auto shared_from_this() const { return shared_from(this); }
+
+        hresult_t initialize(std::string const & jointName);
+        virtual hresult_t attachCopy(Robot & robot) const final override;
+
+        virtual hresult_t setOptions(configHolder_t const & motorOptions) final override;
+
+        float64_t const & getCurrent(void) const;
+        float64_t const & getTemperature(void) const;
+
+    private:
+        virtual hresult_t computeEffort(float64_t const & t,
+                                        Eigen::VectorBlock<vectorN_t const> const & q,
+                                        float64_t const & v,
+                                        float64_t const & a,
+                                        float64_t command) final override;
+        virtual hresult_t computeEffortBatch(float64_t const & t,
+                                             vectorN_t const & q,
+                                             vectorN_t const & v,
+                                             vectorN_t const & a,
+                                             vectorN_t const & command,
+                                             std::vector<AbstractMotorBase *> const & motors) final override;
+        virtual hresult_t resetBatch(std::vector<AbstractMotorBase *> const & motors) final override;
+        void packBatch(std::vector<AbstractMotorBase *> const & motors);
+
+    private:
+        /// \brief Options and buffers packed over a group of motors, to evaluate them at once.
+        struct motorsBatch_t
+        {
+            std::vector<AbstractMotorBase *> motors;
+            vectorN_t torqueConstant;
+            vectorN_t mechanicalReduction;
+            vectorN_t commandLimit;
+            vectorN_t voltageLimit;
+            vectorN_t windingResistance;
+            vectorN_t resistanceTemperatureCoeff;
+            vectorN_t ambientTemperature;
+            vectorN_t currentBandwidth;
+            vectorN_t thermalResistance;
+            vectorN_t thermalCapacitance;
+            vectorN_t velocity;
+            vectorN_t command;
+            vectorN_t current;
+            vectorN_t temperature;
+            vectorN_t resistance;
+            vectorN_t currentTarget;
+            vectorN_t effort;
+            vectorN_t currentRate;
+            vectorN_t temperatureRate;
+        };
 
     private:
         std::unique_ptr<motorOptions_t const> motorOptions_;
+        bool_t isBatchOutdated_;  ///< Whether the options have changed since they have been packed
+        motorsBatch_t batch_;     ///< Only used if the motor is the first of its group
     };
 }
 
@@ -21,6 +21,7 @@ namespace jiminy
         auto shared_from_this() { return shared_from(this); }
 
         hresult_t initialize(std::string const & frameName);
+        virtual hresult_t attachCopy(Robot & robot) const final override;
 
         virtual hresult_t setOptions(configHolder_t const & sensorOptions) final override;
         virtual hresult_t refreshProxies(void) final override;
@@ -35,7 +36,15 @@ namespace jiminy
                               vectorN_t     const & a,
                               vectorN_t     const & uMotor,
                               forceVector_t const & fExternal) final override;
+        virtual hresult_t setDataAll(float64_t     const & t,
+                                     vectorN_t     const & q,
+                                     vectorN_t     const & v,
+                                     vectorN_t     const & a,
+                                     vectorN_t     const & uMotor,
+                                     forceVector_t const & fExternal) final override;
+        virtual void skewDataAll(void) final override;
         virtual void measureData(void) final override;
+        void computeData(Robot const & robot);
 
     private:
         std::string frameName_;
@@ -52,6 +61,7 @@ namespace jiminy
         auto shared_from_this() { return shared_from(this); }
 
         hresult_t initialize(std::string const & frameName);
+        virtual hresult_t attachCopy(Robot & robot) const final override;
 
         virtual hresult_t refreshProxies(void) final override;
 
@@ -65,10 +75,19 @@ namespace jiminy
                               vectorN_t     const & a,
                               vectorN_t     const & uMotor,
                               forceVector_t const & fExternal) final override;
+        virtual hresult_t setDataAll(float64_t     const & t,
+                                     vectorN_t     const & q,
+                                     vectorN_t     const & v,
+                                     vectorN_t     const & a,
+                                     vectorN_t     const & uMotor,
+                                     forceVector_t const & fExternal) final override;
+        virtual void skewDataAll(void) final override;
+        void computeData(Robot const & robot);
 
     private:
         std::string frameName_;
         frameIndex_t frameIdx_;
+        std::size_t contactIdx_;
     };
 
     class ForceSensor : public AbstractSensorTpl<ForceSensor>
@@ -80,6 +99,7 @@ namespace jiminy
         auto shared_from_this() { return shared_from(this); }
 
         hresult_t initialize(std::string const & frameName);
+        virtual hresult_t attachCopy(Robot & robot) const final override;
 
         virtual hresult_t refreshProxies(void) final override;
 
@@ -94,6 +114,15 @@ namespace jiminy
                               vectorN_t     const & a,
                               vectorN_t     const & uMotor,
                               forceVector_t const & fExternal) final override;
+        virtual hresult_t setDataAll(float64_t     const & t,
+                                     vectorN_t     const & q,
+                                     vectorN_t     const & v,
+                                     vectorN_t     const & a,
+                                     vectorN_t     const & uMotor,
+                                     forceVector_t const & fExternal) final override;
+        virtual void skewDataAll(void) final override;
+        void computeData(Robot         const & robot,
+                         forceVector_t const & fExternal);
 
     private:
         std::string frameName_;
@@ -111,6 +140,7 @@ namespace jiminy
         auto shared_from_this() { return shared_from(this); }
 
         hresult_t initialize(std::string const & jointName);
+        virtual hresult_t attachCopy(Robot & robot) const final override;
 
         virtual hresult_t refreshProxies(void) final override;
 
@@ -125,11 +155,22 @@ namespace jiminy
                               vectorN_t     const & a,
                               vectorN_t     const & uMotor,
                               forceVector_t const & fExternal) final override;
+        virtual hresult_t setDataAll(float64_t     const & t,
+                                     vectorN_t     const & q,
+                                     vectorN_t     const & v,
+                                     vectorN_t     const & a,
+                                     vectorN_t     const & uMotor,
+                                     forceVector_t const & fExternal) final override;
+        virtual void skewDataAll(void) final override;
+        void computeData(vectorN_t const & q,
+                         vectorN_t const & v);
 
     private:
         std::string jointName_;
         jointIndex_t jointIdx_;
         joint_t jointType_;
+        int32_t jointPositionIdx_;
+        int32_t jointVelocityIdx_;
     };
 
     class EffortSensor : public AbstractSensorTpl<EffortSensor>
@@ -141,6 +182,7 @@ namespace jiminy
         auto shared_from_this() { return shared_from(this); }
 
         hresult_t initialize(std::string const & motorName);
+        virtual hresult_t attachCopy(Robot & robot) const final override;
 
         virtual hresult_t refreshProxies(void) final override;
 
@@ -154,6 +196,14 @@ namespace jiminy
                               vectorN_t     const & a,
                               vectorN_t     const & uMotor,
                               forceVector_t const & fExternal) final override;
+        virtual hresult_t setDataAll(float64_t     const & t,
+                                     vectorN_t     const & q,
+                                     vectorN_t     const & v,
+                                     vectorN_t     const & a,
+                                     vectorN_t     const & uMotor,
+                                     forceVector_t const & fExternal) final override;
+        virtual void skewDataAll(void) final override;
+        void computeData(vectorN_t const & uMotor);
 
     private:
         std::string motorName_;
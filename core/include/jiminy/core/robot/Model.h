@@ -254,7 +254,24 @@ namespace jiminy
         hresult_t initialize(std::string              const & urdfPath,
                              bool_t                   const & hasFreeflyer = true,
                              std::vector<std::string> const & meshPackageDirs = {},
-                             bool_t                   const & loadVisualMeshes = false);
+                             bool_t                   const & loadVisualMeshes = false,
+                             std::string              const & cacheDir = "",
+                             bool_t                   const & deferVisualModel = false,
+                             uint32_t                 const & nThreads = 1U);
+
+        /// \brief Start a batch of updates of the model.
+        ///
+        /// \details Until the matching call to `endModelUpdate`, adding or removing frames,
+        ///          contact points and collision bodies, or changing the options, no longer
+        ///          regenerates the derived models nor refreshes the proxies. It is done only once
+        ///          at the end of the batch, which avoids a quadratic cost when applying many
+        ///          changes. In the meantime, the proxies may be out-of-date. Batches can be nested.
+        ///
+        /// \remark In C++, prefer `ModelUpdateGuard` to make sure that the batch always ends.
+        void beginModelUpdate(void);
+
+        /// \brief End a batch of updates of the model, then apply all the pending changes at once.
+        hresult_t endModelUpdate(void);
 
         /// \brief Add a frame in the kinematic tree, attached to the frame of an existing body.
         ///
@@ -314,6 +331,25 @@ namespace jiminy
         /// \brief Returns true if at least one constraint is active on the robot.
         bool_t hasConstraints(void) const;
 
+        /// \brief Sample new biases of the dynamics properties of the model, in-place.
+        ///
+        /// \details The mass, inertia and center of mass of the bodies, and the relative position
+        ///          of the joints, are perturbed according to the options, using the random number
+        ///          generator seeded by the engine. Contrary to regenerating the model, neither
+        ///          the model nor the data are reallocated and the proxies are not refreshed, so
+        ///          that it is cheap enough to be called at every episode for domain
+        ///          randomization. It is done automatically by `reset` when possible.
+        hresult_t randomizeModel(void);
+
+        /// \brief Build the visual model, if it has not been done already.
+        ///
+        /// \details When initializing the model from a URDF file with `deferVisualModel` enabled,
+        ///          building the visual model is deferred until it is actually needed, typically
+        ///          for rendering, so that it has no cost for headless simulations. Until then,
+        ///          the visual model is empty. It is built only once for the model and all its
+        ///          clones, going through the cache of the models if any.
+        hresult_t loadVisualModel(void);
+
         hresult_t setOptions(configHolder_t modelOptions);  // Make a copy
         configHolder_t getOptions(void) const;
 
@@ -326,6 +362,10 @@ namespace jiminy
         std::string const & getUrdfAsString(void) const;
         std::vector<std::string> const & getMeshPackageDirs(void) const;
         bool_t const & getHasFreeflyer(void) const;
+        /// \brief Version of the collision and visual models, stamped every time they are regenerated.
+        std::size_t const & getGeometryModelsVersion(void) const;
+        /// \brief Version of the options, stamped every time they are updated.
+        virtual std::size_t getOptionsVersion(void) const;
         // Getters without 'get' prefix for consistency with pinocchio C++ API
         int32_t const & nq(void) const;
         int32_t const & nv(void) const;
@@ -362,8 +402,26 @@ namespace jiminy
                                                vectorN_t       & vRigid) const;
 
     protected:
+        /// \brief Visual model built on first access, defined in the implementation.
+        struct deferredVisualModel_t;
+
+        /// \brief Initialize the model as a copy of another one.
+        ///
+        /// \details The pinocchio models are copied, which is cheap compared to parsing the URDF
+        ///          file again, while the collision and visual geometries, including meshes and
+        ///          their BVH, are shared with the other model since pinocchio stores them by
+        ///          shared pointer. The pinocchio and geometry data, the internal constraints and
+        ///          the options are deep-copied, so that both models can be simulated
+        ///          independently. User-registered constraints are not supported.
+        hresult_t copyFrom(Model const & model);
+
         hresult_t generateModelFlexible(void);
         hresult_t generateModelBiased(void);
+        /// \brief Regenerate the flexible and biased models if the original rigid model has changed,
+        ///        otherwise only sample new biases of the dynamics properties in-place.
+        hresult_t regenerateModels(void);
+        /// \brief Add biases to the dynamics properties of the model, assuming they are nominal.
+        void addModelBiases(void);
 
         hresult_t addFrame(std::string          const & frameName,
                            std::string          const & parentBodyName,
@@ -381,6 +439,14 @@ namespace jiminy
         hresult_t removeConstraints(std::vector<std::string> const & constraintsNames,
                                     constraintsHolderType_t const & holderType);
 
+        /// \brief Regenerate the derived models and refresh the proxies that are out-of-date, unless
+        ///        a batch of updates is in progress.
+        hresult_t flushModelUpdates(void);
+
+        /// \brief Restore a geometry model from its original version, then update its data.
+        void refreshGeometryModel(pinocchio::GeometryModel const & geomModelOrig,
+                                  pinocchio::GeometryModel       & geomModel,
+                                  pinocchio::GeometryData        & geomData);
         hresult_t refreshGeometryProxies(void);
         hresult_t refreshContactsProxies(void);
         /// \brief Refresh the proxies of the kinematics constraints.
@@ -432,6 +498,21 @@ namespace jiminy
         std::vector<std::string> accelerationFieldnames_;   ///< Fieldnames of the elements in the acceleration vector of the model
         std::vector<std::string> forceExternalFieldnames_;  ///< Concatenated fieldnames of the external force applied at each joint of the model, 'universe' excluded
 
+        uint32_t modelUpdateDepth_;             ///< Number of nested batches of updates in progress
+        bool_t isDataOrigStale_;                ///< Whether the original data must be regenerated
+        bool_t isModelFlexibleStale_;           ///< Whether the model must be reset, regenerating the flexible model
+        bool_t isModelBiasedStale_;             ///< Whether the biased model must be regenerated
+        bool_t areProxiesStale_;                ///< Whether all the proxies must be refreshed
+        bool_t areGeometryProxiesStale_;        ///< Whether the proxies of the geometry must be refreshed
+        bool_t areContactsProxiesStale_;        ///< Whether the proxies of the contacts must be refreshed
+        std::size_t pncModelOrigHash_;          ///< Hash of the original rigid model the last time the model has been regenerated
+        std::size_t geometryModelsVersion_;     ///< Version of the collision and visual models
+        std::size_t optionsVersion_;            ///< Version of the options
+        std::string cacheDir_;                  ///< Directory of the cache of the models built from the URDF file, empty if disabled
+        bool_t loadVisualMeshes_;               ///< Whether to load the meshes of the visual model, or only their placeholders
+        uint32_t nThreads_;                     ///< Maximum number of threads loading the meshes, 0 to use as many as supported by the hardware
+        std::shared_ptr<deferredVisualModel_t> visualModelDeferred_;  ///< Visual model built from the URDF file on first access, shared with the clones. Null if not deferred or already loaded.
+
     private:
         pinocchio::Model pncModelFlexibleOrig_;
         motionVector_t jointsAcceleration_;      ///< Vector of joints acceleration corresponding to a copy of data.a - temporary buffer for computing constraints.
@@ -440,6 +521,28 @@ namespace jiminy
         int32_t nv_;
         int32_t nx_;
     };
+
+    /// \brief Batch of updates of a model, ended automatically when going out of scope.
+    ///
+    /// \details Calling `end` explicitly is preferred, since it returns whether the pending
+    ///          changes have been applied successfully. Otherwise, the batch is ended by the
+    ///          destructor, so that an early return cannot leave the model updates on hold.
+    class ModelUpdateGuard
+    {
+    public:
+        // Disable the copy of the class
+        ModelUpdateGuard(ModelUpdateGuard const & modelUpdateGuardIn) = delete;
+        ModelUpdateGuard & operator = (ModelUpdateGuard const & other) = delete;
+
+        ModelUpdateGuard(Model & model);
+
+        ~ModelUpdateGuard(void);
+
+        hresult_t end(void);
+
+    private:
+        Model * model_;
+    };
 }
 
 #endif //end of JIMINY_MODEL_H
@@ -479,6 +479,63 @@ namespace pinocchio_overload
         }
     }
 
+    template<typename Scalar, int Options, template<typename, int> class JointCollectionTpl>
+    struct ProjectExternalForcesBackwardStep :
+    public pinocchio::fusion::JointUnaryVisitorBase<ProjectExternalForcesBackwardStep<Scalar, Options, JointCollectionTpl> >
+    {
+        typedef pinocchio::ModelTpl<Scalar, Options, JointCollectionTpl> Model;
+        typedef pinocchio::DataTpl<Scalar, Options, JointCollectionTpl> Data;
+
+        typedef boost::fusion::vector<Model const &, Data &> ArgsType;
+
+        template<typename JointModel>
+        static void algo(pinocchio::JointModelBase<JointModel> const & jmodel,
+                         pinocchio::JointDataBase<typename JointModel::JointDataDerived> & jdata,
+                         Model const & model,
+                         Data & data)
+        {
+            typedef typename Model::JointIndex JointIndex;
+
+            const JointIndex & i = jmodel.id();
+            const JointIndex & parent = model.parents[i];
+
+            jmodel.jointVelocitySelector(data.u) += jdata.S().transpose() * data.f[i];
+            if (parent > 0)
+            {
+                data.f[parent] += data.liMi[i].act(data.f[i]);
+            }
+        }
+    };
+
+    /// \brief Add the external forces projected in joint space to `data.u`, namely the sum of
+    /// J_i^T * fext_i, where J_i is the jacobian of joint i in local frame.
+    ///
+    /// The forces are accumulated along the kinematic tree by a backward pass, so that no jacobian
+    /// is computed, and the subtrees without external forces are skipped. It assumes that the joint
+    /// placements are already up-to-date. Note that `data.f` is used as internal buffer.
+    template<typename Scalar, int Options, template<typename, int> class JointCollectionTpl,
+             typename ForceDerived>
+    inline void projectExternalForces(pinocchio::ModelTpl<Scalar, Options, JointCollectionTpl> const & model,
+                                      pinocchio::DataTpl<Scalar, Options, JointCollectionTpl>        & data,
+                                      pinocchio::container::aligned_vector<ForceDerived>       const & fext)
+    {
+        for (int32_t i = 1; i < model.njoints; ++i)
+        {
+            data.f[i] = fext[i];
+        }
+
+        typedef ProjectExternalForcesBackwardStep<Scalar, Options, JointCollectionTpl> Pass;
+        for (int32_t i = model.njoints - 1; i > 0; --i)
+        {
+            // Nothing to do if neither the joint nor its subtree are subject to external forces
+            if (data.f[i].toVector().isZero(0.0))
+            {
+                continue;
+            }
+            Pass::run(model.joints[i], data.joints[i], typename Pass::ArgsType(model, data));
+        }
+    }
+
     template<typename JacobianType>
     hresult_t computeJMinvJt(pinocchio::Model const & model,
                              pinocchio::Data & data,
@@ -15,6 +15,20 @@ namespace jiminy
     class MutexLocal;
     class LockGuardLocal;
 
+    /// \brief Internal state of the sensors of a robot, i.e. their history of measurements.
+    ///
+    /// \details The buffers are stored by type of sensor, in the same order as the shared data
+    ///          holders of the robot.
+    struct sensorsState_t
+    {
+        std::vector<vectorN_t> time;     ///< Ring buffer of the stored timesteps
+        std::vector<matrixN_t> data;     ///< Ring buffer of past sensor real data
+        std::vector<Eigen::Index> head;  ///< Position of the oldest stored timestep in the ring buffers
+        std::vector<Eigen::Index> size;  ///< Number of stored timesteps
+        std::vector<int64_t> dropped;    ///< Total number of timesteps removed from the front of the ring buffers
+        vectorN_t dataMeasured;          ///< Current measurements of every sensors, as laid out by `getSensorsDataFlat`
+    };
+
     class Robot : public Model
     {
     public:
@@ -22,6 +36,7 @@ namespace jiminy
         using sensorsHolder_t = std::vector<std::shared_ptr<AbstractSensorBase> >;
         using sensorsGroupHolder_t = std::unordered_map<std::string, sensorsHolder_t>;
         using sensorsSharedHolder_t = std::unordered_map<std::string, std::shared_ptr<SensorSharedDataHolder_t> >;
+        using sensorsDataOffsets_t = std::unordered_map<std::string, std::unordered_map<std::string, Eigen::Index> >;
 
     public:
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -44,7 +59,25 @@ namespace jiminy
         hresult_t initialize(std::string const & urdfPath,
                              bool_t const & hasFreeflyer = true,
                              std::vector<std::string> const & meshPackageDirs = {},
-                             bool_t const & loadVisualMeshes = false);
+                             bool_t const & loadVisualMeshes = false,
+                             std::string const & cacheDir = "",
+                             bool_t const & deferVisualModel = false,
+                             uint32_t const & nThreads = 1U);
+
+        /// \brief Create a new robot sharing the immutable data of this one.
+        ///
+        /// \details The kinematic and dynamic models are copied, but the collision and visual
+        ///          geometries, including meshes and their BVH, are shared. The pinocchio and
+        ///          geometry data, the motors, the sensors and the options are duplicated, so that
+        ///          both robots can be simulated independently, e.g. in different threads. It is
+        ///          much faster than initializing a new robot from scratch.
+        ///
+        /// \warning It fails if the robot has user-registered constraints, or motors and sensors of
+        ///          user-defined types, even deriving from built-in ones, since they cannot be
+        ///          duplicated generically.
+        ///
+        /// \param[out] robot   New robot. It is left untouched on failure.
+        hresult_t clone(std::shared_ptr<Robot> & robot) const;
 
         hresult_t attachMotor(std::shared_ptr<AbstractMotorBase> motor);
         hresult_t getMotor(std::string const & motorName,
@@ -66,12 +99,24 @@ namespace jiminy
                               std::string const & sensorName);
         hresult_t detachSensors(std::string const & sensorType = {});
 
+        /// \brief Compute the actual effort of every motors, and the time derivative of their
+        ///        internal state s, which is set beforehand.
         void computeMotorsEfforts(float64_t const & t,
                                   vectorN_t const & q,
                                   vectorN_t const & v,
                                   vectorN_t const & a,
+                                  vectorN_t const & s,
                                   vectorN_t const & command);
         vectorN_t const & getMotorsEfforts(void) const;
+        /// \brief Internal state of every motors, stacked in the same order as `getMotors`.
+        ///
+        /// \details It is integrated by the stepper of the engine, which sets it at the end of
+        ///          every successful step.
+        vectorN_t const & getMotorsState(void) const;
+        void setMotorsState(vectorN_t const & s);
+        /// \brief Time derivative of the internal state of every motors, as computed by the
+        ///        last call to `computeMotorsEfforts`.
+        vectorN_t const & getMotorsStateDerivative(void) const;
         float64_t const & getMotorEffort(std::string const & motorName) const;
         void setSensorsData(float64_t     const & t,
                             vectorN_t     const & q,
@@ -81,9 +126,30 @@ namespace jiminy
                             forceVector_t const & fExternal);
 
         sensorsDataMap_t getSensorsData(void) const;
+
+        /// \brief Contiguous buffer storing the measurements of every sensors.
+        ///
+        /// \details The measurements of the sensors of a given type are stored next to each
+        ///          other, by sensor index, and the buffer is updated in-place by
+        ///          `setSensorsData`. Its memory is only reallocated when sensors are attached
+        ///          or detached, so that references to it remain valid during a simulation.
+        vectorN_t const & getSensorsDataFlat(void) const;
+        /// \brief Position of the measurements of each sensor in the contiguous buffer, by
+        ///        sensor type and name.
+        sensorsDataOffsets_t const & getSensorsDataOffsets(void) const;
         Eigen::Ref<vectorN_t const> getSensorData(std::string const & sensorType,
                                                   std::string const & sensorName) const;
 
+        /// \brief Backup the history of measurements of every sensors.
+        ///
+        /// \details Memory is only reallocated if the sensors or the size of their history have
+        ///          changed since the last call on the same state.
+        void getSensorsState(sensorsState_t & sensorsState) const;
+        /// \brief Restore the history of measurements of every sensors.
+        ///
+        /// \details The sensors must be the same as when the state has been saved.
+        hresult_t setSensorsState(sensorsState_t const & sensorsState);
+
         hresult_t setOptions(configHolder_t const & robotOptions);
         configHolder_t getOptions(void) const;
         hresult_t setMotorOptions(std::string    const & motorName,
@@ -108,6 +174,11 @@ namespace jiminy
         configHolder_t getModelOptions(void) const;
         hresult_t setTelemetryOptions(configHolder_t const & telemetryOptions);
         configHolder_t getTelemetryOptions(void) const;
+        /// \brief Version of the options of the robot, including its motors and sensors.
+        ///
+        /// \details Attaching or detaching a motor or a sensor stamps a new version, so that the
+        ///          version changes even if the remaining ones have older options.
+        virtual std::size_t getOptionsVersion(void) const override;
 
         hresult_t dumpOptions(std::string const & filepath) const;
         hresult_t loadOptions(std::string const & filepath);
@@ -134,6 +205,7 @@ namespace jiminy
 
         // Getters without 'get' prefix for consistency with pinocchio C++ API
         uint64_t const & nmotors(void) const;
+        int32_t const & ns(void) const;
 
         hresult_t getLock(std::unique_ptr<LockGuardLocal> & lock);
         bool_t const & getIsLocked(void) const;
@@ -154,6 +226,9 @@ namespace jiminy
         std::vector<std::string> commandFieldnames_;                                ///< Fieldnames of the command
         std::vector<std::string> motorEffortFieldnames_;                            ///< Fieldnames of the motors effort
         uint64_t nmotors_;                                                          ///< The number of motors
+        int32_t ns_;                                                                ///< Dimension of the internal state of the motors
+        vectorN_t sensorsDataFlat_;                                                 ///< Contiguous buffer storing the measurements of every sensors
+        sensorsDataOffsets_t sensorsDataOffsets_;                                   ///< Position of the measurements of each sensor in the contiguous buffer
 
     private:
         std::unique_ptr<MutexLocal> mutexLocal_;
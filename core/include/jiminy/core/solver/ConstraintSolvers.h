@@ -73,6 +73,17 @@ namespace jiminy
 
         virtual bool_t SolveBoxedForwardDynamics(float64_t const & inv_damping) override final;
 
+        /// \brief Whether the solver can be reused for a given set of constraints, ie the
+        ///        constraints are the very same objects, in the same order, and the dimension
+        ///        of the model has not changed.
+        bool_t isCompatible(constraintsHolder_t & constraintsHolder) const;
+
+        /// \brief Update the parameters of the solver without reallocating its buffers.
+        void setParameters(float64_t const & friction,
+                           float64_t const & torsion,
+                           float64_t const & tolAbs,
+                           float64_t const & tolRel);
+
     private:
         void ProjectedGaussSeidelIter(matrixN_t const & A,
                                       vectorN_t::SegmentReturnType const & b,
@@ -43,6 +43,33 @@ namespace jiminy
                                       state_t   const & solution,
                                       float64_t       & dt);
 
+            /// \brief Evaluate the continuous extension of the last successful step.
+            /// \details The state is obtained by integrating on the Lie group a weighted sum of the
+            ///          stages of the last step, starting from its initial state. Its time derivative
+            ///          is the same weighted sum, using the time derivative of the weights instead.
+            virtual bool_t interpolateImpl(float64_t         const & ratio,
+                                           float64_t         const & dt,
+                                           state_t                 & state,
+                                           stateDerivative_t       & stateDerivative) override final;
+
+            /// \brief The continuous extension consists of the stages of the last step, its initial
+            ///        state, and its final state derivative, in this order.
+            virtual void getDenseOutputImpl(std::vector<vectorN_t> & buffers) const override final;
+            virtual bool_t setDenseOutputImpl(std::vector<vectorN_t> const & buffers) override final;
+
+            /// \brief Compute the weights of the continuous extension of the last successful step.
+            /// \details By default, it corresponds to the cubic Hermite interpolation matching the state
+            ///          and its derivative at both ends of the step, which is third-order accurate.
+            ///          Schemes providing a dedicated continuous extension should override it.
+            ///
+            /// \param[in] ratio              Relative position within the last step, between 0 and 1.
+            /// \param[out] weights           Weight associated with each stage, followed by the weight
+            ///                               associated with the state derivative at the end of the step.
+            /// \param[out] weightsDerivative Derivative of the weights wrt. the relative position.
+            virtual void computeDenseOutputWeights(float64_t const & ratio,
+                                                   vectorN_t       & weights,
+                                                   vectorN_t       & weightsDerivative) const;
+
         private:
             matrixN_t A_;    ///< Weight matrix.
             vectorN_t b_;    ///< Solution coefficients.
@@ -55,6 +82,12 @@ namespace jiminy
             state_t stateBuffer_;                ///< Internal buffer storing intermediary state during knots computations.
             state_t candidateSolution_;          ///< Internal buffer storing the candidate solution (i.e. before knowing if the step is successful).
 
+        private:
+            state_t stateInit_;                     ///< Initial state of the last successful step, used for dense output.
+            stateDerivative_t stateDerivativeEnd_;  ///< Final state derivative of the last successful step if not FSAL.
+            vectorN_t denseOutputWeights_;          ///< Internal buffer storing the dense output weights.
+            vectorN_t denseOutputWeightsDot_;       ///< Internal buffer storing the derivative of the dense output weights.
+
     };
 }
 
@@ -10,6 +10,8 @@
 ///             This means that classical stepper implementations cannot be used as is: this
 ///             class thus defines an interface for implementing variable-step numerical
 ///             solvers on this type of system.
+///             The internal state of the motors s, e.g. the current of a DC motor, is integrated
+///             along with (q, v), so that the steps rejected by the error control do not alter it.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 #ifndef JIMINY_ABSTRACT_STEPPER_H
@@ -25,13 +27,25 @@ namespace jiminy
     using systemDynamics = std::function<void(float64_t const & /*t*/,
                                               std::vector<vectorN_t> const & /*qSplit*/,
                                               std::vector<vectorN_t> const & /*vSplit*/,
-                                              std::vector<vectorN_t> & /*aSplit*/)>;
+                                              std::vector<vectorN_t> const & /*sSplit*/,
+                                              std::vector<vectorN_t> & /*aSplit*/,
+                                              std::vector<vectorN_t> & /*dsSplit*/)>;
+
+    /// \brief Continuous extension of the last successful step, namely everything needed by
+    ///        `interpolate`.
+    struct stepperDenseOutput_t
+    {
+    public:
+        float64_t tPrev;                 ///< Start time of the last successful step
+        float64_t dtPrev;                ///< Duration of the last successful step
+        std::vector<vectorN_t> buffers;  ///< Stepper-specific buffers, eg the stages of the last step
+    };
 
     class AbstractStepper
     {
     public:
         /// \brief Constructor
-        /// \param[in] f       Dynamics function, with signature a = f(t, q, v)
+        /// \param[in] f       Dynamics function, with signature (a, ds) = f(t, q, v, s)
         /// \param[in] robots  Robots whose dynamics the stepper will work on.
         AbstractStepper(systemDynamics const & f,
                         std::vector<Robot const *> const & robots);
@@ -45,17 +59,53 @@ namespace jiminy
         ///
         /// \param[in, out] q   System starting position.
         /// \param[in, out] v   System starting velocity.
+        /// \param[in, out] s   System starting internal state of the motors.
         /// \param[in, out] a   System starting acceleration.
+        /// \param[in, out] ds  System starting time derivative of the internal state of the motors.
         /// \param[in, out] t   Integration start time.
         /// \param[in, out] dt  Input: desired integration duration. Output: recommended step size for
         ///                     variable-step schemes. Constant-step schemes leave this value unmodified.
-        /// \return True if integration was successful, false otherwise. In that case, (q, v, a) are not updated.
+        /// \return True if integration was successful, false otherwise. In that case, (q, v, s, a, ds)
+        ///         are not updated.
         bool_t tryStep(std::vector<vectorN_t> & q,
                        std::vector<vectorN_t> & v,
+                       std::vector<vectorN_t> & s,
                        std::vector<vectorN_t> & a,
+                       std::vector<vectorN_t> & ds,
                        float64_t              & t,
                        float64_t              & dt);
 
+        /// \brief Evaluate the continuous extension of the solution over the last successful step.
+        /// \details It only makes sense to call this method right after a successful call to `tryStep`,
+        ///          and before the next one. The acceleration is the time derivative of the interpolated
+        ///          velocity, so that it is obtained from the stages of the last step without evaluating
+        ///          the dynamics.
+        ///
+        /// \param[in] t       Time at which to evaluate the solution. It must lie within the last step.
+        /// \param[out] qSplit  Interpolated position.
+        /// \param[out] vSplit  Interpolated velocity.
+        /// \param[out] sSplit  Interpolated internal state of the motors.
+        /// \param[out] aSplit  Interpolated acceleration.
+        /// \param[out] dsSplit Interpolated time derivative of the internal state of the motors.
+        /// \return True if the interpolation is supported by the stepper and t is within the last step,
+        ///         false otherwise. In that case, (q, v, s, a, ds) are not updated.
+        bool_t interpolate(float64_t              const & t,
+                           std::vector<vectorN_t>       & qSplit,
+                           std::vector<vectorN_t>       & vSplit,
+                           std::vector<vectorN_t>       & sSplit,
+                           std::vector<vectorN_t>       & aSplit,
+                           std::vector<vectorN_t>       & dsSplit);
+
+        /// \brief Backup the continuous extension of the last successful step.
+        /// \details Memory is only reallocated the first time, so that saving it repeatedly into
+        ///          the same object is cheap.
+        void getDenseOutput(stepperDenseOutput_t & denseOutput) const;
+
+        /// \brief Restore the continuous extension saved previously by `getDenseOutput`.
+        /// \return True if the continuous extension is consistent with the stepper, false
+        ///         otherwise. In that case, the stepper is not altered.
+        bool_t setDenseOutput(stepperDenseOutput_t const & denseOutput);
+
     protected:
         /// \brief Internal tryStep method wrapping the arguments as state_t and stateDerivative_t.
         virtual bool_t tryStepImpl(state_t                 & state,
@@ -63,6 +113,24 @@ namespace jiminy
                                    float64_t         const & t,
                                    float64_t               & dt) = 0;
 
+        /// \brief Internal interpolate method wrapping the output as state_t and stateDerivative_t.
+        /// \details Dense output is not supported by default.
+        ///
+        /// \param[in] ratio            Relative position within the last step, between 0 and 1.
+        /// \param[in] dt               Duration of the last step.
+        /// \param[out] state           Interpolated state.
+        /// \param[out] stateDerivative Time derivative of the interpolated state.
+        virtual bool_t interpolateImpl(float64_t         const & ratio,
+                                       float64_t         const & dt,
+                                       state_t                 & state,
+                                       stateDerivative_t       & stateDerivative);
+
+        /// \brief Internal getDenseOutput and setDenseOutput methods handling the stepper-specific
+        ///        buffers of the continuous extension.
+        /// \details There is none by default, since dense output is not supported.
+        virtual void getDenseOutputImpl(std::vector<vectorN_t> & buffers) const;
+        virtual bool_t setDenseOutputImpl(std::vector<vectorN_t> const & buffers);
+
         /// \brief Wrapper around the system dynamics: stateDerivative = f(t, state)
         stateDerivative_t const & f(float64_t const & t,
                                     state_t   const & state);
@@ -73,6 +141,10 @@ namespace jiminy
         state_t state_;                      ///< State derivative computation buffer.
         stateDerivative_t stateDerivative_;  ///< State derivative computation buffer.
         stateDerivative_t fOutput_;          ///< State derivative computation buffer.
+        state_t stateInterp_;                ///< Interpolated state computation buffer.
+        stateDerivative_t stateDerivativeInterp_;  ///< Interpolated state derivative computation buffer.
+        float64_t tPrev_;                    ///< Start time of the last successful step.
+        float64_t dtPrev_;                   ///< Duration of the last successful step.
     };
 }
 
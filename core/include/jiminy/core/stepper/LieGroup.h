@@ -2,9 +2,10 @@
 ///
 /// \brief      Handling of the joint configuration q as part of a Lie Group, not a vector space.
 ///
-/// \details    The state of the system, (q, v), lies in a Lie Group, while its derivative
-///             (v, a) is a tangent vector to this group: the classes in this file are
-///             meant to handle this.
+/// \details    The state of the system, (q, v, s), lies in a Lie Group, while its derivative
+///             (v, a, ds) is a tangent vector to this group: the classes in this file are
+///             meant to handle this. The internal state of the motors s, e.g. the current of
+///             a DC motor, lies in a plain vector space.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 #ifndef JIMINY_LIE_GROUP_H
@@ -80,6 +81,9 @@ namespace Eigen
         DataType const & a(void) const { return derived().a(); }
         DataType & a(void) { return derived().a(); }
 
+        DataType const & ds(void) const { return derived().ds(); }
+        DataType & ds(void) { return derived().ds(); }
+
         template<int p>
         RealScalar lpNorm(void) const;
         RealScalar norm(void) const { return lpNorm<2>(); };
@@ -89,6 +93,7 @@ namespace Eigen
         {
             derived().v().setZero();
             derived().a().setZero();
+            derived().ds().setZero();
         }
 
         #define GENERATE_OPERATOR_MULT(OP,NAME) \
@@ -96,6 +101,7 @@ namespace Eigen
         { \
             v().array() EIGEN_CAT(OP,=) scalar; \
             a().array() EIGEN_CAT(OP,=) scalar; \
+            ds().array() EIGEN_CAT(OP,=) scalar; \
             return *this; \
         } \
          \
@@ -103,7 +109,7 @@ namespace Eigen
         (operator OP)(Scalar const & scalar) const \
         { \
             return StateDerivativeWrapper<EIGEN_EXPR_BINARYOP_SCALAR_RETURN_TYPE(DataType,Scalar,NAME) const>( \
-                robot(), v() OP scalar, a() OP scalar); \
+                robot(), v() OP scalar, a() OP scalar, ds() OP scalar); \
         } \
          \
         friend StateDerivativeWrapper<EIGEN_EXPR_BINARYOP_SCALAR_RETURN_TYPE(DataType,Scalar,NAME) const> const \
@@ -125,6 +131,7 @@ namespace Eigen
             assert(robot() == other.robot()); \
             v() EIGEN_CAT(OP,=) other.v(); \
             a() EIGEN_CAT(OP,=) other.a(); \
+            ds() EIGEN_CAT(OP,=) other.ds(); \
             return *this; \
         } \
          \
@@ -132,6 +139,7 @@ namespace Eigen
         { \
             v().array() EIGEN_CAT(OP,=) scalar; \
             a().array() EIGEN_CAT(OP,=) scalar; \
+            ds().array() EIGEN_CAT(OP,=) scalar; \
             return *this; \
         } \
          \
@@ -140,8 +148,10 @@ namespace Eigen
         { \
             typename internal::plain_constant_type<DataType,Scalar>::type const scalarConst( \
                 v().size(), 1, scalar); \
+            typename internal::plain_constant_type<DataType,Scalar>::type const scalarConstState( \
+                ds().size(), 1, scalar); \
             return StateDerivativeWrapper<EIGEN_EXPR_BINARYOP_SCALAR_RETURN_TYPE(DataType,Scalar,NAME) const>( \
-                robot(), v() OP scalarConst, a() OP scalarConst); \
+                robot(), v() OP scalarConst, a() OP scalarConst, ds() OP scalarConstState); \
         } \
          \
         friend StateDerivativeWrapper<EIGEN_EXPR_BINARYOP_SCALAR_RETURN_TYPE(DataType,Scalar,NAME) const> const \
@@ -159,7 +169,7 @@ namespace Eigen
             assert(robot() == other.robot()); \
             return StateDerivativeWrapper<EIGEN_CWISE_BINARY_RETURN_TYPE( \
                 DataType,typename OtherDerived::DataType,NAME) const>( \
-                    robot(), v() OP other.v(), a() OP other.a()); \
+                    robot(), v() OP other.v(), a() OP other.a(), ds() OP other.ds()); \
         }
 
         GENERATE_OPERATOR_ADD(+,sum)
@@ -176,7 +186,8 @@ namespace Eigen
             static inline RealScalar run(StateDerivativeBase<Derived> const & velocity)
             {
                 return std::pow(velocity.v().cwiseAbs().array().pow(p).sum() +
-                                velocity.a().cwiseAbs().array().pow(p).sum(),
+                                velocity.a().cwiseAbs().array().pow(p).sum() +
+                                velocity.ds().cwiseAbs().array().pow(p).sum(),
                                 RealScalar(1)/p);
             }
         };
@@ -187,7 +198,9 @@ namespace Eigen
             static inline typename StateDerivativeBase<Derived>::RealScalar
             run(StateDerivativeBase<Derived> const & velocity)
             {
-                return velocity.v().cwiseAbs().sum() + velocity.a().cwiseAbs().sum();
+                return velocity.v().cwiseAbs().sum() +
+                       velocity.a().cwiseAbs().sum() +
+                       velocity.ds().cwiseAbs().sum();
             }
         };
 
@@ -197,8 +210,10 @@ namespace Eigen
             static inline typename StateDerivativeBase<Derived>::RealScalar
             run(StateDerivativeBase<Derived> const & velocity)
             {
-                return std::max(velocity.v().cwiseAbs().maxCoeff(),
-                                velocity.a().cwiseAbs().maxCoeff());
+                // The motors may have no internal state, and 'maxCoeff' is undefined if empty
+                return std::max({velocity.v().cwiseAbs().maxCoeff(),
+                                 velocity.a().cwiseAbs().maxCoeff(),
+                                 velocity.ds().size() > 0 ? velocity.ds().cwiseAbs().maxCoeff() : 0.0});
             }
         };
     }
@@ -229,20 +244,24 @@ namespace Eigen
     public:
         explicit StateDerivative(Robot const * const & robotIn,
                                  vectorN_t const & vIn,
-                                 vectorN_t const & aIn) :
+                                 vectorN_t const & aIn,
+                                 vectorN_t const & dsIn) :
         robot_(robotIn),
         v_(vIn),
-        a_(aIn)
+        a_(aIn),
+        ds_(dsIn)
         {
             // Empty on purpose
         }
 
         explicit StateDerivative(Robot const * const & robotIn,
                                  vectorN_t && vIn,
-                                 vectorN_t && aIn) :
+                                 vectorN_t && aIn,
+                                 vectorN_t && dsIn) :
         robot_(robotIn),
         v_(std::move(vIn)),
-        a_(std::move(aIn))
+        a_(std::move(aIn)),
+        ds_(std::move(dsIn))
         {
             // Empty on purpose
         }
@@ -251,7 +270,8 @@ namespace Eigen
                                  vectorN_t && vIn) :
         robot_(robotIn),
         v_(std::move(vIn)),
-        a_(robot_->nv())
+        a_(robot_->nv()),
+        ds_(robot_->ns())
         {
             // Empty on purpose
         }
@@ -259,7 +279,8 @@ namespace Eigen
         explicit StateDerivative(Robot const * const & robotIn) :
         robot_(robotIn),
         v_(robot_->nv()),
-        a_(robot_->nv())
+        a_(robot_->nv()),
+        ds_(robot_->ns())
         {
             // Empty on purpose
         }
@@ -267,7 +288,8 @@ namespace Eigen
         StateDerivative(StateDerivative const & other) :
         robot_(other.robot()),
         v_(other.v()),
-        a_(other.a())
+        a_(other.a()),
+        ds_(other.ds())
         {
             // Empty on purpose
         }
@@ -275,7 +297,8 @@ namespace Eigen
         StateDerivative(StateDerivative && other) :
         robot_(other.robot()),
         v_(std::move(other.v())),
-        a_(std::move(other.a()))
+        a_(std::move(other.a())),
+        ds_(std::move(other.ds()))
         {
             // Empty on purpose
         }
@@ -284,7 +307,8 @@ namespace Eigen
         StateDerivative(StateDerivativeBase<OtherDerived> const & other) :
         robot_(other.robot()),
         v_(other.v()),
-        a_(other.a())
+        a_(other.a()),
+        ds_(other.ds())
         {
             // Empty on purpose
         }
@@ -294,6 +318,8 @@ namespace Eigen
         DataType & v(void) { return v_; }
         DataType const & a(void) const { return a_; }
         DataType & a(void) { return a_; }
+        DataType const & ds(void) const { return ds_; }
+        DataType & ds(void) { return ds_; }
 
         static StateDerivativeWrapper<typename DataType::ConstantReturnType const> const
         Zero(Robot const * const & robotIn);
@@ -307,6 +333,7 @@ namespace Eigen
             robot_ = other.robot();
             v_ = other.v();
             a_ = other.a();
+            ds_ = other.ds();
             return *this;
         }
 
@@ -315,6 +342,7 @@ namespace Eigen
             robot_ = other.robot();
             v_ = other.v();
             a_ = other.a();
+            ds_ = other.ds();
             return *this;
         }
 
@@ -323,6 +351,7 @@ namespace Eigen
             robot_ = other.robot_;
             v_ = std::move(other.v_);
             a_ = std::move(other.a_);
+            ds_ = std::move(other.ds_);
             return *this;
         }
 
@@ -330,6 +359,7 @@ namespace Eigen
         Robot const * robot_;
         DataType v_;
         DataType a_;
+        DataType ds_;
     };
 
     namespace internal {
@@ -352,20 +382,24 @@ namespace Eigen
 
         explicit StateDerivativeWrapper(Robot const * const & robotIn,
                                         DataType & vIn,
-                                        DataType & aIn) :
+                                        DataType & aIn,
+                                        DataType & dsIn) :
         robot_(robotIn),
         vRef_(vIn),
-        aRef_(aIn)
+        aRef_(aIn),
+        dsRef_(dsIn)
         {
             // Empty on purpose
         }
 
         explicit StateDerivativeWrapper(Robot const * const & robotIn,
                                         DataType && vIn,
-                                        DataType && aIn) :
+                                        DataType && aIn,
+                                        DataType && dsIn) :
         robot_(robotIn),
         vRef_(std::move(vIn)),
-        aRef_(std::move(aIn))
+        aRef_(std::move(aIn)),
+        dsRef_(std::move(dsIn))
         {
             // Empty on purpose
         }
@@ -373,11 +407,13 @@ namespace Eigen
         Robot const * const & robot(void) const { return robot_; }
         DataType const & v(void) const { return vRef_; }
         DataType const & a(void) const { return aRef_; }
+        DataType const & ds(void) const { return dsRef_; }
 
     protected:
         Robot const * robot_;
         typename DataType::Nested vRef_;
         typename DataType::Nested aRef_;
+        typename DataType::Nested dsRef_;
     };
 
     template<typename _DataType>
@@ -385,7 +421,8 @@ namespace Eigen
     StateDerivative<_DataType>::Zero(Robot const * const & robotIn)
     {
         return StateDerivativeWrapper<typename DataType::ConstantReturnType const>(
-            robotIn, DataType::Zero(robotIn->nv()), DataType::Zero(robotIn->nv()));
+            robotIn, DataType::Zero(robotIn->nv()), DataType::Zero(robotIn->nv()),
+            DataType::Zero(robotIn->ns()));
     }
 
     template<typename _DataType>
@@ -393,7 +430,8 @@ namespace Eigen
     StateDerivative<_DataType>::Ones(Robot const * const & robotIn)
     {
         return StateDerivativeWrapper<typename DataType::ConstantReturnType const>(
-            robotIn, DataType::Ones(robotIn->nv()), DataType::Ones(robotIn->nv()));
+            robotIn, DataType::Ones(robotIn->nv()), DataType::Ones(robotIn->nv()),
+            DataType::Ones(robotIn->ns()));
     }
 
     // ====================================================
@@ -427,6 +465,9 @@ namespace Eigen
         DataType const & v(void) const { return derived().v(); }
         DataType & v(void) { return derived().v(); }
 
+        DataType const & s(void) const { return derived().s(); }
+        DataType & s(void) { return derived().s(); }
+
         template<int p>
         RealScalar lpNorm(void) const;
         RealScalar norm(void) const { return lpNorm<2>(); };
@@ -436,6 +477,7 @@ namespace Eigen
         {
             derived().q().setZero();
             derived().v().setZero();
+            derived().s().setZero();
         }
 
         template<typename OtherDerived, typename OutDerived>
@@ -446,6 +488,7 @@ namespace Eigen
             assert(robot() == velocity.robot() && robot() == out.robot());
             pinocchio::integrate(robot()->pncModel_, q(), velocity.v(), out.q());
             out.v() = v() + velocity.a();
+            out.s() = s() + velocity.ds();
             return out;
         }
 
@@ -462,6 +505,7 @@ namespace Eigen
             assert(robot() == position.robot() && robot() == out.robot());
             pinocchio::difference(robot()->pncModel_, q(), position.q(), out.v());
             out.a() = v() - position.v();
+            out.ds() = s() - position.s();
             return out;
         }
     };
@@ -474,7 +518,8 @@ namespace Eigen
             static inline RealScalar run(StateBase<Derived> const & velocity)
             {
                 return std::pow(velocity.q().cwiseAbs().array().pow(p).sum() +
-                                velocity.v().cwiseAbs().array().pow(p).sum(),
+                                velocity.v().cwiseAbs().array().pow(p).sum() +
+                                velocity.s().cwiseAbs().array().pow(p).sum(),
                                 RealScalar(1)/p);
             }
         };
@@ -485,7 +530,9 @@ namespace Eigen
             static inline typename StateBase<Derived>::RealScalar
             run(StateBase<Derived> const & velocity)
             {
-                return velocity.q().cwiseAbs().sum() + velocity.v().cwiseAbs().sum();
+                return velocity.q().cwiseAbs().sum() +
+                       velocity.v().cwiseAbs().sum() +
+                       velocity.s().cwiseAbs().sum();
             }
         };
 
@@ -495,8 +542,10 @@ namespace Eigen
             static inline typename StateBase<Derived>::RealScalar
             run(StateBase<Derived> const & velocity)
             {
-                return std::max(velocity.q().cwiseAbs().maxCoeff(),
-                                velocity.v().cwiseAbs().maxCoeff());
+                // The motors may have no internal state, and 'maxCoeff' is undefined if empty
+                return std::max({velocity.q().cwiseAbs().maxCoeff(),
+                                 velocity.v().cwiseAbs().maxCoeff(),
+                                 velocity.s().size() > 0 ? velocity.s().cwiseAbs().maxCoeff() : 0.0});
             }
         };
     }
@@ -527,20 +576,24 @@ namespace Eigen
     public:
         explicit State(Robot const * const & robotIn,
                        vectorN_t const & qIn,
-                       vectorN_t const & vIn) :
+                       vectorN_t const & vIn,
+                       vectorN_t const & sIn) :
         robot_(robotIn),
         q_(qIn),
-        v_(vIn)
+        v_(vIn),
+        s_(sIn)
         {
             // Empty on purpose
         }
 
         explicit State(Robot const * const & robotIn,
                        vectorN_t && qIn,
-                       vectorN_t && vIn) :
+                       vectorN_t && vIn,
+                       vectorN_t && sIn) :
         robot_(robotIn),
         q_(std::move(qIn)),
-        v_(std::move(vIn))
+        v_(std::move(vIn)),
+        s_(std::move(sIn))
         {
             // Empty on purpose
         }
@@ -548,7 +601,8 @@ namespace Eigen
         explicit State(Robot const * const & robotIn) :
         robot_(robotIn),
         q_(robot_->nq()),
-        v_(robot_->nv())
+        v_(robot_->nv()),
+        s_(robot_->ns())
         {
             // Empty on purpose
         }
@@ -556,7 +610,8 @@ namespace Eigen
         State(State const & other) :
         robot_(other.robot()),
         q_(other.q()),
-        v_(other.v())
+        v_(other.v()),
+        s_(other.s())
         {
             // Empty on purpose
         }
@@ -564,7 +619,8 @@ namespace Eigen
         State(State && other) :
         robot_(other.robot()),
         q_(std::move(other.q())),
-        v_(std::move(other.v()))
+        v_(std::move(other.v())),
+        s_(std::move(other.s()))
         {
             // Empty on purpose
         }
@@ -573,7 +629,8 @@ namespace Eigen
         State(StateBase<OtherDerived> const & other) :
         robot_(other.robot()),
         q_(other.q()),
-        v_(other.v())
+        v_(other.v()),
+        s_(other.s())
         {
             // Empty on purpose
         }
@@ -583,6 +640,8 @@ namespace Eigen
         DataType & q(void) { return q_; }
         DataType const & v(void) const { return v_; }
         DataType & v(void) { return v_; }
+        DataType const & s(void) const { return s_; }
+        DataType & s(void) { return s_; }
 
         static StateWrapper<typename DataType::ConstantReturnType const> const
         Zero(Robot const * const & robotIn);
@@ -596,6 +655,7 @@ namespace Eigen
             robot_ = other.robot();
             q_ = other.q();
             v_ = other.v();
+            s_ = other.s();
             return *this;
         }
 
@@ -604,6 +664,7 @@ namespace Eigen
             robot_ = other.robot();
             q_ = other.q();
             v_ = other.v();
+            s_ = other.s();
             return *this;
         }
 
@@ -612,6 +673,7 @@ namespace Eigen
             robot_ = other.robot();
             q_ = std::move(other.q_);
             v_ = std::move(other.v_);
+            s_ = std::move(other.s_);
             return *this;
         }
 
@@ -619,6 +681,7 @@ namespace Eigen
         Robot const * robot_;
         DataType q_;
         DataType v_;
+        DataType s_;
     };
 
     namespace internal {
@@ -641,20 +704,24 @@ namespace Eigen
 
         explicit StateWrapper(Robot const * const & robotIn,
                               DataType & qIn,
-                              DataType & vIn) :
+                              DataType & vIn,
+                              DataType & sIn) :
         robot_(robotIn),
         qRef_(qIn),
-        vRef_(vIn)
+        vRef_(vIn),
+        sRef_(sIn)
         {
             // Empty on purpose
         }
 
         explicit StateWrapper(Robot const * const & robotIn,
                               DataType && qIn,
-                              DataType && vIn) :
+                              DataType && vIn,
+                              DataType && sIn) :
         robot_(robotIn),
         qRef_(std::move(qIn)),
-        vRef_(std::move(vIn))
+        vRef_(std::move(vIn)),
+        sRef_(std::move(sIn))
         {
             // Empty on purpose
         }
@@ -662,11 +729,13 @@ namespace Eigen
         Robot const * const & robot(void) const { return robot_; }
         DataType const & q(void) const { return qRef_; }
         DataType const & v(void) const { return vRef_; }
+        DataType const & s(void) const { return sRef_; }
 
     protected:
         Robot const * robot_;
         typename DataType::Nested qRef_;
         typename DataType::Nested vRef_;
+        typename DataType::Nested sRef_;
     };
 
     template<typename _DataType>
@@ -674,7 +743,8 @@ namespace Eigen
     State<_DataType>::Zero(Robot const * const & robotIn)
     {
         return StateWrapper<typename DataType::ConstantReturnType const>(
-            robotIn, DataType::Zero(robotIn->nq()), DataType::Zero(robotIn->nv()));
+            robotIn, DataType::Zero(robotIn->nq()), DataType::Zero(robotIn->nv()),
+            DataType::Zero(robotIn->ns()));
     }
 
     template<typename _DataType>
@@ -682,7 +752,8 @@ namespace Eigen
     State<_DataType>::Ones(Robot const * const & robotIn)
     {
         return StateWrapper<typename DataType::ConstantReturnType const>(
-            robotIn, DataType::Ones(robotIn->nq()), DataType::Ones(robotIn->nv()));
+            robotIn, DataType::Ones(robotIn->nq()), DataType::Ones(robotIn->nv()),
+            DataType::Ones(robotIn->ns()));
     }
 
     // ====================================================
@@ -1053,7 +1124,7 @@ namespace Eigen
     // ================== Specializations =================
     // ====================================================
 
-    #define GENERATE_SHARED_IMPL(BASE,VAR1,SIZE1,VAR2,SIZE2) \
+    #define GENERATE_SHARED_IMPL(BASE,VAR1,SIZE1,VAR2,SIZE2,VAR3,SIZE3) \
     namespace internal { \
         template<> \
         struct traits<EIGEN_CAT(BASE,Shared)> \
@@ -1070,10 +1141,12 @@ namespace Eigen
          \
         explicit EIGEN_CAT(BASE,Shared)(Robot const * const & robot, \
                                         Eigen::Ref<vectorN_t> const & VAR1, \
-                                        Eigen::Ref<vectorN_t> const & VAR2) : \
+                                        Eigen::Ref<vectorN_t> const & VAR2, \
+                                        Eigen::Ref<vectorN_t> const & VAR3) : \
         robot_(robot), \
         EIGEN_CAT(VAR1,Ref_)(VAR1), \
-        EIGEN_CAT(VAR2,Ref_)(VAR2) \
+        EIGEN_CAT(VAR2,Ref_)(VAR2), \
+        EIGEN_CAT(VAR3,Ref_)(VAR3) \
         { \
             /* Empty on purpose */ \
         } \
@@ -1083,11 +1156,14 @@ namespace Eigen
         Eigen::Ref<vectorN_t> const & VAR1(void) const { return EIGEN_CAT(VAR1,Ref_); } \
         Eigen::Ref<vectorN_t> & VAR2(void) { return EIGEN_CAT(VAR2,Ref_); } \
         Eigen::Ref<vectorN_t> const & VAR2(void) const { return EIGEN_CAT(VAR2,Ref_); } \
+        Eigen::Ref<vectorN_t> & VAR3(void) { return EIGEN_CAT(VAR3,Ref_); } \
+        Eigen::Ref<vectorN_t> const & VAR3(void) const { return EIGEN_CAT(VAR3,Ref_); } \
          \
     protected: \
         Robot const * robot_; \
         Eigen::Ref<vectorN_t> EIGEN_CAT(VAR1,Ref_); \
         Eigen::Ref<vectorN_t> EIGEN_CAT(VAR2,Ref_); \
+        Eigen::Ref<vectorN_t> EIGEN_CAT(VAR3,Ref_); \
     }; \
      \
     class EIGEN_CAT(BASE,Vector) : public VectorContainer<EIGEN_CAT(BASE,Shared)> \
@@ -1096,59 +1172,68 @@ namespace Eigen
         EIGEN_CAT(BASE,Vector)(void) : \
         VectorContainer<EIGEN_CAT(BASE,Shared)>(), \
         VAR1(), \
-        VAR2() \
+        VAR2(), \
+        VAR3() \
         { \
             /* Empty on purpose */ \
         } \
          \
         explicit EIGEN_CAT(BASE,Vector)(std::vector<Robot const *> const & robots, \
                                         std::vector<vectorN_t> const & EIGEN_CAT(VAR1,In), \
-                                        std::vector<vectorN_t> const & EIGEN_CAT(VAR2,In)) : \
+                                        std::vector<vectorN_t> const & EIGEN_CAT(VAR2,In), \
+                                        std::vector<vectorN_t> const & EIGEN_CAT(VAR3,In)) : \
         VectorContainer<EIGEN_CAT(BASE,Shared)>(), \
         VAR1(EIGEN_CAT(VAR1,In)), \
-        VAR2(EIGEN_CAT(VAR2,In)) \
+        VAR2(EIGEN_CAT(VAR2,In)), \
+        VAR3(EIGEN_CAT(VAR3,In)) \
         { \
-            assert(VAR1.size() == robots.size() && VAR2.size() == robots.size()); \
+            assert(VAR1.size() == robots.size() && VAR2.size() == robots.size() && \
+                   VAR3.size() == robots.size()); \
             vector_.reserve(robots.size()); \
             for (std::size_t i = 0; i < robots.size(); ++i) \
             { \
-                vector_.emplace_back(robots[i], VAR1[i], VAR2[i]); \
+                vector_.emplace_back(robots[i], VAR1[i], VAR2[i], VAR3[i]); \
             } \
         } \
          \
         explicit EIGEN_CAT(BASE,Vector)(std::vector<Robot const *> const & robots) : \
         VectorContainer<EIGEN_CAT(BASE,Shared)>(), \
         VAR1(), \
-        VAR2() \
+        VAR2(), \
+        VAR3() \
         { \
             vector_.reserve(robots.size()); \
             VAR1.reserve(robots.size()); \
             VAR2.reserve(robots.size()); \
+            VAR3.reserve(robots.size()); \
             for (std::size_t i = 0; i < robots.size(); ++i) \
             { \
                 VAR1.emplace_back(robots[i]->SIZE1()); \
                 VAR2.emplace_back(robots[i]->SIZE2()); \
-                vector_.emplace_back(robots[i], VAR1[i], VAR2[i]); \
+                VAR3.emplace_back(robots[i]->SIZE3()); \
+                vector_.emplace_back(robots[i], VAR1[i], VAR2[i], VAR3[i]); \
             } \
         } \
          \
         EIGEN_CAT(BASE,Vector)(EIGEN_CAT(BASE,Vector) const & other) : \
         VectorContainer<EIGEN_CAT(BASE,Shared)>(), \
         VAR1(other.VAR1), \
-        VAR2(other.VAR2) \
+        VAR2(other.VAR2), \
+        VAR3(other.VAR3) \
         { \
             std::vector<ValueType> const & vectorIn = other.vector(); \
             vector_.reserve(vectorIn.size()); \
             for (std::size_t i = 0; i < vectorIn.size(); ++i) \
             { \
-                vector_.emplace_back(vectorIn[i].robot(), VAR1[i], VAR2[i]); \
+                vector_.emplace_back(vectorIn[i].robot(), VAR1[i], VAR2[i], VAR3[i]); \
             } \
         } \
          \
         EIGEN_CAT(BASE,Vector)(EIGEN_CAT(BASE,Vector) && other) : \
         VectorContainer<EIGEN_CAT(BASE,Shared)>(std::move(other.vector())), \
         VAR1(std::move(other.VAR1)), \
-        VAR2(std::move(other.VAR2)) \
+        VAR2(std::move(other.VAR2)), \
+        VAR3(std::move(other.VAR3)) \
         { \
             /* Empty on purpose */ \
         } \
@@ -1157,17 +1242,20 @@ namespace Eigen
         EIGEN_CAT(BASE,Vector)(VectorContainerBase<OtherDerived> const & other) : \
         VectorContainer<EIGEN_CAT(BASE,Shared)>(), \
         VAR1(), \
-        VAR2() \
+        VAR2(), \
+        VAR3() \
         { \
             std::vector<typename internal::traits<OtherDerived>::ValueType> const & vectorIn = other.vector(); \
             vector_.reserve(vectorIn.size()); \
             VAR1.reserve(vectorIn.size()); \
             VAR2.reserve(vectorIn.size()); \
+            VAR3.reserve(vectorIn.size()); \
             for (std::size_t i = 0; i < vectorIn.size(); ++i) \
             { \
                 VAR1.push_back(vectorIn[i].VAR1()); \
                 VAR2.push_back(vectorIn[i].VAR2()); \
-                vector_.emplace_back(vectorIn[i].robot(), VAR1[i], VAR2[i]); \
+                VAR3.push_back(vectorIn[i].VAR3()); \
+                vector_.emplace_back(vectorIn[i].robot(), VAR1[i], VAR2[i], VAR3[i]); \
             } \
         } \
          \
@@ -1175,16 +1263,19 @@ namespace Eigen
         EIGEN_CAT(BASE,Vector)(std::vector<OtherValueType> && vectorIn) : \
         VectorContainer<EIGEN_CAT(BASE,Shared)>(), \
         VAR1(), \
-        VAR2() \
+        VAR2(), \
+        VAR3() \
         { \
             vector_.reserve(vectorIn.size()); \
             VAR1.reserve(vectorIn.size()); \
             VAR2.reserve(vectorIn.size()); \
+            VAR3.reserve(vectorIn.size()); \
             for (std::size_t i = 0; i < vectorIn.size(); ++i) \
             { \
                 VAR1.push_back(std::move(vectorIn[i].VAR1())); \
                 VAR2.push_back(std::move(vectorIn[i].VAR2())); \
-                vector_.emplace_back(vectorIn[i].robot(), VAR1[i], VAR2[i]); \
+                VAR3.push_back(std::move(vectorIn[i].VAR3())); \
+                vector_.emplace_back(vectorIn[i].robot(), VAR1[i], VAR2[i], VAR3[i]); \
             } \
         } \
          \
@@ -1195,6 +1286,7 @@ namespace Eigen
             { \
                 container.VAR1[i].setOnes(); \
                 container.VAR2[i].setOnes(); \
+                container.VAR3[i].setOnes(); \
             } \
             return container; \
         } \
@@ -1206,6 +1298,7 @@ namespace Eigen
             { \
                 container.VAR1[i].setZero(); \
                 container.VAR2[i].setZero(); \
+                container.VAR3[i].setZero(); \
             } \
             return container; \
         } \
@@ -1220,6 +1313,7 @@ namespace Eigen
                 assert(vectorIn[i].robot() == vector_[i].robot()); \
                 VAR1[i] = vectorIn[i].VAR1(); \
                 VAR2[i] = vectorIn[i].VAR2(); \
+                VAR3[i] = vectorIn[i].VAR3(); \
             } \
             return *this; \
         } \
@@ -1233,6 +1327,7 @@ namespace Eigen
                 assert(vectorIn[i].robot() == vector_[i].robot()); \
                 VAR1[i] = other.VAR1[i]; \
                 VAR2[i] = other.VAR2[i]; \
+                VAR3[i] = other.VAR3[i]; \
             } \
             return *this; \
         } \
@@ -1241,6 +1336,7 @@ namespace Eigen
         { \
             VAR1 = std::move(other.VAR1); \
             VAR2 = std::move(other.VAR2); \
+            VAR3 = std::move(other.VAR3); \
             vector_ = std::move(other.vector()); \
             return *this; \
         } \
@@ -1249,6 +1345,7 @@ namespace Eigen
     public: \
         std::vector<vectorN_t> VAR1; \
         std::vector<vectorN_t> VAR2; \
+        std::vector<vectorN_t> VAR3; \
     };
 
     #define StateDerivative_SHARED_ADDON \
@@ -1338,8 +1435,8 @@ namespace Eigen
         return out; \
     }
 
-    GENERATE_SHARED_IMPL(StateDerivative,v,nv,a,nv)
-    GENERATE_SHARED_IMPL(State,q,nq,v,nv)
+    GENERATE_SHARED_IMPL(StateDerivative,v,nv,a,nv,ds,ns)
+    GENERATE_SHARED_IMPL(State,q,nq,v,nv,s,ns)
 
     #undef GENERATE_SHARED_IMPL
 }
@@ -41,6 +41,15 @@ namespace jiminy
                                            -92097.0 / 339200.0,
                                            187.0 / 2100.0,
                                            1.0 / 40.0).finished());
+        /* Coefficients of the 4th-order continuous extension from Shampine (1986),
+           which must be added to the cubic Hermite interpolation weights. */
+        vectorN_t const d((vectorN_t(7) << -12715105075.0 / 11282082432.0,
+                                           0.0,
+                                           87487479700.0 / 32700410799.0,
+                                           -10690763975.0 / 1880347072.0,
+                                           701980252875.0 / 199316789632.0,
+                                           -1453857185.0 / 822651844.0,
+                                           69997945.0 / 29380423.0).finished());
 
         // These parameters are from boost's stepper implementation.
         float64_t const STEPPER_ORDER = 5.0;  ///< Stepper order, used to scale the error.
@@ -72,6 +81,11 @@ namespace jiminy
                                       state_t   const & solution,
                                       float64_t       & dt) override final;
 
+            /// \brief Compute the weights of the 4th-order continuous extension of the last successful step.
+            virtual void computeDenseOutputWeights(float64_t const & ratio,
+                                                   vectorN_t       & weights,
+                                                   vectorN_t       & weightsDerivative) const override final;
+
         private:
             /// \brief Run error computation algorithm to return normalized error.
             /// \param[in] intialState Starting state, used to compute alternative estimates of the solution.
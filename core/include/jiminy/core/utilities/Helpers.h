@@ -126,6 +126,39 @@ namespace jiminy
     template<typename InputIt, typename UnaryFunction, typename ...Args>
     std::tuple<bool_t, float64_t> isGcdIncluded(InputIt first, InputIt last, UnaryFunction f, Args... values);
 
+    // ********************** Hashing utilities *********************
+
+    template<typename T>
+    std::enable_if_t<!is_eigen_v<T>, void>
+    hashCombine(std::size_t & seed, T const & value);
+
+    template<typename T>
+    std::enable_if_t<is_eigen_v<T>, void>
+    hashCombine(std::size_t & seed, T const & value);
+
+    // ********************* Versioning utilities *******************
+
+    /// \brief Get a new version number, greater than all the ones generated so far.
+    ///
+    /// \details Objects are stamped with a new version every time they are updated, so that
+    ///          anything derived from them can be detected as outdated without inspecting their
+    ///          content. The counter is shared by every object, so that an object is never
+    ///          mistaken for another one allocated at the same address.
+    std::size_t generateVersion(void);
+
+    // ******************* Configuration utilities ******************
+
+    /// \brief Get the option at a given path of a configuration, made of the names of the nested
+    ///        options separated by '/', e.g. "contacts/friction".
+    ///
+    /// \details It gives direct access to a single option, without copying the configuration.
+    hresult_t getConfigField(configHolder_t const   & config,
+                             std::string    const   & path,
+                             configField_t  const * & field);
+    hresult_t getConfigField(configHolder_t       & config,
+                             std::string    const & path,
+                             configField_t      * & field);
+
     // ********************* Std::vector helpers **********************
 
     template<typename T, typename A>
@@ -1,9 +1,29 @@
 #include <algorithm>
 #include <numeric>
 
+#include <boost/functional/hash.hpp>
+
 
 namespace jiminy
 {
+    // ************************** Hashing ***************************
+
+    template<typename T>
+    std::enable_if_t<!is_eigen_v<T>, void>
+    hashCombine(std::size_t & seed, T const & value)
+    {
+        boost::hash_combine(seed, value);
+    }
+
+    template<typename T>
+    std::enable_if_t<is_eigen_v<T>, void>
+    hashCombine(std::size_t & seed, T const & value)
+    {
+        boost::hash_combine(seed, value.rows());
+        boost::hash_combine(seed, value.cols());
+        boost::hash_range(seed, value.data(), value.data() + value.size());
+    }
+
     // *************************** Math *****************************
 
     template<typename T>
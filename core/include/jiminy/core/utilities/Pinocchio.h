@@ -101,21 +101,64 @@ namespace jiminy
                                                     frameIndex_t     const & frameIdx,
                                                     pinocchio::Force const & fextInGlobal);
 
+    /// \brief Build a geometry model from a URDF file.
+    ///
+    /// \param[in] nThreads Maximum number of threads loading the meshes and computing their
+    ///                     convex hull. 0 to use as many threads as supported by the hardware.
+    ///                     Optional: Single-threaded by default.
     hresult_t buildGeomFromUrdf(pinocchio::Model         const & model,
                                 std::string              const & filename,
                                 pinocchio::GeometryType  const & type,
                                 pinocchio::GeometryModel       & geomModel,
                                 std::vector<std::string> const & packageDirs,
                                 bool_t                   const & loadMeshes = true,
-                                bool_t                   const & makeConvexMeshes = false);
+                                bool_t                   const & makeConvexMeshes = false,
+                                uint32_t                 const & nThreads = 1U);
 
+    /// \brief Build the kinematic, collision and visual models of a robot from a URDF file.
+    ///
+    /// \details If a cache directory is specified, the models are stored in it once built, then
+    ///          loaded from it directly as long as the content of the URDF file, the options,
+    ///          the meshes and the versions of pinocchio, hpp-fcl and Boost have not changed. It
+    ///          avoids parsing the URDF file and loading the meshes and computing their convex
+    ///          hull at every initialization, which can take seconds. The cache is shared safely
+    ///          between concurrent processes, and its key does not depend on the platform.
+    ///
+    /// \param[in] cacheDir Directory of the cache. Optional: Disabled by default.
+    /// \param[in] nThreads Maximum number of threads loading the meshes, see `buildGeomFromUrdf`.
     hresult_t buildModelsFromUrdf(std::string const & urdfPath,
                                   bool_t const & hasFreeflyer,
                                   std::vector<std::string> const & meshPackageDirs,
                                   pinocchio::Model & pncModel,
                                   pinocchio::GeometryModel & collisionModel,
                                   std::optional<std::reference_wrapper<pinocchio::GeometryModel> > visualModel = std::nullopt,
-                                  bool_t const & loadVisualMeshes = false);
+                                  bool_t const & loadVisualMeshes = false,
+                                  std::string const & cacheDir = "",
+                                  uint32_t const & nThreads = 1U);
+
+    /// \brief Build only the visual model of a robot from the content of its URDF file, for a
+    ///        kinematic model built from it beforehand.
+    ///
+    /// \details It is cached separately from the other models, see `buildModelsFromUrdf`. Frames
+    ///          appended to the kinematic model afterward do not matter, since they do not alter
+    ///          the indices of the frames of the URDF file.
+    ///
+    /// \param[in] hasFreeflyer Whether the kinematic model has been built with a freeflyer.
+    hresult_t buildVisualModelFromUrdf(std::string const & urdfData,
+                                       bool_t const & hasFreeflyer,
+                                       std::vector<std::string> const & meshPackageDirs,
+                                       pinocchio::Model const & pncModel,
+                                       pinocchio::GeometryModel & visualModel,
+                                       bool_t const & loadVisualMeshes = false,
+                                       std::string const & cacheDir = "",
+                                       uint32_t const & nThreads = 1U);
+
+    /// \brief Hash of the kinematic and dynamic properties of a model, including the axis of
+    ///        the unaligned joints.
+    ///
+    /// \details It is much cheaper to compute than serializing the model, so it can be used to
+    ///          detect whether a model has changed since the last time it was serialized.
+    std::size_t hashModel(pinocchio::Model const & model);
 }
 
 #endif  // JIMINY_PINOCCHIO_H
@@ -1,6 +1,8 @@
 #ifndef JIMINY_RANDOM_H
 #define JIMINY_RANDOM_H
 
+#include <random>
+
 #include "jiminy/core/Macros.h"
 #include "jiminy/core/Types.h"
 
@@ -13,6 +15,11 @@ namespace jiminy
 
     hresult_t getRandomSeed(uint32_t & seed);
 
+    /// \brief Internal state of the global random number generator, which can be restored
+    ///        later on to replay the exact same sequence of random numbers.
+    std::mt19937 const & getRandomGenerator(void);
+    void setRandomGenerator(std::mt19937 const & generator);
+
     float64_t randUniform(float64_t const & lo = 0.0,
                           float64_t const & hi = 1.0);
 
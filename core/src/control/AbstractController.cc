@@ -1,6 +1,7 @@
 #include "pinocchio/algorithm/joint-configuration.hpp"  // pinocchio::neutral
 
 #include "jiminy/core/robot/Robot.h"
+#include "jiminy/core/utilities/Helpers.h"
 #include "jiminy/core/Constants.h"
 
 #include "jiminy/core/control/AbstractController.h"
@@ -14,7 +15,9 @@ namespace jiminy
     sensorsData_(),
     isInitialized_(false),
     isTelemetryConfigured_(false),
+    hasInternalDynamics_(true),
     ctrlOptionsHolder_(),
+    optionsVersion_(0U),
     telemetrySender_(),
     registeredVariables_(),
     registeredConstants_()
@@ -49,8 +52,16 @@ namespace jiminy
            'reset', 'computeCommand' and 'internalDynamics' methods. */
         isInitialized_ = true;
 
-        // Reset the controller completely
-        reset(true);  // It cannot fail at this point
+        /* Reset the controller completely. It may fail for controllers
+           loading resources depending on their options, e.g. plugins. */
+        hresult_t returnCode = reset(true);
+        if (returnCode != hresult_t::SUCCESS)
+        {
+            isInitialized_ = false;
+            robot_.reset();
+            sensorsData_.clear();
+            return returnCode;
+        }
 
         try
         {
@@ -59,7 +70,7 @@ namespace jiminy
             vectorN_t v = vectorN_t::Zero(robot->nv());
             vectorN_t command = vectorN_t::Zero(robot->getMotorsNames().size());
             vectorN_t uCustom = vectorN_t::Zero(robot->nv());
-            hresult_t returnCode = computeCommand(t, q, v, command);
+            returnCode = computeCommand(t, q, v, command);
             if (returnCode == hresult_t::SUCCESS)
             {
                 if (static_cast<std::size_t>(command.size()) != robot->getMotorsNames().size())
@@ -68,11 +79,14 @@ namespace jiminy
                     return hresult_t::ERROR_BAD_INPUT;
                 }
 
-                internalDynamics(t, q, v, uCustom);
-                if (uCustom.size() != robot->nv())
+                if (hasInternalDynamics_)
                 {
-                    PRINT_ERROR("'internalDynamics' returns command with wrong size.");
-                    return hresult_t::ERROR_BAD_INPUT;
+                    internalDynamics(t, q, v, uCustom);
+                    if (uCustom.size() != robot->nv())
+                    {
+                        PRINT_ERROR("'internalDynamics' returns command with wrong size.");
+                        return hresult_t::ERROR_BAD_INPUT;
+                    }
                 }
             }
             return returnCode;
@@ -122,6 +136,23 @@ namespace jiminy
         return hresult_t::SUCCESS;
     }
 
+    hresult_t AbstractController::saveState(vectorN_t & state) const
+    {
+        state.resize(0);
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t AbstractController::restoreState(vectorN_t const & state)
+    {
+        if (state.size() != 0)
+        {
+            PRINT_ERROR("The controller has no internal state.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
     hresult_t AbstractController::configureTelemetry(std::shared_ptr<TelemetryData> telemetryData,
                                                      std::string const & objectPrefixName)
     {
@@ -256,10 +287,16 @@ namespace jiminy
         return ctrlOptionsHolder_;
     }
 
+    std::size_t const & AbstractController::getOptionsVersion(void) const
+    {
+        return optionsVersion_;
+    }
+
     void AbstractController::setOptions(configHolder_t const & ctrlOptions)
     {
         ctrlOptionsHolder_ = ctrlOptions;
         baseControllerOptions_ = std::make_unique<controllerOptions_t const>(ctrlOptionsHolder_);
+        optionsVersion_ = generateVersion();
     }
 
     bool_t const & AbstractController::getIsInitialized(void) const
@@ -271,4 +308,9 @@ namespace jiminy
     {
         return isTelemetryConfigured_;
     }
+
+    bool_t const & AbstractController::getHasInternalDynamics(void) const
+    {
+        return hasInternalDynamics_;
+    }
 }
@@ -0,0 +1,262 @@
+#include <type_traits>
+
+#include "jiminy/core/robot/Robot.h"
+
+#include "jiminy/core/control/ControllerPlugin.h"
+
+
+namespace jiminy
+{
+    ControllerPlugin::ControllerPlugin(void) :
+    AbstractController(),
+    controllerOptions_(nullptr),
+    library_(),
+    plugin_(nullptr),
+    instance_(nullptr),
+    context_(),
+    sensorsDataFlat_(nullptr),
+    isPluginStale_(true)
+    {
+        /* AbstractController constructor calls the base implementations of
+           the virtual methods since the derived class is not available at
+           this point. Thus it must be called explicitly in the constructor. */
+        setOptions(getDefaultControllerOptions());
+    }
+
+    ControllerPlugin::~ControllerPlugin(void)
+    {
+        // The instance must be destroyed before unloading the library that implements it
+        unloadPlugin();
+    }
+
+    void ControllerPlugin::setOptions(configHolder_t const & ctrlOptions)
+    {
+        AbstractController::setOptions(ctrlOptions);
+        controllerOptions_ = std::make_unique<controllerPluginOptions_t const>(ctrlOptions);
+        isPluginStale_ = true;
+    }
+
+    void ControllerPlugin::unloadPlugin(void)
+    {
+        if (instance_)
+        {
+            plugin_->destroy(instance_);
+            instance_ = nullptr;
+        }
+        plugin_ = nullptr;
+        library_.unload();
+        hasInternalDynamics_ = true;
+    }
+
+    hresult_t ControllerPlugin::loadPlugin(Robot const & robot)
+    {
+        unloadPlugin();
+
+        if (controllerOptions_->libraryPath.empty())
+        {
+            PRINT_ERROR("Option 'libraryPath' must be specified.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Load the library and get the descriptor of the plugin
+        try
+        {
+            /* Look for the library in system folders if it cannot be found as is,
+               and add the platform-specific prefix and extension if necessary. */
+            library_.load(controllerOptions_->libraryPath,
+                          boost::dll::load_mode::append_decorations |
+                          boost::dll::load_mode::search_system_folders);
+            if (!library_.has(controllerOptions_->entryPoint))
+            {
+                PRINT_ERROR("Entry point '", controllerOptions_->entryPoint, "' not found in library '",
+                            controllerOptions_->libraryPath, "'.");
+                library_.unload();
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            plugin_ = library_.get<std::remove_pointer_t<jiminy_controller_plugin_entry_t> >(
+                controllerOptions_->entryPoint)();
+        }
+        catch (std::exception const & e)
+        {
+            PRINT_ERROR("Impossible to load library '", controllerOptions_->libraryPath, "'.\n"
+                        "Raised from exception: ", e.what());
+            plugin_ = nullptr;
+            library_.unload();
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Make sure the plugin is compatible
+        if (!plugin_)
+        {
+            PRINT_ERROR("Entry point '", controllerOptions_->entryPoint, "' returned no plugin.");
+            unloadPlugin();
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        if (plugin_->abiVersion != JIMINY_CONTROLLER_PLUGIN_ABI_VERSION)
+        {
+            PRINT_ERROR("Plugin ABI version ", plugin_->abiVersion, " is not supported. Version ",
+                        JIMINY_CONTROLLER_PLUGIN_ABI_VERSION, " is expected.");
+            unloadPlugin();
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        if (!plugin_->create || !plugin_->destroy || !plugin_->computeCommand)
+        {
+            PRINT_ERROR("'create', 'destroy' and 'computeCommand' must be implemented by the plugin.");
+            unloadPlugin();
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        if (plugin_->stateSize && (!plugin_->saveState || !plugin_->restoreState))
+        {
+            PRINT_ERROR("'saveState' and 'restoreState' must be implemented by the plugin along with 'stateSize'.");
+            unloadPlugin();
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Create a new instance of the plugin for the current robot
+        context_.nq = static_cast<uint64_t>(robot.nq());
+        context_.nv = static_cast<uint64_t>(robot.nv());
+        context_.nmotors = robot.nmotors();
+        context_.nsensorsData = static_cast<uint64_t>(robot.getSensorsDataFlat().size());
+        context_.config = controllerOptions_->config.c_str();
+        instance_ = plugin_->create(&context_);
+        if (!instance_)
+        {
+            PRINT_ERROR("Impossible to create an instance of the plugin.");
+            unloadPlugin();
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // The engine can skip the internal dynamics if the plugin does not implement it
+        hasInternalDynamics_ = (plugin_->internalDynamics != nullptr);
+        isPluginStale_ = false;
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t ControllerPlugin::reset(bool_t const & resetDynamicTelemetry)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        returnCode = AbstractController::reset(resetDynamicTelemetry);
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            auto robot = robot_.lock();  // It is guaranteed to be valid at this point
+            vectorN_t const & sensorsDataFlat = robot->getSensorsDataFlat();
+
+            // Reload the plugin if the options or the dimensions of the robot have changed
+            if (isPluginStale_ || !instance_
+             || context_.nq != static_cast<uint64_t>(robot->nq())
+             || context_.nv != static_cast<uint64_t>(robot->nv())
+             || context_.nmotors != robot->nmotors()
+             || context_.nsensorsData != static_cast<uint64_t>(sensorsDataFlat.size()))
+            {
+                returnCode = loadPlugin(*robot);
+            }
+            else if (plugin_->reset && plugin_->reset(instance_) != 0)
+            {
+                PRINT_ERROR("Impossible to reset the plugin.");
+                returnCode = hresult_t::ERROR_GENERIC;
+            }
+
+            /* Backup the sensor data buffer. Its memory is only reallocated when
+               sensors are attached or detached, which requires a reset anyway. */
+            sensorsDataFlat_ = &sensorsDataFlat;
+        }
+
+        return returnCode;
+    }
+
+    hresult_t ControllerPlugin::saveState(vectorN_t & state) const
+    {
+        if (!getIsInitialized() || !instance_)
+        {
+            PRINT_ERROR("The controller is not initialized.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (!plugin_->stateSize)
+        {
+            state.resize(0);
+            return hresult_t::SUCCESS;
+        }
+
+        state.resize(static_cast<Eigen::Index>(plugin_->stateSize(instance_)));
+        if (plugin_->saveState(instance_, state.data()) != 0)
+        {
+            PRINT_ERROR("The plugin failed to save its internal state.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t ControllerPlugin::restoreState(vectorN_t const & state)
+    {
+        if (!getIsInitialized() || !instance_)
+        {
+            PRINT_ERROR("The controller is not initialized.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (!plugin_->stateSize)
+        {
+            return AbstractController::restoreState(state);
+        }
+
+        if (static_cast<uint64_t>(state.size()) != plugin_->stateSize(instance_))
+        {
+            PRINT_ERROR("The size of the state is not consistent with the plugin.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        if (plugin_->restoreState(instance_, state.data()) != 0)
+        {
+            PRINT_ERROR("The plugin failed to restore its internal state.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t ControllerPlugin::computeCommand(float64_t const & t,
+                                               vectorN_t const & q,
+                                               vectorN_t const & v,
+                                               vectorN_t       & command)
+    {
+        if (!getIsInitialized() || !instance_)
+        {
+            PRINT_ERROR("The controller is not initialized.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (plugin_->computeCommand(instance_, t, q.data(), v.data(),
+                                    sensorsDataFlat_->data(), command.data()) != 0)
+        {
+            PRINT_ERROR("The plugin failed to compute the command.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t ControllerPlugin::internalDynamics(float64_t const & t,
+                                                 vectorN_t const & q,
+                                                 vectorN_t const & v,
+                                                 vectorN_t       & uCustom)
+    {
+        if (!getIsInitialized() || !instance_)
+        {
+            PRINT_ERROR("The controller is not initialized.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (plugin_->internalDynamics && plugin_->internalDynamics(
+                instance_, t, q.data(), v.data(), sensorsDataFlat_->data(), uCustom.data()) != 0)
+        {
+            PRINT_ERROR("The plugin failed to compute the internal dynamics.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+}
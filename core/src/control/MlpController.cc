@@ -0,0 +1,377 @@
+#include <fstream>
+#include <cstring>
+
+#include "jiminy/core/robot/Robot.h"
+
+#include "jiminy/core/control/MlpController.h"
+
+
+namespace jiminy
+{
+    namespace
+    {
+        char_t const MLP_FILE_MAGIC[4] = {'J', 'M', 'L', 'P'};
+        uint32_t const MLP_FILE_VERSION = 1U;
+    }
+
+    MlpController::MlpController(void) :
+    AbstractController(),
+    controllerOptions_(nullptr),
+    weights_(),
+    biases_(),
+    activations_(),
+    input_(),
+    activation_(activation_t::TANH),
+    sensorsDataFlat_(nullptr),
+    isNetworkStale_(true)
+    {
+        /* AbstractController constructor calls the base implementations of
+           the virtual methods since the derived class is not available at
+           this point. Thus it must be called explicitly in the constructor. */
+        setOptions(getDefaultControllerOptions());
+
+        // A feed-forward network has no internal dynamics
+        hasInternalDynamics_ = false;
+    }
+
+    void MlpController::setOptions(configHolder_t const & ctrlOptions)
+    {
+        AbstractController::setOptions(ctrlOptions);
+        controllerOptions_ = std::make_unique<controllerMlpOptions_t const>(ctrlOptions);
+        isNetworkStale_ = true;
+    }
+
+    hresult_t MlpController::saveNetwork(std::string            const & filename,
+                                         std::vector<matrixN_t> const & weights,
+                                         std::vector<vectorN_t> const & biases)
+    {
+        if (weights.size() != biases.size())
+        {
+            PRINT_ERROR("The network must have as many biases as weights.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            if (biases[i].size() != weights[i].rows())
+            {
+                PRINT_ERROR("The dimensions of the layers of the network are inconsistent.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        std::ofstream file = std::ofstream(filename,
+                                           std::ios::out |
+                                           std::ofstream::binary |
+                                           std::ofstream::trunc);
+        if (!file.is_open())
+        {
+            PRINT_ERROR("Impossible to open file '", filename, "'.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Write the header
+        uint32_t const nLayers = static_cast<uint32_t>(weights.size());
+        file.write(MLP_FILE_MAGIC, sizeof(MLP_FILE_MAGIC));
+        file.write(reinterpret_cast<char_t const *>(&MLP_FILE_VERSION), sizeof(uint32_t));
+        file.write(reinterpret_cast<char_t const *>(&nLayers), sizeof(uint32_t));
+
+        // Write the parameters of every layer, the weights being converted to row-major order
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            uint32_t const nOut = static_cast<uint32_t>(weights[i].rows());
+            uint32_t const nIn = static_cast<uint32_t>(weights[i].cols());
+            matrixRowMajorN_t const weight = weights[i];
+            file.write(reinterpret_cast<char_t const *>(&nOut), sizeof(uint32_t));
+            file.write(reinterpret_cast<char_t const *>(&nIn), sizeof(uint32_t));
+            file.write(reinterpret_cast<char_t const *>(weight.data()), weight.size() * sizeof(float64_t));
+            file.write(reinterpret_cast<char_t const *>(biases[i].data()), biases[i].size() * sizeof(float64_t));
+        }
+
+        file.close();
+        if (!file.good())
+        {
+            PRINT_ERROR("Impossible to write file '", filename, "'.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t MlpController::loadNetwork(std::vector<matrixRowMajorN_t> & weights,
+                                         std::vector<vectorN_t>         & biases) const
+    {
+        std::string const & filename = controllerOptions_->weightsPath;
+        std::ifstream file = std::ifstream(filename,
+                                           std::ios::in |
+                                           std::ifstream::binary |
+                                           std::ifstream::ate);
+        if (!file.is_open())
+        {
+            PRINT_ERROR("Impossible to open file '", filename, "'.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        std::streamoff const fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        // Check the header
+        char_t magic[4];
+        uint32_t version;
+        uint32_t nLayers;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char_t *>(&version), sizeof(uint32_t));
+        file.read(reinterpret_cast<char_t *>(&nLayers), sizeof(uint32_t));
+        if (!file.good() || std::memcmp(magic, MLP_FILE_MAGIC, sizeof(magic)) != 0)
+        {
+            PRINT_ERROR("File '", filename, "' is not a valid network file.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        if (version != MLP_FILE_VERSION)
+        {
+            PRINT_ERROR("Network file version ", version, " is not supported. Version ",
+                        MLP_FILE_VERSION, " is expected.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Read the parameters of every layer
+        weights.clear();
+        biases.clear();
+        for (uint32_t i = 0; i < nLayers; ++i)
+        {
+            uint32_t nOut, nIn;
+            file.read(reinterpret_cast<char_t *>(&nOut), sizeof(uint32_t));
+            file.read(reinterpret_cast<char_t *>(&nIn), sizeof(uint32_t));
+            if (!file.good())
+            {
+                PRINT_ERROR("Corrupted network file.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+
+            /* Make sure that the remaining data is large enough before allocating anything,
+               since corrupted dimensions could require an arbitrary amount of memory. */
+            uint64_t const nParams = static_cast<uint64_t>(nOut) * (static_cast<uint64_t>(nIn) + 1U);
+            uint64_t const nBytesLeft = static_cast<uint64_t>(fileSize - file.tellg());
+            if (nOut == 0U || nIn == 0U || nParams > nBytesLeft / sizeof(float64_t))
+            {
+                PRINT_ERROR("Corrupted network file. The dimensions of layer ", i, " (", nOut, ", ",
+                            nIn, ") are inconsistent with the size of the file.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+
+            // The weights are stored in row-major order in the file, as in memory
+            matrixRowMajorN_t & weight = weights.emplace_back(nOut, nIn);
+            vectorN_t & bias = biases.emplace_back(nOut);
+            file.read(reinterpret_cast<char_t *>(weight.data()), weight.size() * sizeof(float64_t));
+            file.read(reinterpret_cast<char_t *>(bias.data()), bias.size() * sizeof(float64_t));
+            if (!file.good())
+            {
+                PRINT_ERROR("Corrupted network file.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        // Make sure that the whole file has been read
+        if (file.tellg() != fileSize)
+        {
+            PRINT_ERROR("Corrupted network file. Unexpected data after the last layer.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t MlpController::reset(bool_t const & resetDynamicTelemetry)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        returnCode = AbstractController::reset(resetDynamicTelemetry);
+
+        // Load the network if the options have changed
+        if (returnCode == hresult_t::SUCCESS && isNetworkStale_)
+        {
+            std::string const & activation = controllerOptions_->activation;
+            if (activation == "tanh")
+            {
+                activation_ = activation_t::TANH;
+            }
+            else if (activation == "relu")
+            {
+                activation_ = activation_t::RELU;
+            }
+            else if (activation == "identity")
+            {
+                activation_ = activation_t::IDENTITY;
+            }
+            else
+            {
+                PRINT_ERROR("Activation '", activation, "' not recognized. It must be either 'tanh', 'relu' or 'identity'.");
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+
+            std::vector<matrixRowMajorN_t> weights;
+            std::vector<vectorN_t> biases;
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                if (!controllerOptions_->weightsPath.empty())
+                {
+                    returnCode = loadNetwork(weights, biases);
+                }
+                else
+                {
+                    weights.assign(controllerOptions_->weights.begin(),
+                                   controllerOptions_->weights.end());
+                    biases = controllerOptions_->biases;
+                }
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                if (weights.empty() || weights.size() != biases.size())
+                {
+                    PRINT_ERROR("The network must have at least one layer, and as many biases as weights.");
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                }
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                for (std::size_t i = 0; i < weights.size(); ++i)
+                {
+                    if (biases[i].size() != weights[i].rows() ||
+                        (i > 0 && weights[i].cols() != weights[i - 1].rows()))
+                    {
+                        PRINT_ERROR("The dimensions of the layers of the network are inconsistent.");
+                        returnCode = hresult_t::ERROR_BAD_INPUT;
+                        break;
+                    }
+                }
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                weights_ = std::move(weights);
+                biases_ = std::move(biases);
+                activations_.clear();
+                for (vectorN_t const & bias : biases_)
+                {
+                    activations_.emplace_back(bias.size());
+                }
+                isNetworkStale_ = false;
+            }
+        }
+
+        // Make sure the network is consistent with the robot, which may have changed
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            auto robot = robot_.lock();  // It is guaranteed to be valid at this point
+            vectorN_t const & sensorsDataFlat = robot->getSensorsDataFlat();
+            Eigen::Index const nInputs = weights_.front().cols();
+            Eigen::Index const nOutputs = weights_.back().rows();
+            if (nInputs != sensorsDataFlat.size())
+            {
+                PRINT_ERROR("The input size of the network (", nInputs, ") does not match the "
+                            "size of the sensor data (", sensorsDataFlat.size(), ").");
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+            else if (static_cast<uint64_t>(nOutputs) != robot->nmotors())
+            {
+                PRINT_ERROR("The output size of the network (", nOutputs, ") does not match the "
+                            "number of motors (", robot->nmotors(), ").");
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+            else if ((controllerOptions_->inputOffset.size() > 0 &&
+                      controllerOptions_->inputOffset.size() != nInputs) ||
+                     (controllerOptions_->inputScale.size() > 0 &&
+                      controllerOptions_->inputScale.size() != nInputs) ||
+                     (controllerOptions_->outputScale.size() > 0 &&
+                      controllerOptions_->outputScale.size() != nOutputs))
+            {
+                PRINT_ERROR("'inputOffset', 'inputScale' and 'outputScale' must be either empty "
+                            "or consistent with the dimensions of the network.");
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+            else
+            {
+                input_.resize(nInputs);
+
+                /* Backup the sensor data buffer. Its memory is only reallocated when
+                   sensors are attached or detached, which requires a reset anyway. */
+                sensorsDataFlat_ = &sensorsDataFlat;
+            }
+        }
+
+        if (returnCode != hresult_t::SUCCESS)
+        {
+            sensorsDataFlat_ = nullptr;
+        }
+
+        return returnCode;
+    }
+
+    hresult_t MlpController::computeCommand(float64_t const & /* t */,
+                                            vectorN_t const & /* q */,
+                                            vectorN_t const & /* v */,
+                                            vectorN_t       & command)
+    {
+        if (!getIsInitialized() || !sensorsDataFlat_)
+        {
+            PRINT_ERROR("The controller is not initialized.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // Normalize the input
+        input_ = *sensorsDataFlat_;
+        if (controllerOptions_->inputOffset.size() > 0)
+        {
+            input_ -= controllerOptions_->inputOffset;
+        }
+        if (controllerOptions_->inputScale.size() > 0)
+        {
+            input_.array() *= controllerOptions_->inputScale.array();
+        }
+
+        // Forward pass through the network, without any memory allocation
+        vectorN_t const * layerInput = &input_;
+        for (std::size_t i = 0; i < weights_.size(); ++i)
+        {
+            vectorN_t & layerOutput = activations_[i];
+            layerOutput.noalias() = weights_[i] * (*layerInput);
+            layerOutput += biases_[i];
+            if (i + 1 < weights_.size())
+            {
+                switch (activation_)
+                {
+                case activation_t::TANH:
+                    layerOutput.array() = layerOutput.array().tanh();
+                    break;
+                case activation_t::RELU:
+                    layerOutput.array() = layerOutput.array().max(0.0);
+                    break;
+                case activation_t::IDENTITY:
+                default:
+                    break;
+                }
+            }
+            layerInput = &layerOutput;
+        }
+
+        // Scale the output
+        if (controllerOptions_->outputScale.size() > 0)
+        {
+            command.array() = layerInput->array() * controllerOptions_->outputScale.array();
+        }
+        else
+        {
+            command = *layerInput;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t MlpController::internalDynamics(float64_t const & /* t */,
+                                              vectorN_t const & /* q */,
+                                              vectorN_t const & /* v */,
+                                              vectorN_t       & /* uCustom */)
+    {
+        return hresult_t::SUCCESS;  // No internal dynamics
+    }
+}
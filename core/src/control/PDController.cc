@@ -0,0 +1,224 @@
+#include "jiminy/core/robot/BasicSensors.h"
+#include "jiminy/core/robot/AbstractMotor.h"
+#include "jiminy/core/robot/Robot.h"
+
+#include "jiminy/core/control/PDController.h"
+
+
+namespace jiminy
+{
+    PDController::PDController(void) :
+    AbstractController(),
+    controllerOptions_(nullptr),
+    kp_(),
+    kd_(),
+    qTarget_(),
+    vTarget_(),
+    uTarget_(),
+    encodersIdx_(),
+    sensorsDataFlat_(nullptr)
+    {
+        /* AbstractController constructor calls the base implementations of
+           the virtual methods since the derived class is not available at
+           this point. Thus it must be called explicitly in the constructor. */
+        setOptions(getDefaultControllerOptions());
+
+        // The control law has no internal dynamics
+        hasInternalDynamics_ = false;
+    }
+
+    void PDController::setOptions(configHolder_t const & ctrlOptions)
+    {
+        AbstractController::setOptions(ctrlOptions);
+        controllerOptions_ = std::make_unique<controllerPDOptions_t const>(ctrlOptions);
+    }
+
+    hresult_t PDController::reset(bool_t const & resetDynamicTelemetry)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        returnCode = AbstractController::reset(resetDynamicTelemetry);
+
+        auto robot = robot_.lock();
+        Eigen::Index const nmotors = static_cast<Eigen::Index>(robot ? robot->nmotors() : 0U);
+
+        // Broadcast the gains over every motor
+        auto broadcastGain = [&returnCode, &nmotors](vectorN_t const & gainIn,
+                                                     std::string const & gainName,
+                                                     vectorN_t & gain)
+        {
+            if (gainIn.size() == 1)
+            {
+                gain.setConstant(nmotors, gainIn[0]);
+            }
+            else if (gainIn.size() == nmotors)
+            {
+                gain = gainIn;
+            }
+            else
+            {
+                PRINT_ERROR("'", gainName, "' must have a single element or one per motor.");
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+        };
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            broadcastGain(controllerOptions_->kp, "kp", kp_);
+        }
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            broadcastGain(controllerOptions_->kd, "kd", kd_);
+        }
+
+        // Map every motor to the encoder attached to the same joint
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            encodersIdx_.resize(static_cast<std::size_t>(nmotors));
+            auto const & sensors = robot->getSensors();
+            auto encodersIt = sensors.find(EncoderSensor::type_);
+            auto const & sensorsDataOffsets = robot->getSensorsDataOffsets();
+            for (auto const & motor : robot->getMotors())
+            {
+                bool_t isEncoderFound = false;
+                if (encodersIt != sensors.end())
+                {
+                    for (auto const & sensor : encodersIt->second)
+                    {
+                        auto const & encoder = static_cast<EncoderSensor const &>(*sensor);
+                        if (encoder.getJointName() == motor->getJointName())
+                        {
+                            encodersIdx_[motor->getIdx()] =
+                                sensorsDataOffsets.at(EncoderSensor::type_).at(encoder.getName());
+                            isEncoderFound = true;
+                            break;
+                        }
+                    }
+                }
+                if (!isEncoderFound)
+                {
+                    PRINT_ERROR("No encoder sensor associated with motor '", motor->getName(), "'. "
+                                "Every actuated joint must have an encoder sensor attached.");
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                    break;
+                }
+            }
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            /* Reset the targets. Note that 'setZero' only reallocates memory if
+               the size changes, so that references to them remain valid. */
+            qTarget_.setZero(nmotors);
+            vTarget_.setZero(nmotors);
+            uTarget_.setZero(nmotors);
+
+            /* Backup the sensor data buffer. Its memory is only reallocated when
+               sensors are attached or detached, which requires a reset anyway. */
+            sensorsDataFlat_ = &robot->getSensorsDataFlat();
+        }
+        else
+        {
+            sensorsDataFlat_ = nullptr;
+        }
+
+        return returnCode;
+    }
+
+    hresult_t PDController::setTarget(vectorN_t const & qTarget,
+                                      vectorN_t const & vTarget,
+                                      vectorN_t const & uTarget)
+    {
+        if (qTarget.size() != qTarget_.size() || vTarget.size() != vTarget_.size() ||
+            (uTarget.size() > 0 && uTarget.size() != uTarget_.size()))
+        {
+            PRINT_ERROR("The targets must have one element per motor.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        qTarget_ = qTarget;
+        vTarget_ = vTarget;
+        if (uTarget.size() > 0)
+        {
+            uTarget_ = uTarget;
+        }
+        else
+        {
+            uTarget_.setZero();
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t PDController::saveState(vectorN_t & state) const
+    {
+        Eigen::Index const nmotors = qTarget_.size();
+        state.resize(3 * nmotors);
+        state.segment(0, nmotors) = qTarget_;
+        state.segment(nmotors, nmotors) = vTarget_;
+        state.segment(2 * nmotors, nmotors) = uTarget_;
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t PDController::restoreState(vectorN_t const & state)
+    {
+        Eigen::Index const nmotors = qTarget_.size();
+        if (state.size() != 3 * nmotors)
+        {
+            PRINT_ERROR("The state must have three elements per motor.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        qTarget_ = state.segment(0, nmotors);
+        vTarget_ = state.segment(nmotors, nmotors);
+        uTarget_ = state.segment(2 * nmotors, nmotors);
+
+        return hresult_t::SUCCESS;
+    }
+
+    vectorN_t & PDController::getPositionTarget(void)
+    {
+        return qTarget_;
+    }
+
+    vectorN_t & PDController::getVelocityTarget(void)
+    {
+        return vTarget_;
+    }
+
+    vectorN_t & PDController::getEffortTarget(void)
+    {
+        return uTarget_;
+    }
+
+    hresult_t PDController::computeCommand(float64_t const & /* t */,
+                                           vectorN_t const & /* q */,
+                                           vectorN_t const & /* v */,
+                                           vectorN_t       & command)
+    {
+        if (!getIsInitialized() || !sensorsDataFlat_)
+        {
+            PRINT_ERROR("The controller is not initialized.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // Compute the PD command from the encoder measurements of each motor
+        vectorN_t const & sensorsDataFlat = *sensorsDataFlat_;
+        for (std::size_t i = 0; i < encodersIdx_.size(); ++i)
+        {
+            Eigen::Index const & encoderIdx = encodersIdx_[i];
+            float64_t const qError = sensorsDataFlat[encoderIdx] - qTarget_[i];
+            float64_t const vError = sensorsDataFlat[encoderIdx + 1] - vTarget_[i];
+            command[i] = - kp_[i] * (qError + kd_[i] * vError) + uTarget_[i];
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t PDController::internalDynamics(float64_t const & /* t */,
+                                             vectorN_t const & /* q */,
+                                             vectorN_t const & /* v */,
+                                             vectorN_t       & /* uCustom */)
+    {
+        return hresult_t::SUCCESS;  // No internal dynamics
+    }
+}
@@ -1,7 +1,9 @@
 #include <cmath>
 #include <ctime>
 #include <unordered_set>
+#include <array>
 #include <algorithm>
+#include <numeric>
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -17,10 +19,9 @@
 #include "pinocchio/multibody/visitor.hpp"                  // `pinocchio::fusion::JointUnaryVisitorBase`
 #include "pinocchio/multibody/joint/joint-model-base.hpp"   // `pinocchio::JointModelBase`
 #include "pinocchio/algorithm/center-of-mass.hpp"           // `pinocchio::getComFromCrba`
-#include "pinocchio/algorithm/frames.hpp"                   // `pinocchio::getFrameVelocity`
-#include "pinocchio/algorithm/jacobian.hpp"                 // `pinocchio::getJointJacobian`
+#include "pinocchio/algorithm/frames.hpp"                   // `pinocchio::getFrameVelocity`, `pinocchio::updateFramePlacements`
 #include "pinocchio/algorithm/energy.hpp"                   // `pinocchio::computePotentialEnergy`
-#include "pinocchio/algorithm/joint-configuration.hpp"      // `pinocchio::normalize`
+#include "pinocchio/algorithm/joint-configuration.hpp"      // `pinocchio::normalize`, `pinocchio::integrate`, `pinocchio::difference`
 #include "pinocchio/algorithm/geometry.hpp"                 // `pinocchio::computeCollisions`
 
 #include "H5Cpp.h"
@@ -54,20 +55,32 @@
 
 namespace jiminy
 {
+    template<typename ...Args>
+    std::tuple<bool_t, float64_t> isGcdIncluded(vector_aligned_t<systemDataHolder_t> const & systemsDataHolder,
+                                                Args... values);
+
     EngineMultiRobot::EngineMultiRobot(void):
     engineOptions_(nullptr),
     systems_(),
     isTelemetryConfigured_(false),
     isSimulationRunning_(false),
     engineOptionsHolder_(),
+    optionsVersion_(0U),
     timer_(std::make_unique<Timer>()),
     contactModel_(contactModel_t::NONE),
     telemetrySender_(),
     telemetryData_(nullptr),
+    telemetryConstantsCache_(),
     telemetryRecorder_(nullptr),
     stepper_(),
     stepperUpdatePeriod_(INF),
+    stepperBreakpointPeriod_(INF),
     stepperState_(),
+    qSplitInterp_(),
+    vSplitInterp_(),
+    sSplitInterp_(),
+    aSplitInterp_(),
+    dsSplitInterp_(),
     systemsDataHolder_(),
     forcesCoupling_(),
     fPrev_(),
@@ -145,6 +158,7 @@ namespace jiminy
                               controller,
                               std::move(callbackFct));
         systemsDataHolder_.resize(systems_.size());
+        optionsVersion_ = generateVersion();
 
         return hresult_t::SUCCESS;
     }
@@ -244,6 +258,7 @@ namespace jiminy
             // Remove the system from the list
             systems_.erase(systems_.begin() + systemIdx);
             systemsDataHolder_.erase(systemsDataHolder_.begin() + systemIdx);
+            optionsVersion_ = generateVersion();
         }
 
         return returnCode;
@@ -301,6 +316,7 @@ namespace jiminy
         if (returnCode == hresult_t::SUCCESS)
         {
             system->controller = controller;
+            optionsVersion_ = generateVersion();
         }
 
         return returnCode;
@@ -894,9 +910,11 @@ namespace jiminy
         telemetryRecorder_->flushDataSnapshot(stepperState_.t);
     }
 
-    void EngineMultiRobot::reset(bool_t const & resetRandomNumbers,
-                                 bool_t const & removeAllForce)
+    hresult_t EngineMultiRobot::reset(bool_t const & resetRandomNumbers,
+                                      bool_t const & removeAllForce)
     {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
         // Make sure the simulation is properly stopped
         if (isSimulationRunning_)
         {
@@ -927,11 +945,17 @@ namespace jiminy
             resetRandomGenerators(engineOptions_->stepper.randomSeed);
         }
 
-        // Reset the internal state of the robot and controller
+        /* Reset the internal state of the robot and controller.
+           Note that resetting the controller may fail, e.g. if it loads resources depending on
+           its options. The remaining systems are reset anyway to keep the engine consistent. */
         for (auto & system : systems_)
         {
             system.robot->reset();
-            system.controller->reset();
+            hresult_t const returnCodeController = system.controller->reset();
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = returnCodeController;
+            }
         }
 
         // Clear system state buffers, since the robot kinematic may change
@@ -939,9 +963,13 @@ namespace jiminy
         {
             systemData.state.clear();
             systemData.statePrev.clear();
+            systemData.stateEnd.clear();
+            systemData.stateMacroStepStart.clear();
         }
 
         isTelemetryConfigured_ = false;
+
+        return returnCode;
     }
 
     void computeExtraTerms(systemHolder_t           & system,
@@ -1208,10 +1236,18 @@ namespace jiminy
            inertia of a specific body. */
         if (isTelemetryConfigured_)
         {
-            reset(false, false);
+            hresult_t returnCode = reset(false, false);
+            if (returnCode != hresult_t::SUCCESS)
+            {
+                return returnCode;
+            }
         }
 
         // Reset the internal state of the robot and controller
+        std::vector<vectorN_t> sSplit;
+        std::vector<vectorN_t> dsSplit;
+        sSplit.reserve(systems_.size());
+        dsSplit.reserve(systems_.size());
         auto systemIt = systems_.begin();
         auto systemDataIt = systemsDataHolder_.begin();
         for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt)
@@ -1225,15 +1261,23 @@ namespace jiminy
                two successive simulations. */
             systemDataIt->state.initialize(*(systemIt->robot));
             systemDataIt->statePrev.initialize(*(systemIt->robot));
+            systemDataIt->stateEnd.initialize(*(systemIt->robot));
+            systemDataIt->stateMacroStepStart.initialize(*(systemIt->robot));
+
+            // The internal state of the motors starts from its value after reset
+            sSplit.push_back(systemIt->robot->getMotorsState());
+            dsSplit.push_back(vectorN_t::Zero(systemIt->robot->ns()));
         }
 
         // Initialize the ode solver
         auto systemOde = [this](float64_t              const & t,
                                 std::vector<vectorN_t> const & q,
                                 std::vector<vectorN_t> const & v,
-                                std::vector<vectorN_t>       & a) -> void
+                                std::vector<vectorN_t> const & s,
+                                std::vector<vectorN_t>       & a,
+                                std::vector<vectorN_t>       & ds) -> void
                          {
-                             this->computeSystemsDynamics(t, q, v, a);
+                             this->computeSystemsDynamics(t, q, v, s, a, ds);
                          };
         std::vector<Robot const *> robots;
         robots.reserve(systems_.size());
@@ -1243,39 +1287,123 @@ namespace jiminy
                         {
                             return sys.robot.get();
                         });
-        if (engineOptions_->stepper.odeSolver == "runge_kutta_dopri5")
-        {
-            stepper_ = std::unique_ptr<AbstractStepper>(
-                new RungeKuttaDOPRIStepper(systemOde,
-                                           robots,
-                                           engineOptions_->stepper.tolAbs,
-                                           engineOptions_->stepper.tolRel));
-        }
-        else if (engineOptions_->stepper.odeSolver == "runge_kutta_4")
-        {
-            stepper_ = std::unique_ptr<AbstractStepper>(
-                new RungeKutta4Stepper(systemOde, robots));
-        }
-        else if (engineOptions_->stepper.odeSolver == "euler_explicit")
-        {
-            stepper_ = std::unique_ptr<AbstractStepper>(
-                new EulerExplicitStepper(systemOde, robots));
+        auto createStepper = [this](systemDynamics             const & f,
+                                    std::vector<Robot const *> const & stepperRobots)
+                             -> std::unique_ptr<AbstractStepper>
+                             {
+                                 if (engineOptions_->stepper.odeSolver == "runge_kutta_dopri5")
+                                 {
+                                     return std::unique_ptr<AbstractStepper>(
+                                         new RungeKuttaDOPRIStepper(f,
+                                                                    stepperRobots,
+                                                                    engineOptions_->stepper.tolAbs,
+                                                                    engineOptions_->stepper.tolRel));
+                                 }
+                                 else if (engineOptions_->stepper.odeSolver == "runge_kutta_4")
+                                 {
+                                     return std::unique_ptr<AbstractStepper>(
+                                         new RungeKutta4Stepper(f, stepperRobots));
+                                 }
+                                 return std::unique_ptr<AbstractStepper>(
+                                     new EulerExplicitStepper(f, stepperRobots));
+                             };
+        stepper_ = createStepper(systemOde, robots);
+
+        /* Initialize a dedicated ode solver for each system if multi-rate integration is
+           enabled. Its dynamics only involves the state of the system being integrated,
+           the state of the other ones being estimated over the current macro step. */
+        multiRateState_.steppers.clear();
+        if (engineOptions_->stepper.multiRate)
+        {
+            for (std::size_t i = 0; i < systems_.size(); ++i)
+            {
+                auto systemOdeMultiRate =
+                    [this, i](float64_t              const & t,
+                              std::vector<vectorN_t> const & q,
+                              std::vector<vectorN_t> const & v,
+                              std::vector<vectorN_t> const & s,
+                              std::vector<vectorN_t>       & a,
+                              std::vector<vectorN_t>       & ds) -> void
+                    {
+                        this->computeSystemDynamicsMultiRate(i, t, q, v, s, a, ds);
+                    };
+                multiRateState_.steppers.push_back(createStepper(systemOdeMultiRate, {robots[i]}));
+            }
+            multiRateState_.systemsOrder.resize(systems_.size());
+            multiRateState_.isSystemIntegrated.assign(systems_.size(), false);
+            multiRateState_.tNext = 0.0;
+            multiRateState_.qSplitNext = qSplit;
+            multiRateState_.vSplitNext = vSplit;
+            multiRateState_.sSplitNext = sSplit;
+            multiRateState_.dqSplit = vSplit;
+            multiRateState_.qSystem.resize(1);
+            multiRateState_.vSystem.resize(1);
+            multiRateState_.sSystem.resize(1);
+            multiRateState_.aSystem.resize(1);
+            multiRateState_.dsSystem.resize(1);
+
+            // Determine which systems are coupled together, to only estimate those ones
+            multiRateState_.forcesCouplingIdx.assign(systems_.size(), {});
+            multiRateState_.coupledSystemsIdx.assign(systems_.size(), {});
+            for (std::size_t i = 0; i < forcesCoupling_.size(); ++i)
+            {
+                std::size_t const systemIdx1 = static_cast<std::size_t>(forcesCoupling_[i].systemIdx1);
+                std::size_t const systemIdx2 = static_cast<std::size_t>(forcesCoupling_[i].systemIdx2);
+                multiRateState_.forcesCouplingIdx[systemIdx1].push_back(i);
+                if (systemIdx2 != systemIdx1)
+                {
+                    multiRateState_.forcesCouplingIdx[systemIdx2].push_back(i);
+                    for (auto const & [systemIdx, systemIdxOther] : {std::make_pair(systemIdx1, systemIdx2),
+                                                                      std::make_pair(systemIdx2, systemIdx1)})
+                    {
+                        std::vector<std::size_t> & coupledSystemsIdx =
+                            multiRateState_.coupledSystemsIdx[systemIdx];
+                        if (std::find(coupledSystemsIdx.begin(), coupledSystemsIdx.end(),
+                                      systemIdxOther) == coupledSystemsIdx.end())
+                        {
+                            coupledSystemsIdx.push_back(systemIdxOther);
+                        }
+                    }
+                }
+            }
         }
 
         // Initialize the stepper state
         float64_t const t = 0.0;
-        stepperState_.reset(SIMULATION_MIN_TIMESTEP, qSplit, vSplit, aSplit);
+        stepperState_.reset(SIMULATION_MIN_TIMESTEP, qSplit, vSplit, sSplit, aSplit, dsSplit);
+
+        // Initialize the dense output buffers
+        qSplitInterp_ = qSplit;
+        vSplitInterp_ = vSplit;
+        sSplitInterp_ = sSplit;
+        aSplitInterp_ = aSplit;
+        dsSplitInterp_ = dsSplit;
+
+        /* Compute the period of the breakpoints of the stepper. Using dense output,
+           only the controller and the external force profiles must stop the stepper
+           since they are discontinuities of the dynamics, whereas the sensors and
+           the telemetry can be updated inside the steps. */
+        stepperBreakpointPeriod_ = stepperUpdatePeriod_;
+        if (engineOptions_->stepper.denseOutput && std::isfinite(stepperUpdatePeriod_))
+        {
+            bool_t isIncluded; float64_t breakpointPeriod;
+            std::tie(isIncluded, breakpointPeriod) = isGcdIncluded(
+                systemsDataHolder_, engineOptions_->stepper.controllerUpdatePeriod);
+            if (isIncluded && std::isfinite(breakpointPeriod))
+            {
+                stepperBreakpointPeriod_ = breakpointPeriod;
+            }
+        }
 
-        // Initialize previous joints forces and accelerations
-        fPrev_.clear();
-        aPrev_.clear();
-        fPrev_.reserve(systems_.size());
-        aPrev_.reserve(systems_.size());
-        for (auto const & system : systems_)
+        /* Initialize previous joints forces and accelerations.
+           The memory is only reallocated if the number of joints has changed. */
+        fPrev_.resize(systems_.size());
+        aPrev_.resize(systems_.size());
+        for (std::size_t i = 0; i < systems_.size(); ++i)
         {
-            uint32_t njoints = system.robot->pncModel_.njoints;
-            fPrev_.emplace_back(njoints, pinocchio::Force::Zero());
-            aPrev_.emplace_back(njoints, pinocchio::Motion::Zero());
+            uint32_t njoints = systems_[i].robot->pncModel_.njoints;
+            fPrev_[i].assign(njoints, pinocchio::Force::Zero());
+            aPrev_[i].assign(njoints, pinocchio::Motion::Zero());
         }
 
         // Synchronize the individual system states with the global stepper state
@@ -1342,21 +1470,18 @@ namespace jiminy
 
             // Initialize contacts forces in local frame
             std::vector<frameIndex_t> const & contactFramesIdx = systemIt->robot->getContactFramesIdx();
-            systemDataIt->contactFramesForces = forceVector_t(
+            systemDataIt->contactFramesForces.assign(
                 contactFramesIdx.size(), pinocchio::Force::Zero());
+            systemDataIt->contactFramesBatch.resize(contactFramesIdx.size());
             std::vector<std::vector<pairIndex_t> > const & collisionPairsIdx =
                 systemIt->robot->getCollisionPairsIdx();
-            systemDataIt->collisionBodiesForces.clear();
-            systemDataIt->collisionBodiesForces.reserve(collisionPairsIdx.size());
+            systemDataIt->collisionBodiesForces.resize(collisionPairsIdx.size());
             for (std::size_t i = 0; i < collisionPairsIdx.size(); ++i)
             {
-                systemDataIt->collisionBodiesForces.emplace_back(
+                systemDataIt->collisionBodiesForces[i].assign(
                     collisionPairsIdx[i].size(), pinocchio::Force::Zero());
             }
 
-            // Initialize some addition buffers used by impulse contact solver
-            systemDataIt->jointJacobian.setZero(6, systemIt->robot->pncModel_.nv);
-
             // Reset the constraints
             returnCode = systemIt->robot->resetConstraints(q, v);
 
@@ -1457,6 +1582,8 @@ namespace jiminy
                 vectorN_t const & q = systemDataIt->state.q;
                 vectorN_t const & v = systemDataIt->state.v;
                 vectorN_t & a = systemDataIt->state.a;
+                vectorN_t const & s = systemDataIt->state.s;
+                vectorN_t & ds = systemDataIt->state.ds;
                 vectorN_t & u = systemDataIt->state.u;
                 vectorN_t & command = systemDataIt->state.command;
                 vectorN_t & uMotor = systemDataIt->state.uMotor;
@@ -1464,20 +1591,34 @@ namespace jiminy
                 vectorN_t & uCustom = systemDataIt->state.uCustom;
                 forceVector_t & fext = systemDataIt->state.fExternal;
 
-                // Instantiate desired LCP solver
+                /* Instantiate desired LCP solver, unless the one of the previous simulation
+                   can be reused, which is the case if the constraints have not changed. */
                 std::string const & constraintSolverType = engineOptions_->constraints.solver;
                 switch (CONSTRAINT_SOLVERS_MAP.at(constraintSolverType))
                 {
                 case constraintSolver_t::PGS:
-                    systemDataIt->constraintSolver = std::make_unique<PGSSolver>(
-                        &systemIt->robot->pncModel_,
-                        &systemIt->robot->pncData_,
-                        &systemDataIt->constraintsHolder,
-                        engineOptions_->contacts.friction,
-                        engineOptions_->contacts.torsion,
-                        engineOptions_->stepper.tolAbs,
-                        engineOptions_->stepper.tolRel,
-                        PGS_MAX_ITERATIONS);
+                    {
+                        auto solver = dynamic_cast<PGSSolver *>(systemDataIt->constraintSolver.get());
+                        if (solver && solver->isCompatible(systemDataIt->constraintsHolder))
+                        {
+                            solver->setParameters(engineOptions_->contacts.friction,
+                                                  engineOptions_->contacts.torsion,
+                                                  engineOptions_->stepper.tolAbs,
+                                                  engineOptions_->stepper.tolRel);
+                        }
+                        else
+                        {
+                            systemDataIt->constraintSolver = std::make_unique<PGSSolver>(
+                                &systemIt->robot->pncModel_,
+                                &systemIt->robot->pncData_,
+                                &systemDataIt->constraintsHolder,
+                                engineOptions_->contacts.friction,
+                                engineOptions_->contacts.torsion,
+                                engineOptions_->stepper.tolAbs,
+                                engineOptions_->stepper.tolRel,
+                                PGS_MAX_ITERATIONS);
+                        }
+                    }
                         break;
                     case constraintSolver_t::NONE:
                     default:
@@ -1490,13 +1631,17 @@ namespace jiminy
                 // Compute the actual motor effort
                 computeCommand(*systemIt, t, q, v, command);
 
-                // Compute the actual motor effort
-                systemIt->robot->computeMotorsEfforts(t, q, v, a, command);
+                // Compute the actual motor effort, and the time derivative of their internal state
+                systemIt->robot->computeMotorsEfforts(t, q, v, a, s, command);
                 uMotor = systemIt->robot->getMotorsEfforts();
+                ds = systemIt->robot->getMotorsStateDerivative();
 
                 // Compute the internal dynamics
                 uCustom.setZero();
-                systemIt->controller->internalDynamics(t, q, v, uCustom);
+                if (systemIt->controller->getHasInternalDynamics())
+                {
+                    systemIt->controller->internalDynamics(t, q, v, uCustom);
+                }
 
                 // Compute the total effort vector
                 u = uInternal + uCustom;
@@ -1535,6 +1680,16 @@ namespace jiminy
                 systemData.statePrev = systemData.state;
             }
 
+            // Initialize the penetration depth of the contact frames, used for contact events detection
+            systemIt = systems_.begin();
+            systemDataIt = systemsDataHolder_.begin();
+            for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt)
+            {
+                computeContactFramesDepth(*systemIt,
+                                          systemDataIt->contactFramesDepth,
+                                          systemDataIt->contactFramesDepthRate);
+            }
+
             // Lock the telemetry. At this point it is no longer possible to register new variables.
             configureTelemetry();
 
@@ -1571,8 +1726,9 @@ namespace jiminy
                 // Backup the true and theoretical Pinocchio::Model
                 std::string key = addCircumfix(
                     "pinocchio_model", system.name, "", TELEMETRY_FIELDNAME_DELIMITER);
-                std::string value = saveToBinary(system.robot->pncModel_);
-                telemetrySender_.registerConstant(key, value);
+                telemetrySender_.registerConstant(key, getTelemetryConstantCached(
+                    key, hashModel(system.robot->pncModel_),
+                    [&system]() { return saveToBinary(system.robot->pncModel_); }));
 
                 /* Backup the Pinocchio GeometryModel for collisions and visuals.
                    It may fail because of missing serialization methods for convex,
@@ -1585,13 +1741,18 @@ namespace jiminy
                     {
                         key = addCircumfix(
                             "collision_model", system.name, "", TELEMETRY_FIELDNAME_DELIMITER);
-                        value = saveToBinary(system.robot->collisionModel_);
-                        telemetrySender_.registerConstant(key, value);
+                        telemetrySender_.registerConstant(key, getTelemetryConstantCached(
+                            key, system.robot->getGeometryModelsVersion(),
+                            [&system]() { return saveToBinary(system.robot->collisionModel_); }));
+
+                        // The visual model must be built first if it has been deferred
+                        system.robot->loadVisualModel();  // Not critical: an empty model is logged otherwise
 
                         key = addCircumfix(
                             "visual_model", system.name, "", TELEMETRY_FIELDNAME_DELIMITER);
-                        value = saveToBinary(system.robot->visualModel_);
-                        telemetrySender_.registerConstant(key, value);
+                        telemetrySender_.registerConstant(key, getTelemetryConstantCached(
+                            key, system.robot->getGeometryModelsVersion(),
+                            [&system]() { return saveToBinary(system.robot->visualModel_); }));
                     }
                     catch (std::exception const & e)
                     {
@@ -1608,8 +1769,12 @@ namespace jiminy
 
             // Log all options
             configHolder_t allOptions;
+            std::size_t optionsVersion = optionsVersion_;
             for (auto const & system : systems_)
             {
+                optionsVersion = std::max({optionsVersion,
+                                           system.robot->getOptionsVersion(),
+                                           system.controller->getOptionsVersion()});
                 std::string const telemetryRobotOptions = addCircumfix(
                     "system", system.name, "", TELEMETRY_FIELDNAME_DELIMITER);
                 configHolder_t systemOptions;
@@ -1618,11 +1783,15 @@ namespace jiminy
                 allOptions[telemetryRobotOptions] = systemOptions;
             }
             allOptions["engine"] = engineOptionsHolder_;
-            Json::Value allOptionsJson = convertToJson(allOptions);
-            Json::StreamWriterBuilder jsonWriter;
-            jsonWriter["indentation"] = "";
-            std::string const allOptionsString = Json::writeString(jsonWriter, allOptionsJson);
-            telemetrySender_.registerConstant("options", allOptionsString);
+            telemetrySender_.registerConstant("options", getTelemetryConstantCached(
+                "options", optionsVersion,
+                [&allOptions]()
+                {
+                    Json::Value allOptionsJson = convertToJson(allOptions);
+                    Json::StreamWriterBuilder jsonWriter;
+                    jsonWriter["indentation"] = "";
+                    return Json::writeString(jsonWriter, allOptionsJson);
+                }));
 
             // Write the header: this locks the registration of new variables
             telemetryRecorder_->initialize(telemetryData_.get(), getTelemetryTimeUnit());
@@ -1656,8 +1825,11 @@ namespace jiminy
         if (returnCode == hresult_t::SUCCESS)
         {
             // Reset the robot, controller, and engine
-            reset(true, false);
+            returnCode = reset(true, false);
+        }
 
+        if (returnCode == hresult_t::SUCCESS)
+        {
             // Start the simulation
             returnCode = start(qInit, vInit, aInit);
         }
@@ -1718,11 +1890,13 @@ namespace jiminy
                 break;
             }
 
-            // Perform a single integration step up to tEnd, stopping at stepperUpdatePeriod_ to log
+            /* Perform a single integration step up to tEnd, stopping at stepperBreakpointPeriod_.
+               Logging is done at stepperUpdatePeriod_, possibly inside the step if dense output
+               is enabled. */
             float64_t stepSize;
-            if (std::isfinite(stepperUpdatePeriod_))
+            if (std::isfinite(stepperBreakpointPeriod_))
             {
-                stepSize = min(stepperUpdatePeriod_, tEnd - stepperState_.t);
+                stepSize = min(stepperBreakpointPeriod_, tEnd - stepperState_.t);
             }
             else
             {
@@ -1754,12 +1928,16 @@ namespace jiminy
         // Check if there is something wrong with the integration
         auto qIt = stepperState_.qSplit.begin();
         auto vIt = stepperState_.vSplit.begin();
+        auto sIt = stepperState_.sSplit.begin();
         auto aIt = stepperState_.aSplit.begin();
-        for ( ; qIt != stepperState_.qSplit.end(); ++qIt, ++vIt, ++aIt)
+        auto dsIt = stepperState_.dsSplit.begin();
+        for ( ; qIt != stepperState_.qSplit.end(); ++qIt, ++vIt, ++sIt, ++aIt, ++dsIt)
         {
             if ((qIt->array() != qIt->array()).any() ||
                 (vIt->array() != vIt->array()).any() ||
-                (aIt->array() != aIt->array()).any()) // isnan if NOT equal to itself
+                (sIt->array() != sIt->array()).any() ||
+                (aIt->array() != aIt->array()).any() ||
+                (dsIt->array() != dsIt->array()).any()) // isnan if NOT equal to itself
             {
                 PRINT_ERROR("The low-level ode solver failed. Consider increasing the stepper accuracy.");
                 return hresult_t::ERROR_GENERIC;
@@ -1822,7 +2000,9 @@ namespace jiminy
         float64_t & dtLargest = stepperState_.dtLargest;
         std::vector<vectorN_t> & qSplit = stepperState_.qSplit;
         std::vector<vectorN_t> & vSplit = stepperState_.vSplit;
+        std::vector<vectorN_t> & sSplit = stepperState_.sSplit;
         std::vector<vectorN_t> & aSplit = stepperState_.aSplit;
+        std::vector<vectorN_t> & dsSplit = stepperState_.dsSplit;
 
         // Monitor iteration failure
         uint32_t successiveIterFailed = 0;
@@ -1855,6 +2035,13 @@ namespace jiminy
            dynamics has changed. Maybe dt should be reschedule... */
         bool_t hasDynamicsChanged = false;
 
+        /* Flag monitoring if the last step has been rejected because a
+           contact event (touchdown or takeoff) occurred strictly inside it.
+           If so, the next step is adjusted to end up exactly at the event,
+           which is then handled as any other breakpoint. */
+        bool_t isContactEventReached = false;
+        float64_t dtContactEvent = INF;
+
         // Start the timer used for timeout handling
         timer_->tic();
 
@@ -1988,7 +2175,7 @@ namespace jiminy
             // Fix the FSAL issue if the dynamics has changed
             if (!std::isfinite(stepperUpdatePeriod_) && hasDynamicsChanged)
             {
-                computeSystemsDynamics(t, qSplit, vSplit, aSplit);
+                computeSystemsDynamics(t, qSplit, vSplit, sSplit, aSplit, dsSplit);
                 computeAllExtraTerms(systems_, systemsDataHolder_);
                 syncAllAccelerationsAndForces(systems_, fPrev_, aPrev_);
                 syncSystemsStateWithStepper(true);
@@ -1999,16 +2186,17 @@ namespace jiminy
             {
                 /* Get the time of the next breakpoint for the ODE solver:
                    a breakpoint occurs if we reached tEnd, if an external force
-                   is applied, or if we need to update the sensors / controller. */
+                   is applied, or if we need to update the sensors / controller.
+                   Note that the sensors are not breakpoints if dense output is enabled. */
                 float64_t dtNextGlobal;  // dt to apply for the next stepper step because of the various breakpoints
-                float64_t const dtNextUpdatePeriod = stepperUpdatePeriod_ - std::fmod(t, stepperUpdatePeriod_);
+                float64_t const dtNextUpdatePeriod = stepperBreakpointPeriod_ - std::fmod(t, stepperBreakpointPeriod_);
                 if (dtNextUpdatePeriod < SIMULATION_MIN_TIMESTEP)
                 {
                     /* Step to reach next sensors/controller update is too short:
                        skip one controller update and jump to the next one.
                        Note that in this case, the sensors have already been
                        updated in anticipation in previous loop. */
-                    dtNextGlobal = min(dtNextUpdatePeriod + stepperUpdatePeriod_,
+                    dtNextGlobal = min(dtNextUpdatePeriod + stepperBreakpointPeriod_,
                                        tForceImpulseNext - t);
                 }
                 else
@@ -2031,7 +2219,8 @@ namespace jiminy
                 while (tNext - t > STEPPER_MIN_TIMESTEP)
                 {
                     // Log every stepper state only if the user asked for
-                    if (successiveIterFailed == 0 && engineOptions_->stepper.logInternalStepperSteps)
+                    if (successiveIterFailed == 0 && !isContactEventReached
+                        && engineOptions_->stepper.logInternalStepperSteps)
                     {
                         updateTelemetry();
                     }
@@ -2039,13 +2228,21 @@ namespace jiminy
                     // Fix the FSAL issue if the dynamics has changed
                     if (hasDynamicsChanged)
                     {
-                        computeSystemsDynamics(t, qSplit, vSplit, aSplit);
+                        computeSystemsDynamics(t, qSplit, vSplit, sSplit, aSplit, dsSplit);
                         computeAllExtraTerms(systems_, systemsDataHolder_);
                         syncAllAccelerationsAndForces(systems_, fPrev_, aPrev_);
                         syncSystemsStateWithStepper(true);
                         hasDynamicsChanged = false;
                     }
 
+                    /* Integrate each system independently up to the next breakpoint
+                       if multi-rate integration is enabled, then move on. */
+                    if (engineOptions_->stepper.multiRate)
+                    {
+                        stepMultiRate(tNext, successiveIterFailed, isNan);
+                        break;
+                    }
+
                     // Adjust stepsize to end up exactly at the next breakpoint
                     dt = min(dt, tNext - t);
                     if (dtLargest > SIMULATION_MIN_TIMESTEP)
@@ -2069,7 +2266,7 @@ namespace jiminy
                        'infinitesimal' time in robotics. This arbitrary threshold
                        many not be suited for simulating different, faster
                        dynamics, that require sub-microsecond precision. */
-                    if (dt > SIMULATION_MIN_TIMESTEP)
+                    if (dt > SIMULATION_MIN_TIMESTEP && !isContactEventReached)
                     {
                         float64_t const dtResidual = std::fmod(dt, SIMULATION_MIN_TIMESTEP);
                         if (dtResidual > STEPPER_MIN_TIMESTEP
@@ -2110,7 +2307,8 @@ namespace jiminy
                     dtLargest = dt;
 
                     // Try doing one integration step
-                    bool_t isStepSuccessful = stepper_->tryStep(qSplit, vSplit, aSplit, t, dtLargest);
+                    float64_t const tStepStart = t;
+                    bool_t isStepSuccessful = stepper_->tryStep(qSplit, vSplit, sSplit, aSplit, dsSplit, t, dtLargest);
 
                     /* Check if the integrator failed miserably even if successfully.
                        It would happen if integration failed because of nan and the
@@ -2121,6 +2319,22 @@ namespace jiminy
                         break;
                     }
 
+                    /* Reject the step if a contact event occurred strictly inside it,
+                       then try again to end up exactly at the event. The stepper state
+                       is restored, but the largest step size estimated by the stepper
+                       is kept since the step was accurate enough. */
+                    isContactEventReached = false;
+                    if (isStepSuccessful && engineOptions_->stepper.detectContactEvents)
+                    {
+                        if (detectContactEvents(dt, dtContactEvent))
+                        {
+                            t = tStepStart;
+                            syncStepperStateWithSystems();
+                            isStepSuccessful = false;
+                            isContactEventReached = true;
+                        }
+                    }
+
                     // Update buffer if really successful
                     if (isStepSuccessful)
                     {
@@ -2135,6 +2349,13 @@ namespace jiminy
                         syncAllAccelerationsAndForces(systems_, fPrev_, aPrev_);
                         syncSystemsStateWithStepper();
 
+                        /* Update the sensors and the telemetry inside the step if necessary,
+                           based on the dense output of the stepper. */
+                        if (engineOptions_->stepper.denseOutput)
+                        {
+                            updateDenseOutputSamples(tStepStart, tNext);
+                        }
+
                         // Increment the iteration counter only for successful steps
                         ++stepperState_.iter;
 
@@ -2174,6 +2395,12 @@ namespace jiminy
                             systemData.statePrev = systemData.state;
                         }
                     }
+                    else if (isContactEventReached)
+                    {
+                        /* Rejecting a step because of a contact event is not an integration
+                           failure, yet it must be bounded in case root-finding stalls. */
+                        ++successiveIterFailed;
+                    }
                     else
                     {
                         // Increment the failed iteration counters
@@ -2183,6 +2410,10 @@ namespace jiminy
 
                     // Initialize the next dt
                     dt = min(dtLargest, engineOptions_->stepper.dtMax);
+                    if (isContactEventReached)
+                    {
+                        dt = dtContactEvent;
+                    }
                 }
             }
             else
@@ -2211,7 +2442,8 @@ namespace jiminy
                     }
 
                     // Try to do a step
-                    isStepSuccessful = stepper_->tryStep(qSplit, vSplit, aSplit, t, dtLargest);
+                    float64_t const tStepStart = t;
+                    isStepSuccessful = stepper_->tryStep(qSplit, vSplit, sSplit, aSplit, dsSplit, t, dtLargest);
 
                     // Check if the integrator failed miserably even if successfully
                     isNan = std::isnan(dtLargest);
@@ -2220,6 +2452,22 @@ namespace jiminy
                         break;
                     }
 
+                    /* Reject the step if a contact event occurred strictly inside it,
+                       then try again to end up exactly at the event. The stepper state
+                       is restored, but the largest step size estimated by the stepper
+                       is kept since the step was accurate enough. */
+                    isContactEventReached = false;
+                    if (isStepSuccessful && engineOptions_->stepper.detectContactEvents)
+                    {
+                        if (detectContactEvents(dt, dtContactEvent))
+                        {
+                            t = tStepStart;
+                            syncStepperStateWithSystems();
+                            isStepSuccessful = false;
+                            isContactEventReached = true;
+                        }
+                    }
+
                     if (isStepSuccessful)
                     {
                         // Reset successive iteration failure counter
@@ -2255,6 +2503,16 @@ namespace jiminy
                             systemData.statePrev = systemData.state;
                         }
                     }
+                    else if (isContactEventReached)
+                    {
+                        /* Rejecting a step because of a contact event is not an integration
+                           failure, yet it must be bounded in case root-finding stalls. */
+                        ++successiveIterFailed;
+
+                        /* The event is a breakpoint, so that the step size is restored
+                           after it, as for the discrete-time branch. */
+                        isBreakpointReached = true;
+                    }
                     else
                     {
                         // Increment the failed iteration counter
@@ -2264,6 +2522,10 @@ namespace jiminy
 
                     // Initialize the next dt
                     dt = min(dtLargest, engineOptions_->stepper.dtMax);
+                    if (isContactEventReached)
+                    {
+                        dt = dtContactEvent;
+                    }
                 }
             }
 
@@ -2333,6 +2595,23 @@ namespace jiminy
         return returnCode;
     }
 
+    std::string const & EngineMultiRobot::getTelemetryConstantCached(
+        std::string                      const & key,
+        std::size_t                      const & version,
+        std::function<std::string(void)> const & serialize)
+    {
+        /* Serializing the models is expensive compared to the cost of a short
+           simulation, while they rarely change from one episode to another. */
+        auto telemetryConstantIt = telemetryConstantsCache_.find(key);
+        if (telemetryConstantIt == telemetryConstantsCache_.end()
+         || telemetryConstantIt->second.first != version)
+        {
+            telemetryConstantIt = telemetryConstantsCache_.insert_or_assign(
+                key, std::make_pair(version, serialize())).first;
+        }
+        return telemetryConstantIt->second.second;
+    }
+
     void EngineMultiRobot::stop(void)
     {
         // Release the lock on the robots
@@ -2365,6 +2644,234 @@ namespace jiminy
         isSimulationRunning_ = false;
     }
 
+    hresult_t EngineMultiRobot::saveState(engineState_t & engineState)
+    {
+        // Check if the simulation has started
+        if (!isSimulationRunning_)
+        {
+            PRINT_ERROR("No simulation running. Please start it before saving its state.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        // Backup the global state of the simulation
+        engineState.stepper = stepperState_;
+        stepper_->getDenseOutput(engineState.stepperDenseOutput);
+        engineState.fPrev = fPrev_;
+        engineState.aPrev = aPrev_;
+        engineState.randomGenerator = getRandomGenerator();
+
+        // Backup the state of every system
+        engineState.systems.resize(systems_.size());
+        auto systemIt = systems_.begin();
+        auto systemDataIt = systemsDataHolder_.begin();
+        auto systemSnapshotIt = engineState.systems.begin();
+        for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt, ++systemSnapshotIt)
+        {
+            systemSnapshotIt->state = systemDataIt->state;
+            systemSnapshotIt->statePrev = systemDataIt->statePrev;
+
+            // Backup the active set of impulse forces and the next breakpoint
+            systemSnapshotIt->forcesImpulseActive = systemDataIt->forcesImpulseActive;
+            if (systemDataIt->forcesImpulseBreakNextIt != systemDataIt->forcesImpulseBreaks.end())
+            {
+                systemSnapshotIt->forcesImpulseBreakNext = *systemDataIt->forcesImpulseBreakNextIt;
+            }
+            else
+            {
+                systemSnapshotIt->forcesImpulseBreakNext = INF;
+            }
+
+            // Backup the last value of the force profiles
+            forceProfileRegister_t const & forcesProfile = systemDataIt->forcesProfile;
+            systemSnapshotIt->forcesProfilePrev.resize(forcesProfile.size());
+            for (std::size_t i = 0; i < forcesProfile.size(); ++i)
+            {
+                systemSnapshotIt->forcesProfilePrev[i] = forcesProfile[i].forcePrev;
+            }
+
+            // Backup the penetration depth of the contact frames, used for contact events detection
+            systemSnapshotIt->contactFramesDepth = systemDataIt->contactFramesDepth;
+            systemSnapshotIt->contactFramesDepthRate = systemDataIt->contactFramesDepthRate;
+
+            /* Backup the state of the constraints. The reference configuration of the joint
+               bounds is the only one that depends on the history since the reference pose
+               of the contact constraints is updated systematically when they are enabled. */
+            std::vector<constraintState_t> & constraintsState = systemSnapshotIt->constraints;
+            std::size_t constraintIdx = 0U;
+            systemDataIt->constraintsHolder.foreach(
+                [&constraintsState, &constraintIdx](
+                    std::shared_ptr<AbstractConstraintBase> const & constraint,
+                    constraintsHolderType_t const & holderType)
+                {
+                    if (constraintIdx == constraintsState.size())
+                    {
+                        constraintsState.emplace_back();
+                    }
+                    constraintState_t & constraintState = constraintsState[constraintIdx++];
+                    constraintState.isEnabled = constraint->getIsEnabled();
+                    constraintState.lambda = constraint->lambda_;
+                    if (holderType == constraintsHolderType_t::BOUNDS_JOINTS)
+                    {
+                        auto & jointConstraint = static_cast<JointConstraint &>(*constraint.get());
+                        constraintState.configurationRef = jointConstraint.getReferenceConfiguration();
+                        constraintState.isReversed = jointConstraint.getRotationDir();
+                    }
+                });
+            constraintsState.resize(constraintIdx);
+
+            // Backup the history of the sensors
+            systemIt->robot->getSensorsState(systemSnapshotIt->sensors);
+
+            // Backup the internal state of the controller
+            hresult_t const returnCode = systemIt->controller->saveState(systemSnapshotIt->controller);
+            if (returnCode != hresult_t::SUCCESS)
+            {
+                PRINT_ERROR("Impossible to save the state of the controller of system '", systemIt->name, "'.");
+                return returnCode;
+            }
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t EngineMultiRobot::restoreState(engineState_t const & engineState)
+    {
+        // Check if the simulation has started
+        if (!isSimulationRunning_)
+        {
+            PRINT_ERROR("No simulation running. Please start it before restoring its state.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        // Make sure that the state is consistent with the current simulation before altering it
+        if (engineState.systems.size() != systems_.size()
+         || engineState.stepper.qSplit.size() != systems_.size())
+        {
+            PRINT_ERROR("The state is not consistent with the systems of the engine.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        auto systemIt = systems_.begin();
+        auto systemDataIt = systemsDataHolder_.begin();
+        auto systemSnapshotIt = engineState.systems.begin();
+        for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt, ++systemSnapshotIt)
+        {
+            std::size_t nConstraints = 0U;
+            systemDataIt->constraintsHolder.foreach(
+                [&nConstraints](std::shared_ptr<AbstractConstraintBase> const & /* constraint */,
+                                constraintsHolderType_t const & /* holderType */)
+                {
+                    ++nConstraints;
+                });
+            Robot const & robot = *systemIt->robot;
+            if (systemSnapshotIt->state.q.size() != robot.nq()
+             || systemSnapshotIt->state.v.size() != robot.nv()
+             || systemSnapshotIt->state.s.size() != robot.ns()
+             || systemSnapshotIt->forcesImpulseActive.size() != systemDataIt->forcesImpulse.size()
+             || systemSnapshotIt->forcesProfilePrev.size() != systemDataIt->forcesProfile.size()
+             || systemSnapshotIt->constraints.size() != nConstraints
+             || systemSnapshotIt->sensors.time.size() != robot.getSensors().size()
+             || systemSnapshotIt->sensors.dataMeasured.size() != robot.getSensorsDataFlat().size())
+            {
+                PRINT_ERROR("The state is not consistent with system '", systemIt->name, "'.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        /* Restore the opaque states first, namely the ones whose consistency can only be checked
+           by their owner. The stepper does not alter itself if it fails, but the controllers may
+           be partially restored if they fail after one another. It cannot happen unless they
+           have been replaced by ones of different types since saving the state. */
+        if (!stepper_->setDenseOutput(engineState.stepperDenseOutput))
+        {
+            PRINT_ERROR("The state is not consistent with the stepper of the engine.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        systemIt = systems_.begin();
+        systemSnapshotIt = engineState.systems.begin();
+        for ( ; systemIt != systems_.end(); ++systemIt, ++systemSnapshotIt)
+        {
+            hresult_t const returnCode = systemIt->controller->restoreState(systemSnapshotIt->controller);
+            if (returnCode != hresult_t::SUCCESS)
+            {
+                PRINT_ERROR("The state is not consistent with the controller of system '",
+                            systemIt->name, "'.");
+                return returnCode;
+            }
+        }
+
+        // Clear log data buffer
+        logData_ = nullptr;
+
+        // Restore the global state of the simulation
+        stepperState_ = engineState.stepper;
+        fPrev_ = engineState.fPrev;
+        aPrev_ = engineState.aPrev;
+        setRandomGenerator(engineState.randomGenerator);
+
+        // Restore the state of every system
+        systemIt = systems_.begin();
+        systemDataIt = systemsDataHolder_.begin();
+        systemSnapshotIt = engineState.systems.begin();
+        for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt, ++systemSnapshotIt)
+        {
+            systemDataIt->state = systemSnapshotIt->state;
+            systemDataIt->statePrev = systemSnapshotIt->statePrev;
+
+            // Restore the active set of impulse forces and the next breakpoint
+            systemDataIt->forcesImpulseActive = systemSnapshotIt->forcesImpulseActive;
+            systemDataIt->forcesImpulseBreakNextIt = systemDataIt->forcesImpulseBreaks.lower_bound(
+                systemSnapshotIt->forcesImpulseBreakNext);
+
+            // Restore the last value of the force profiles
+            forceProfileRegister_t & forcesProfile = systemDataIt->forcesProfile;
+            for (std::size_t i = 0; i < forcesProfile.size(); ++i)
+            {
+                forcesProfile[i].forcePrev = systemSnapshotIt->forcesProfilePrev[i];
+            }
+
+            // Restore the penetration depth of the contact frames
+            systemDataIt->contactFramesDepth = systemSnapshotIt->contactFramesDepth;
+            systemDataIt->contactFramesDepthRate = systemSnapshotIt->contactFramesDepthRate;
+
+            // Restore the state of the constraints
+            std::vector<constraintState_t> const & constraintsState = systemSnapshotIt->constraints;
+            std::size_t constraintIdx = 0U;
+            systemDataIt->constraintsHolder.foreach(
+                [&constraintsState, &constraintIdx](
+                    std::shared_ptr<AbstractConstraintBase> const & constraint,
+                    constraintsHolderType_t const & holderType)
+                {
+                    constraintState_t const & constraintState = constraintsState[constraintIdx++];
+                    if (constraintState.isEnabled)
+                    {
+                        constraint->enable();
+                    }
+                    else
+                    {
+                        constraint->disable();
+                    }
+                    constraint->lambda_ = constraintState.lambda;
+                    if (holderType == constraintsHolderType_t::BOUNDS_JOINTS)
+                    {
+                        auto & jointConstraint = static_cast<JointConstraint &>(*constraint.get());
+                        jointConstraint.setReferenceConfiguration(constraintState.configurationRef);
+                        jointConstraint.setRotationDir(constraintState.isReversed);
+                    }
+                });
+
+            /* Restore the history of the sensors and the internal state of the motors.
+               It cannot fail at this point. */
+            systemIt->robot->setSensorsState(systemSnapshotIt->sensors);
+            systemIt->robot->setMotorsState(systemDataIt->state.s);
+
+            // Update the kinematics of the system, so that it is consistent with its state
+            systemState_t const & systemState = systemDataIt->state;
+            computeForwardKinematics(*systemIt, systemState.q, systemState.v, systemState.a);
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
     hresult_t EngineMultiRobot::registerForceImpulse(std::string      const & systemName,
                                                      std::string      const & frameName,
                                                      float64_t        const & t,
@@ -2656,127 +3163,222 @@ namespace jiminy
         return returnCode;
     }
 
-    configHolder_t EngineMultiRobot::getOptions(void) const
+    configHolder_t const & EngineMultiRobot::getOptions(void) const
     {
         return engineOptionsHolder_;
     }
 
-    hresult_t EngineMultiRobot::setOptions(configHolder_t const & engineOptions)
+    hresult_t EngineMultiRobot::checkOptions(std::string    const & group,
+                                             configHolder_t const & groupOptions) const
     {
-        if (isSimulationRunning_)
+        if (group == "stepper")
         {
-            PRINT_ERROR("A simulation is running. Please stop it before updating the options.");
-            return hresult_t::ERROR_GENERIC;
-        }
+            configHolder_t const & stepperOptions = groupOptions;
 
-        // Make sure the dtMax is not out of range
-        configHolder_t stepperOptions = boost::get<configHolder_t>(engineOptions.at("stepper"));
-        float64_t const & dtMax = boost::get<float64_t>(stepperOptions.at("dtMax"));
-        if (SIMULATION_MAX_TIMESTEP + EPS < dtMax || dtMax < SIMULATION_MIN_TIMESTEP)
-        {
-            PRINT_ERROR("'dtMax' option is out of range.");
-            return hresult_t::ERROR_BAD_INPUT;
-        }
+            // Make sure the dtMax is not out of range
+            float64_t const & dtMax = boost::get<float64_t>(stepperOptions.at("dtMax"));
+            if (SIMULATION_MAX_TIMESTEP + EPS < dtMax || dtMax < SIMULATION_MIN_TIMESTEP)
+            {
+                PRINT_ERROR("'dtMax' option is out of range.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
 
-        // Make sure successiveIterFailedMax is strictly positive
-        uint32_t const & successiveIterFailedMax = boost::get<uint32_t>(stepperOptions.at("successiveIterFailedMax"));
-        if (successiveIterFailedMax < 1)
-        {
-            PRINT_ERROR("'successiveIterFailedMax' must be strictly positive.");
-            return hresult_t::ERROR_BAD_INPUT;
-        }
+            // Make sure successiveIterFailedMax is strictly positive
+            uint32_t const & successiveIterFailedMax = boost::get<uint32_t>(stepperOptions.at("successiveIterFailedMax"));
+            if (successiveIterFailedMax < 1)
+            {
+                PRINT_ERROR("'successiveIterFailedMax' must be strictly positive.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
 
-        // Make sure the selected ode solver is available and instantiate it
-        std::string const & odeSolver = boost::get<std::string>(stepperOptions.at("odeSolver"));
-        if (STEPPERS.find(odeSolver) == STEPPERS.end())
-        {
-            PRINT_ERROR("The requested ODE solver is not available.");
-            return hresult_t::ERROR_BAD_INPUT;
-        }
+            // Make sure the selected ode solver is available and instantiate it
+            std::string const & odeSolver = boost::get<std::string>(stepperOptions.at("odeSolver"));
+            if (STEPPERS.find(odeSolver) == STEPPERS.end())
+            {
+                PRINT_ERROR("The requested ODE solver is not available.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
 
-        // Make sure the controller and sensor update periods are valid
-        float64_t const & sensorsUpdatePeriod =
-            boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod"));
-        float64_t const & controllerUpdatePeriod =
-            boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod"));
-        bool_t isIncluded; float64_t minUpdatePeriod;
-        std::tie(isIncluded, minUpdatePeriod) = isGcdIncluded(
-            systemsDataHolder_, controllerUpdatePeriod, sensorsUpdatePeriod);
-        if ((EPS < sensorsUpdatePeriod && sensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP)
-        || (EPS < controllerUpdatePeriod && controllerUpdatePeriod < SIMULATION_MIN_TIMESTEP))
-        {
-            PRINT_ERROR("Cannot simulate a discrete system with update period smaller than ",
-                        SIMULATION_MIN_TIMESTEP, "s. Adjust period or switch to continuous mode "
-                        "by setting period to zero.");
-            return hresult_t::ERROR_BAD_INPUT;
+            // Make sure contact events detection is supported by the selected ode solver
+            bool_t const & detectContactEvents = boost::get<bool_t>(stepperOptions.at("detectContactEvents"));
+            if (detectContactEvents && odeSolver == "euler_explicit")
+            {
+                PRINT_ERROR("Contact events detection is not supported by 'euler_explicit' ODE solver.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+
+            // Make sure the controller and sensor update periods are valid
+            float64_t const & sensorsUpdatePeriod =
+                boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod"));
+            float64_t const & controllerUpdatePeriod =
+                boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod"));
+            bool_t const isIncluded = std::get<0>(isGcdIncluded(
+                systemsDataHolder_, controllerUpdatePeriod, sensorsUpdatePeriod));
+            if ((EPS < sensorsUpdatePeriod && sensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP)
+            || (EPS < controllerUpdatePeriod && controllerUpdatePeriod < SIMULATION_MIN_TIMESTEP))
+            {
+                PRINT_ERROR("Cannot simulate a discrete system with update period smaller than ",
+                            SIMULATION_MIN_TIMESTEP, "s. Adjust period or switch to continuous mode "
+                            "by setting period to zero.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            else if (!isIncluded)
+            {
+                PRINT_ERROR("In discrete mode, the controller and sensor update periods must be "
+                            "multiple of each other.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+
+            // Make sure dense output is supported by the selected ode solver and the update periods
+            bool_t const & denseOutput = boost::get<bool_t>(stepperOptions.at("denseOutput"));
+            if (denseOutput)
+            {
+                if (odeSolver == "euler_explicit")
+                {
+                    PRINT_ERROR("Dense output is not supported by 'euler_explicit' ODE solver.");
+                    return hresult_t::ERROR_BAD_INPUT;
+                }
+                if (sensorsUpdatePeriod < EPS || controllerUpdatePeriod < EPS)
+                {
+                    PRINT_ERROR("Dense output is only supported if both the controller and sensor "
+                                "update periods are discrete.");
+                    return hresult_t::ERROR_BAD_INPUT;
+                }
+            }
+
+            // Make sure multi-rate integration is supported by the update periods and other options
+            bool_t const & multiRate = boost::get<bool_t>(stepperOptions.at("multiRate"));
+            if (multiRate)
+            {
+                if (sensorsUpdatePeriod < EPS || controllerUpdatePeriod < EPS)
+                {
+                    PRINT_ERROR("Multi-rate integration is only supported if both the controller and "
+                                "sensor update periods are discrete.");
+                    return hresult_t::ERROR_BAD_INPUT;
+                }
+                if (denseOutput || detectContactEvents)
+                {
+                    PRINT_ERROR("Multi-rate integration is not supported along with dense output or "
+                                "contact events detection.");
+                    return hresult_t::ERROR_BAD_INPUT;
+                }
+                if (boost::get<bool_t>(stepperOptions.at("logInternalStepperSteps")))
+                {
+                    PRINT_ERROR("Multi-rate integration does not support logging internal stepper steps, "
+                                "since the systems do not share their steps.");
+                    return hresult_t::ERROR_BAD_INPUT;
+                }
+            }
         }
-        else if (!isIncluded)
+        else if (group == "constraints")
         {
-            PRINT_ERROR("In discrete mode, the controller and sensor update periods must be "
-                        "multiple of each other.");
-            return hresult_t::ERROR_BAD_INPUT;
-        }
+            configHolder_t const & constraintsOptions = groupOptions;
 
-        // Make sure the contacts options are fine
-        configHolder_t constraintsOptions = boost::get<configHolder_t>(engineOptions.at("constraints"));
-        std::string const & constraintSolverType = boost::get<std::string>(constraintsOptions.at("solver"));
-        auto const constraintSolverIt = CONSTRAINT_SOLVERS_MAP.find(constraintSolverType);
-        if (constraintSolverIt == CONSTRAINT_SOLVERS_MAP.end())
-        {
-            PRINT_ERROR("The requested constraint solver is not available.");
-            return hresult_t::ERROR_BAD_INPUT;
+            // Make sure the constraint solver is available
+            std::string const & constraintSolverType = boost::get<std::string>(constraintsOptions.at("solver"));
+            auto const constraintSolverIt = CONSTRAINT_SOLVERS_MAP.find(constraintSolverType);
+            if (constraintSolverIt == CONSTRAINT_SOLVERS_MAP.end())
+            {
+                PRINT_ERROR("The requested constraint solver is not available.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            float64_t const & stabilizationFreq =
+                boost::get<float64_t>(constraintsOptions.at("stabilizationFreq"));
+            if (stabilizationFreq < 0.0)
+            {
+                PRINT_ERROR("The constraints option 'stabilizationFreq' must be positive.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            float64_t const & regularization =
+                boost::get<float64_t>(constraintsOptions.at("regularization"));
+            if (regularization < 0.0)
+            {
+                PRINT_ERROR("The constraints option 'regularization' must be positive.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
         }
-        float64_t const & stabilizationFreq =
-            boost::get<float64_t>(constraintsOptions.at("stabilizationFreq"));
-        if (stabilizationFreq < 0.0)
+        else if (group == "contacts")
         {
-            PRINT_ERROR("The constraints option 'stabilizationFreq' must be positive.");
-            return hresult_t::ERROR_BAD_INPUT;
+            configHolder_t const & contactsOptions = groupOptions;
+
+            // Make sure the contact model is available
+            std::string const & contactModel = boost::get<std::string>(contactsOptions.at("model"));
+            if (CONTACT_MODELS_MAP.find(contactModel) == CONTACT_MODELS_MAP.end())
+            {
+                PRINT_ERROR("The requested contact model is not available.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            float64_t const & contactsTransitionEps =
+                boost::get<float64_t>(contactsOptions.at("transitionEps"));
+            if (contactsTransitionEps < 0.0)
+            {
+                PRINT_ERROR("The contacts option 'transitionEps' must be positive.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            float64_t const & transitionVelocity =
+                boost::get<float64_t>(contactsOptions.at("transitionVelocity"));
+            if (transitionVelocity < EPS)
+            {
+                PRINT_ERROR("The contacts option 'transitionVelocity' must be strictly positive.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
         }
-        float64_t const & regularization =
-            boost::get<float64_t>(constraintsOptions.at("regularization"));
-        if (regularization < 0.0)
+        else if (group == "world")
         {
-            PRINT_ERROR("The constraints option 'regularization' must be positive.");
-            return hresult_t::ERROR_BAD_INPUT;
-        }
+            configHolder_t const & worldOptions = groupOptions;
 
-        // Make sure the contacts options are fine
-        configHolder_t contactsOptions = boost::get<configHolder_t>(engineOptions.at("contacts"));
-        std::string const & contactModel = boost::get<std::string>(contactsOptions.at("model"));
-        auto const contactModelIt = CONTACT_MODELS_MAP.find(contactModel);
-        if (contactModelIt == CONTACT_MODELS_MAP.end())
-        {
-            PRINT_ERROR("The requested contact model is not available.");
-            return hresult_t::ERROR_BAD_INPUT;
+            // Make sure the user-defined gravity force has the right dimension
+            vectorN_t const & gravity = boost::get<vectorN_t>(worldOptions.at("gravity"));
+            if (gravity.size() != 6)
+            {
+                PRINT_ERROR("The size of the gravity force vector must be 6.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
         }
-        float64_t const & contactsTransitionEps =
-            boost::get<float64_t>(contactsOptions.at("transitionEps"));
-        if (contactsTransitionEps < 0.0)
+
+        return hresult_t::SUCCESS;
+    }
+
+    void EngineMultiRobot::refreshOptionsProxies(void)
+    {
+        // Backup contact model as enum for fast check
+        contactModel_ = CONTACT_MODELS_MAP.at(engineOptions_->contacts.model);
+
+        // Set breakpoint period during the integration loop
+        stepperUpdatePeriod_ = std::get<1>(isGcdIncluded(
+            systemsDataHolder_,
+            engineOptions_->stepper.controllerUpdatePeriod,
+            engineOptions_->stepper.sensorsUpdatePeriod));
+    }
+
+    hresult_t EngineMultiRobot::setOptions(configHolder_t const & engineOptions)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (isSimulationRunning_)
         {
-            PRINT_ERROR("The contacts option 'transitionEps' must be positive.");
-            return hresult_t::ERROR_BAD_INPUT;
+            PRINT_ERROR("A simulation is running. Please stop it before updating the options.");
+            return hresult_t::ERROR_GENERIC;
         }
-        float64_t const & transitionVelocity =
-            boost::get<float64_t>(contactsOptions.at("transitionVelocity"));
-        if (transitionVelocity < EPS)
+
+        // Make sure every group of options is valid
+        for (auto const & group : std::array<std::string, 4>{{
+                "stepper", "constraints", "contacts", "world"}})
         {
-            PRINT_ERROR("The contacts option 'transitionVelocity' must be strictly positive.");
-            return hresult_t::ERROR_BAD_INPUT;
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = checkOptions(group, boost::get<configHolder_t>(engineOptions.at(group)));
+            }
         }
-
-        // Make sure the user-defined gravity force has the right dimension
-        configHolder_t worldOptions = boost::get<configHolder_t>(engineOptions.at("world"));
-        vectorN_t gravity = boost::get<vectorN_t>(worldOptions.at("gravity"));
-        if (gravity.size() != 6)
+        if (returnCode != hresult_t::SUCCESS)
         {
-            PRINT_ERROR("The size of the gravity force vector must be 6.");
-            return hresult_t::ERROR_BAD_INPUT;
+            return returnCode;
         }
 
         /* Reset random number generators if setOptions is called for the first time,
            or if the desired random seed has changed. */
-        uint32_t randomSeed = boost::get<uint32_t>(stepperOptions.at("randomSeed"));
+        configHolder_t const & stepperOptions = boost::get<configHolder_t>(engineOptions.at("stepper"));
+        uint32_t const & randomSeed = boost::get<uint32_t>(stepperOptions.at("randomSeed"));
         if (!engineOptions_ || randomSeed != engineOptions_->stepper.randomSeed)
         {
             resetRandomGenerators(randomSeed);
@@ -2787,16 +3389,85 @@ namespace jiminy
 
         // Create a fast struct accessor
         engineOptions_ = std::make_unique<engineOptions_t const>(engineOptionsHolder_);
+        optionsVersion_ = generateVersion();
 
-        // Backup contact model as enum for fast check
-        contactModel_ = contactModelIt->second;
-
-        // Set breakpoint period during the integration loop
-        stepperUpdatePeriod_ = minUpdatePeriod;
+        // Update the info extracted from the options
+        refreshOptionsProxies();
 
         return hresult_t::SUCCESS;
     }
 
+    hresult_t EngineMultiRobot::setOption(std::string   const & path,
+                                          configField_t const & value)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (isSimulationRunning_)
+        {
+            PRINT_ERROR("A simulation is running. Please stop it before updating the options.");
+            returnCode = hresult_t::ERROR_GENERIC;
+        }
+
+        configField_t * field = nullptr;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getConfigField(engineOptionsHolder_, path, field);
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            if (field->which() != value.which())
+            {
+                PRINT_ERROR("The type of the new value of option '", path, "' does not match the current one.");
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        /* Get the group of options the option belongs to.
+           Note that it necessarily exists at this point, since the option does. */
+        std::string const group = path.substr(0, path.find('/'));
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            configHolder_t const & groupOptions = boost::get<configHolder_t>(engineOptionsHolder_.at(group));
+
+            /* Update the option in-place, then check its group of options only, since the options
+               of a group may depend on each other but not on the other groups. Restore the
+               previous value if invalid. */
+            configField_t valuePrev = value;
+            std::swap(*field, valuePrev);
+            returnCode = checkOptions(group, groupOptions);
+            if (returnCode != hresult_t::SUCCESS)
+            {
+                std::swap(*field, valuePrev);
+            }
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            // Reset random number generators if the desired random seed has changed
+            if (group == "stepper")
+            {
+                configHolder_t const & stepperOptions = boost::get<configHolder_t>(engineOptionsHolder_.at(group));
+                uint32_t const & randomSeed = boost::get<uint32_t>(stepperOptions.at("randomSeed"));
+                if (randomSeed != engineOptions_->stepper.randomSeed)
+                {
+                    resetRandomGenerators(randomSeed);
+                }
+            }
+
+            // Update the fast struct accessor, only reading the group of options that has changed
+            engineOptions_ = std::make_unique<engineOptions_t const>(
+                *engineOptions_, engineOptionsHolder_, group);
+            optionsVersion_ = generateVersion();
+
+            // Update the info extracted from the options
+            refreshOptionsProxies();
+        }
+
+        return returnCode;
+    }
+
     std::vector<std::string> EngineMultiRobot::getSystemsNames(void) const
     {
         std::vector<std::string> systemsNames;
@@ -2905,14 +3576,18 @@ namespace jiminy
     {
         auto qSplitIt = stepperState_.qSplit.begin();
         auto vSplitIt = stepperState_.vSplit.begin();
+        auto sSplitIt = stepperState_.sSplit.begin();
         auto aSplitIt = stepperState_.aSplit.begin();
+        auto dsSplitIt = stepperState_.dsSplit.begin();
         auto systemDataIt = systemsDataHolder_.begin();
         for ( ; systemDataIt != systemsDataHolder_.end();
-             ++systemDataIt, ++qSplitIt, ++vSplitIt, ++aSplitIt)
+             ++systemDataIt, ++qSplitIt, ++vSplitIt, ++sSplitIt, ++aSplitIt, ++dsSplitIt)
         {
             *qSplitIt = systemDataIt->state.q;
             *vSplitIt = systemDataIt->state.v;
+            *sSplitIt = systemDataIt->state.s;
             *aSplitIt = systemDataIt->state.a;
+            *dsSplitIt = systemDataIt->state.ds;
         }
     }
 
@@ -2921,25 +3596,35 @@ namespace jiminy
         if (sync_acceleration_only)
         {
             auto aSplitIt = stepperState_.aSplit.begin();
+            auto dsSplitIt = stepperState_.dsSplit.begin();
             auto systemDataIt = systemsDataHolder_.begin();
             for ( ; systemDataIt != systemsDataHolder_.end();
-                ++systemDataIt, ++aSplitIt)
+                ++systemDataIt, ++aSplitIt, ++dsSplitIt)
             {
                 systemDataIt->state.a = *aSplitIt;
+                systemDataIt->state.ds = *dsSplitIt;
             }
         }
         else
         {
+            /* The internal state of the motors is owned by the stepper, but it is also
+               propagated to the motors, so that it can be queried directly from them. */
             auto qSplitIt = stepperState_.qSplit.begin();
             auto vSplitIt = stepperState_.vSplit.begin();
+            auto sSplitIt = stepperState_.sSplit.begin();
             auto aSplitIt = stepperState_.aSplit.begin();
+            auto dsSplitIt = stepperState_.dsSplit.begin();
+            auto systemIt = systems_.begin();
             auto systemDataIt = systemsDataHolder_.begin();
             for ( ; systemDataIt != systemsDataHolder_.end();
-                ++systemDataIt, ++qSplitIt, ++vSplitIt, ++aSplitIt)
+                ++systemIt, ++systemDataIt, ++qSplitIt, ++vSplitIt, ++sSplitIt, ++aSplitIt, ++dsSplitIt)
             {
                 systemDataIt->state.q = *qSplitIt;
                 systemDataIt->state.v = *vSplitIt;
+                systemDataIt->state.s = *sSplitIt;
                 systemDataIt->state.a = *aSplitIt;
+                systemDataIt->state.ds = *dsSplitIt;
+                systemIt->robot->setMotorsState(*sSplitIt);
             }
         }
     }
@@ -3192,6 +3877,500 @@ namespace jiminy
         }
     }
 
+    void EngineMultiRobot::computeContactDynamicsAtFrames(systemHolder_t     const & system,
+                                                          systemDataHolder_t       & systemData,
+                                                          forceVector_t            & fext) const
+    {
+        /* Batched version of `computeContactDynamicsAtFrame` specialized for spring-damper
+           contact model. The kinematics of all the contact frames is gathered first in
+           structure-of-arrays buffers, then the contact law is evaluated for every frames
+           at once, and finally the forces are scattered onto their parent joints.
+           /!\ It must remain consistent with `computeContactDynamics`. /!\ */
+
+        // Define proxies for convenience
+        pinocchio::Model const & model = system.robot->pncModel_;
+        pinocchio::Data const & data = system.robot->pncData_;
+        contactOptions_t const & contactOptions_ = engineOptions_->contacts;
+        std::vector<frameIndex_t> const & contactFramesIdx = system.robot->getContactFramesIdx();
+        contactFramesBatch_t & batch = systemData.contactFramesBatch;
+
+        // Early return if there is no contact frame
+        if (contactFramesIdx.empty())
+        {
+            return;
+        }
+
+        // Gather position, linear velocity and ground profile at every contact frames
+        for (std::size_t i = 0; i < contactFramesIdx.size(); ++i)
+        {
+            pinocchio::Frame const & frame = model.frames[contactFramesIdx[i]];
+            vector3_t const & posFrame = data.oMf[contactFramesIdx[i]].translation();
+            auto ground = engineOptions_->world.groundProfile(posFrame);
+            batch.pos.col(i) = posFrame;
+            batch.zGround[i] = std::get<float64_t>(ground);
+            batch.nGround.col(i) = std::get<vector3_t>(ground).normalized();
+
+            /* Compute the linear velocity of the contact point in world frame directly
+               from the spatial velocity of the parent joint. It is equivalent to
+               `oMf.rotation() * getFrameVelocity(...).linear()` but cheaper. */
+            pinocchio::Motion const & motionJointLocal = data.v[frame.parent];
+            batch.vel.col(i).noalias() = data.oMi[frame.parent].rotation() * (
+                motionJointLocal.linear() +
+                motionJointLocal.angular().cross(frame.placement.translation()));
+        }
+
+        // Compute the penetration depth and speed
+        batch.depth.array() = (batch.pos.row(2).transpose() - batch.zGround).array() *
+                              batch.nGround.row(2).transpose().array();
+        batch.vDepth = batch.vel.cwiseProduct(batch.nGround).colwise().sum().transpose();
+
+        // Compute normal forces, only if the penetration depth is negative
+        batch.fextNormal.array() = (batch.depth.array() < 0.0).select(
+            - (contactOptions_.stiffness * batch.depth.array() +
+               contactOptions_.damping * batch.vDepth.array()).min(0.0), 0.0);
+        batch.fextInWorld.noalias() = batch.nGround * batch.fextNormal.asDiagonal();
+
+        // Compute friction forces
+        batch.vTangential.noalias() = batch.vel - batch.nGround * batch.vDepth.asDiagonal();
+        batch.fextTangential.array() = contactOptions_.friction * batch.fextNormal.array() * (
+            batch.vTangential.colwise().norm().transpose().array() /
+            contactOptions_.transitionVelocity).min(1.0);
+        batch.fextInWorld.noalias() -= batch.vTangential * batch.fextTangential.asDiagonal();
+
+        // Add blending factor
+        if (contactOptions_.transitionEps > EPS)
+        {
+            batch.fextInWorld.array().rowwise() *= (
+                - 2.0 / contactOptions_.transitionEps * batch.depth.transpose().array()).tanh();
+        }
+
+        // Scatter the ground reaction forces onto the parent joints, in local joint frame
+        for (std::size_t i = 0; i < contactFramesIdx.size(); ++i)
+        {
+            pinocchio::Frame const & frame = model.frames[contactFramesIdx[i]];
+            pinocchio::Force & fextLocal = systemData.contactFramesForces[i];
+
+            /* Same as `convertForceGlobalFrameToJoint`, but taking advantage of the
+               ground reaction force being a pure force (without torque). */
+            fextLocal.linear().noalias() = data.oMi[frame.parent].rotation().transpose() *
+                                           batch.fextInWorld.col(i);
+            fextLocal.angular() = frame.placement.translation().cross(fextLocal.linear());
+
+            // Apply the force at the origin of the parent joint frame, in local joint frame
+            fext[frame.parent] += fextLocal;
+
+            // Convert contact force from the global frame to the local frame to store it in contactForces_
+            system.robot->contactForces_[i] = frame.placement.actInv(fextLocal);
+        }
+    }
+
+    void EngineMultiRobot::computeContactFramesDepth(systemHolder_t const & system,
+                                                     vectorN_t            & depth,
+                                                     vectorN_t            & depthRate) const
+    {
+        // Define proxies for convenience
+        pinocchio::Model const & model = system.robot->pncModel_;
+        pinocchio::Data const & data = system.robot->pncData_;
+        std::vector<frameIndex_t> const & contactFramesIdx = system.robot->getContactFramesIdx();
+
+        depth.resize(contactFramesIdx.size());
+        depthRate.resize(contactFramesIdx.size());
+        for (std::size_t i = 0; i < contactFramesIdx.size(); ++i)
+        {
+            // Compute the ground normal and penetration depth at the contact point
+            pinocchio::Frame const & frame = model.frames[contactFramesIdx[i]];
+            vector3_t const & posFrame = data.oMf[contactFramesIdx[i]].translation();
+            auto ground = engineOptions_->world.groundProfile(posFrame);
+            float64_t const & zGround = std::get<float64_t>(ground);
+            vector3_t & nGround = std::get<vector3_t>(ground);
+            nGround.normalize();
+            depth[i] = (posFrame[2] - zGround) * nGround[2];
+
+            // Compute the penetration speed, neglecting the curvature of the ground
+            pinocchio::Motion const & motionJointLocal = data.v[frame.parent];
+            vector3_t const vContactInWorld = data.oMi[frame.parent].rotation() * (
+                motionJointLocal.linear() +
+                motionJointLocal.angular().cross(frame.placement.translation()));
+            depthRate[i] = vContactInWorld.dot(nGround);
+        }
+    }
+
+    static float64_t computeHermiteRoot(float64_t const & y0,
+                                        float64_t const & dy0,
+                                        float64_t const & y1,
+                                        float64_t const & dy1,
+                                        float64_t const & dt)
+    {
+        /* Find the root of the cubic Hermite interpolant over [0, 1], assuming the
+           values at both ends have opposite signs. Illinois variant of the regula
+           falsi method is used since it is guaranteed to converge superlinearly. */
+        auto const hermite = [&](float64_t const & s) -> float64_t
+            {
+                float64_t const s2 = s * s;
+                float64_t const s3 = s2 * s;
+                return (2.0 * s3 - 3.0 * s2 + 1.0) * y0 + (s3 - 2.0 * s2 + s) * dt * dy0 +
+                       (3.0 * s2 - 2.0 * s3) * y1 + (s3 - s2) * dt * dy1;
+            };
+
+        float64_t sLow = 0.0, yLow = y0;
+        float64_t sHigh = 1.0, yHigh = y1;
+        float64_t s = 0.0;
+        int32_t side = 0;
+        for (uint32_t i = 0; i < 100U; ++i)
+        {
+            s = (sLow * yHigh - sHigh * yLow) / (yHigh - yLow);
+            if ((sHigh - sLow) * dt < STEPPER_MIN_TIMESTEP)
+            {
+                break;
+            }
+            float64_t const y = hermite(s);
+            if (std::abs(y) < EPS)
+            {
+                break;
+            }
+            if (y * yHigh > 0.0)
+            {
+                sHigh = s;
+                yHigh = y;
+                if (side == -1)
+                {
+                    yLow *= 0.5;
+                }
+                side = -1;
+            }
+            else
+            {
+                sLow = s;
+                yLow = y;
+                if (side == 1)
+                {
+                    yHigh *= 0.5;
+                }
+                side = 1;
+            }
+        }
+        return s;
+    }
+
+    bool_t EngineMultiRobot::detectContactEvents(float64_t const & dt,
+                                                 float64_t       & dtEvent)
+    {
+        bool_t isEventDetected = false;
+        dtEvent = dt;
+
+        auto systemIt = systems_.begin();
+        auto systemDataIt = systemsDataHolder_.begin();
+        for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt)
+        {
+            // Compute the penetration depth at the end of the step
+            vectorN_t & depthNext = systemDataIt->contactFramesDepthNext;
+            vectorN_t & depthRateNext = systemDataIt->contactFramesDepthRateNext;
+            computeContactFramesDepth(*systemIt, depthNext, depthRateNext);
+
+            // Locate the earliest zero crossing of the penetration depth, if any
+            vectorN_t const & depth = systemDataIt->contactFramesDepth;
+            vectorN_t const & depthRate = systemDataIt->contactFramesDepthRate;
+            for (Eigen::Index i = 0; i < depth.size(); ++i)
+            {
+                if ((depth[i] < 0.0) != (depthNext[i] < 0.0))
+                {
+                    float64_t const dtRoot = dt * computeHermiteRoot(
+                        depth[i], depthRate[i], depthNext[i], depthRateNext[i], dt);
+
+                    /* Ignore events too close to the boundaries of the step, since it
+                       means that the step is already ending up at the event. */
+                    if (SIMULATION_MIN_TIMESTEP < dtRoot && dtRoot < dt - SIMULATION_MIN_TIMESTEP)
+                    {
+                        dtEvent = std::min(dtEvent, dtRoot);
+                        isEventDetected = true;
+                    }
+                }
+            }
+        }
+
+        // Backup the penetration depth at the end of the step if it is accepted
+        if (!isEventDetected)
+        {
+            for (auto & systemData : systemsDataHolder_)
+            {
+                systemData.contactFramesDepth.swap(systemData.contactFramesDepthNext);
+                systemData.contactFramesDepthRate.swap(systemData.contactFramesDepthRateNext);
+            }
+        }
+
+        return isEventDetected;
+    }
+
+    void EngineMultiRobot::stepMultiRate(float64_t const & tNext,
+                                         uint32_t        & successiveIterFailed,
+                                         bool_t          & isNan)
+    {
+        float64_t const & t = stepperState_.t;
+        multiRateState_.tNext = tNext;
+
+        // Integrate the systems having the largest step size first
+        std::vector<std::size_t> & systemsOrder = multiRateState_.systemsOrder;
+        std::vector<float64_t> & dtSplit = stepperState_.dtSplit;
+        std::iota(systemsOrder.begin(), systemsOrder.end(), 0U);
+        std::stable_sort(systemsOrder.begin(), systemsOrder.end(),
+                         [&dtSplit](std::size_t const & i, std::size_t const & j)
+                         {
+                             return dtSplit[i] > dtSplit[j];
+                         });
+        std::fill(multiRateState_.isSystemIntegrated.begin(),
+                  multiRateState_.isSystemIntegrated.end(), false);
+
+        /* Backup the state of the systems at the beginning of the macro step. The state and the
+           kinematics of the systems are partially updated while integrating each of them, so they
+           must be restored if the macro step fails. */
+        for (auto & systemData : systemsDataHolder_)
+        {
+            systemData.stateMacroStepStart = systemData.state;
+        }
+        auto const restoreMacroStepStart =
+            [this]()
+            {
+                auto systemIt = systems_.begin();
+                auto systemDataIt = systemsDataHolder_.begin();
+                auto qSplitIt = stepperState_.qSplit.begin();
+                auto vSplitIt = stepperState_.vSplit.begin();
+                for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt, ++qSplitIt, ++vSplitIt)
+                {
+                    systemDataIt->state = systemDataIt->stateMacroStepStart;
+                    computeForwardKinematics(*systemIt, *qSplitIt, *vSplitIt, systemDataIt->state.a);
+                    systemIt->robot->setMotorsState(systemDataIt->state.s);
+                }
+            };
+
+        for (std::size_t const & systemIdx : systemsOrder)
+        {
+            // Initialize the state of the system at the beginning of the macro step
+            std::vector<vectorN_t> & qSystem = multiRateState_.qSystem;
+            std::vector<vectorN_t> & vSystem = multiRateState_.vSystem;
+            std::vector<vectorN_t> & sSystem = multiRateState_.sSystem;
+            std::vector<vectorN_t> & aSystem = multiRateState_.aSystem;
+            std::vector<vectorN_t> & dsSystem = multiRateState_.dsSystem;
+            qSystem[0] = stepperState_.qSplit[systemIdx];
+            vSystem[0] = stepperState_.vSplit[systemIdx];
+            sSystem[0] = stepperState_.sSplit[systemIdx];
+            aSystem[0] = stepperState_.aSplit[systemIdx];
+            dsSystem[0] = stepperState_.dsSplit[systemIdx];
+            float64_t tSystem = t;
+            float64_t & dtSystem = dtSplit[systemIdx];
+
+            // Compute the next steps using adaptive step method
+            while (tNext - tSystem > STEPPER_MIN_TIMESTEP)
+            {
+                // Adjust stepsize to end up exactly at the next breakpoint
+                dtSystem = min(dtSystem, tNext - tSystem);
+                if (tNext - (tSystem + dtSystem) < SIMULATION_MIN_TIMESTEP)
+                {
+                    dtSystem = tNext - tSystem;
+                }
+
+                /* Stop if dt is getting too small, in case of timeout, or in case
+                   of too many successive failed inner iteration.
+                   Don't worry, an exception will be raised later. */
+                if (dtSystem < STEPPER_MIN_TIMESTEP)
+                {
+                    stepperState_.dt = dtSystem;
+                    restoreMacroStepStart();
+                    return;
+                }
+                timer_->toc();
+                if (EPS < engineOptions_->stepper.timeout
+                    && engineOptions_->stepper.timeout < timer_->dt)
+                {
+                    restoreMacroStepStart();
+                    return;
+                }
+                if (successiveIterFailed > engineOptions_->stepper.successiveIterFailedMax)
+                {
+                    restoreMacroStepStart();
+                    return;
+                }
+
+                // Try doing one integration step
+                float64_t dtLargest = dtSystem;
+                bool_t const isStepSuccessful = multiRateState_.steppers[systemIdx]->tryStep(
+                    qSystem, vSystem, sSystem, aSystem, dsSystem, tSystem, dtLargest);
+
+                // Check if the integrator failed miserably even if successfully
+                isNan = std::isnan(dtLargest);
+                if (isNan)
+                {
+                    restoreMacroStepStart();
+                    return;
+                }
+
+                // Update the failed iteration counters
+                if (isStepSuccessful)
+                {
+                    successiveIterFailed = 0;
+                }
+                else
+                {
+                    ++successiveIterFailed;
+                    ++stepperState_.iterFailed;
+                }
+
+                // Initialize the next dt
+                dtSystem = min(dtLargest, engineOptions_->stepper.dtMax);
+            }
+
+            // Backup the state of the system at the end of the macro step
+            multiRateState_.qSplitNext[systemIdx] = qSystem[0];
+            multiRateState_.vSplitNext[systemIdx] = vSystem[0];
+            multiRateState_.sSplitNext[systemIdx] = sSystem[0];
+            multiRateState_.isSystemIntegrated[systemIdx] = true;
+        }
+
+        // Synchronize the systems at the end of the macro step
+        stepperState_.t = tNext;
+        stepperState_.qSplit.swap(multiRateState_.qSplitNext);
+        stepperState_.vSplit.swap(multiRateState_.vSplitNext);
+        stepperState_.sSplit.swap(multiRateState_.sSplitNext);
+        computeSystemsDynamics(stepperState_.t,
+                               stepperState_.qSplit,
+                               stepperState_.vSplit,
+                               stepperState_.sSplit,
+                               stepperState_.aSplit,
+                               stepperState_.dsSplit);
+        computeAllExtraTerms(systems_, systemsDataHolder_);
+        syncAllAccelerationsAndForces(systems_, fPrev_, aPrev_);
+        syncSystemsStateWithStepper();
+        stepperState_.dt = *std::min_element(dtSplit.begin(), dtSplit.end());
+
+        // Backup the stepper and systems' state
+        ++stepperState_.iter;
+        stepperState_.tPrev = stepperState_.t;
+        for (auto & systemData : systemsDataHolder_)
+        {
+            systemData.statePrev = systemData.state;
+        }
+    }
+
+    void EngineMultiRobot::updateDenseOutputSamples(float64_t const & tStepStart,
+                                                    float64_t const & tNext)
+    {
+        float64_t & t = stepperState_.t;
+        float64_t const tStepEnd = t;
+        float64_t const & sensorsUpdatePeriod = engineOptions_->stepper.sensorsUpdatePeriod;
+
+        // Get the first update time strictly after the beginning of the step
+        float64_t tSample = tStepStart + stepperUpdatePeriod_ - std::fmod(tStepStart, stepperUpdatePeriod_);
+        if (tSample - tStepStart < STEPPER_MIN_TIMESTEP)
+        {
+            tSample += stepperUpdatePeriod_;
+        }
+
+        /* Loop over all the update times within the step, excluding the next
+           breakpoint since the sensors and the telemetry are updated there anyway. */
+        bool_t hasSampled = false;
+        for ( ; tSample < tStepEnd + STEPPER_MIN_TIMESTEP && tSample < tNext - STEPPER_MIN_TIMESTEP;
+             tSample += stepperUpdatePeriod_)
+        {
+            // Interpolate the state of the systems, including the acceleration
+            if (!stepper_->interpolate(tSample, qSplitInterp_, vSplitInterp_, sSplitInterp_,
+                                       aSplitInterp_, dsSplitInterp_))
+            {
+                break;
+            }
+
+            // Backup the state of the systems at the end of the step
+            if (!hasSampled)
+            {
+                for (auto & systemData : systemsDataHolder_)
+                {
+                    systemData.stateEnd = systemData.state;
+                }
+                hasSampled = true;
+            }
+
+            /* Update the individual system states. The efforts and external forces are not part
+               of the state of the stepper, so they are linearly interpolated between both ends
+               of the step, whereas the command is constant since the controller is a breakpoint. */
+            float64_t const ratio = (tSample - tStepStart) / (tStepEnd - tStepStart);
+            auto systemIt = systems_.begin();
+            auto systemDataIt = systemsDataHolder_.begin();
+            auto qSplitIt = qSplitInterp_.begin();
+            auto vSplitIt = vSplitInterp_.begin();
+            auto sSplitIt = sSplitInterp_.begin();
+            auto aSplitIt = aSplitInterp_.begin();
+            auto dsSplitIt = dsSplitInterp_.begin();
+            for ( ; systemIt != systems_.end();
+                 ++systemIt, ++systemDataIt, ++qSplitIt, ++vSplitIt, ++sSplitIt, ++aSplitIt, ++dsSplitIt)
+            {
+                systemState_t & state = systemDataIt->state;
+                systemState_t const & stateStart = systemDataIt->statePrev;
+                systemState_t const & stateEnd = systemDataIt->stateEnd;
+                state.q = *qSplitIt;
+                state.v = *vSplitIt;
+                state.s = *sSplitIt;
+                state.a = *aSplitIt;
+                state.ds = *dsSplitIt;
+                state.u = (1.0 - ratio) * stateStart.u + ratio * stateEnd.u;
+                state.uMotor = (1.0 - ratio) * stateStart.uMotor + ratio * stateEnd.uMotor;
+                state.uInternal = (1.0 - ratio) * stateStart.uInternal + ratio * stateEnd.uInternal;
+                state.uCustom = (1.0 - ratio) * stateStart.uCustom + ratio * stateEnd.uCustom;
+                for (std::size_t i = 0; i < state.fExternal.size(); ++i)
+                {
+                    state.fExternal[i].toVector() = (1.0 - ratio) * stateStart.fExternal[i].toVector()
+                                                  + ratio * stateEnd.fExternal[i].toVector();
+                }
+
+                /* Update the kinematics only, without evaluating the dynamics, so that the
+                   controller, the force profiles and the constraint solver are not affected. */
+                pinocchio::Model const & model = systemIt->robot->pncModel_;
+                pinocchio::Data & data = systemIt->robot->pncData_;
+                pinocchio::forwardKinematics(model, data, state.q, state.v, state.a);
+                pinocchio::updateFramePlacements(model, data);
+            }
+
+            // Update the sensors data if necessary
+            float64_t const dtNextSensorsUpdatePeriod = sensorsUpdatePeriod - std::fmod(tSample, sensorsUpdatePeriod);
+            if (dtNextSensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP
+            || sensorsUpdatePeriod - dtNextSensorsUpdatePeriod < STEPPER_MIN_TIMESTEP)
+            {
+                systemIt = systems_.begin();
+                systemDataIt = systemsDataHolder_.begin();
+                for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt)
+                {
+                    vectorN_t const & q = systemDataIt->state.q;
+                    vectorN_t const & v = systemDataIt->state.v;
+                    vectorN_t const & a = systemDataIt->state.a;
+                    vectorN_t const & uMotor = systemDataIt->state.uMotor;
+                    forceVector_t const & fext = systemDataIt->state.fExternal;
+                    systemIt->robot->setSensorsData(tSample, q, v, a, uMotor, fext);
+                }
+            }
+
+            // Update the telemetry, unless every stepper state is already logged
+            if (!engineOptions_->stepper.logInternalStepperSteps)
+            {
+                t = tSample;
+                updateTelemetry();
+                t = tStepEnd;
+            }
+        }
+
+        // Restore the state and the kinematics of the systems at the end of the step
+        if (hasSampled)
+        {
+            auto systemIt = systems_.begin();
+            auto systemDataIt = systemsDataHolder_.begin();
+            for ( ; systemIt != systems_.end(); ++systemIt, ++systemDataIt)
+            {
+                systemState_t & state = systemDataIt->state;
+                state = systemDataIt->stateEnd;
+                pinocchio::Model const & model = systemIt->robot->pncModel_;
+                pinocchio::Data & data = systemIt->robot->pncData_;
+                pinocchio::forwardKinematics(model, data, state.q, state.v, state.a);
+                pinocchio::updateFramePlacements(model, data);
+            }
+        }
+    }
+
     pinocchio::Force EngineMultiRobot::computeContactDynamics(vector3_t const & nGround,
                                                               float64_t const & depth,
                                                               vector3_t const & vContactInWorld) const
@@ -3550,21 +4729,29 @@ namespace jiminy
     {
         // Compute the forces at contact points
         std::vector<frameIndex_t> const & contactFramesIdx = system.robot->getContactFramesIdx();
-        for (std::size_t i = 0; i < contactFramesIdx.size(); ++i)
+        if (contactModel_ == contactModel_t::SPRING_DAMPER)
         {
-            // Compute force at the given contact frame.
-            frameIndex_t const & frameIdx = contactFramesIdx[i];
-            auto & constraint = systemData.constraintsHolder.contactFrames[i].second;
-            pinocchio::Force & fextLocal = systemData.contactFramesForces[i];
-            computeContactDynamicsAtFrame(system, frameIdx, constraint, fextLocal);
+            // Compute the forces of all the contact frames at once
+            computeContactDynamicsAtFrames(system, systemData, fext);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < contactFramesIdx.size(); ++i)
+            {
+                // Compute force at the given contact frame.
+                frameIndex_t const & frameIdx = contactFramesIdx[i];
+                auto & constraint = systemData.constraintsHolder.contactFrames[i].second;
+                pinocchio::Force & fextLocal = systemData.contactFramesForces[i];
+                computeContactDynamicsAtFrame(system, frameIdx, constraint, fextLocal);
 
-            // Apply the force at the origin of the parent joint frame, in local joint frame
-            jointIndex_t const & parentJointIdx = system.robot->pncModel_.frames[frameIdx].parent;
-            fext[parentJointIdx] += fextLocal;
+                // Apply the force at the origin of the parent joint frame, in local joint frame
+                jointIndex_t const & parentJointIdx = system.robot->pncModel_.frames[frameIdx].parent;
+                fext[parentJointIdx] += fextLocal;
 
-            // Convert contact force from the global frame to the local frame to store it in contactForces_
-            pinocchio::SE3 const & transformContactInJoint = system.robot->pncModel_.frames[frameIdx].placement;
-            system.robot->contactForces_[i] = transformContactInJoint.actInv(fextLocal);
+                // Convert contact force from the global frame to the local frame to store it in contactForces_
+                pinocchio::SE3 const & transformContactInJoint = system.robot->pncModel_.frames[frameIdx].placement;
+                system.robot->contactForces_[i] = transformContactInJoint.actInv(fextLocal);
+            }
         }
 
         // Compute the force at collision bodies
@@ -3630,35 +4817,41 @@ namespace jiminy
         }
     }
 
-    void EngineMultiRobot::computeForcesCoupling(float64_t              const & t,
-                                                 std::vector<vectorN_t> const & qSplit,
-                                                 std::vector<vectorN_t> const & vSplit)
+    void EngineMultiRobot::computeForceCoupling(forceCoupling_t        const & forceCoupling,
+                                                float64_t              const & t,
+                                                std::vector<vectorN_t> const & qSplit,
+                                                std::vector<vectorN_t> const & vSplit,
+                                                bool_t                 const & isAppliedToFirst,
+                                                bool_t                 const & isAppliedToSecond)
     {
-        for (auto & forceCoupling : forcesCoupling_)
-        {
-            // Extract info about the first system involved
-            int32_t const & systemIdx1 = forceCoupling.systemIdx1;
-            systemHolder_t const & system1 = systems_[systemIdx1];
-            vectorN_t const & q1 = qSplit[systemIdx1];
-            vectorN_t const & v1 = vSplit[systemIdx1];
-            frameIndex_t const & frameIdx1 = forceCoupling.frameIdx1;
-            forceVector_t & fext1 = systemsDataHolder_[systemIdx1].state.fExternal;
-
-            // Extract info about the second system involved
-            int32_t const & systemIdx2 = forceCoupling.systemIdx2;
-            systemHolder_t const & system2 = systems_[systemIdx2];
-            vectorN_t const & q2 = qSplit[systemIdx2];
-            vectorN_t const & v2 = vSplit[systemIdx2];
-            frameIndex_t const & frameIdx2 = forceCoupling.frameIdx2;
-            forceVector_t & fext2 = systemsDataHolder_[systemIdx2].state.fExternal;
-
-            // Compute the coupling force
-            pinocchio::Force force = forceCoupling.forceFct(t, q1, v1, q2, v2);
+        // Extract info about the first system involved
+        int32_t const & systemIdx1 = forceCoupling.systemIdx1;
+        systemHolder_t const & system1 = systems_[systemIdx1];
+        vectorN_t const & q1 = qSplit[systemIdx1];
+        vectorN_t const & v1 = vSplit[systemIdx1];
+        frameIndex_t const & frameIdx1 = forceCoupling.frameIdx1;
+        forceVector_t & fext1 = systemsDataHolder_[systemIdx1].state.fExternal;
+
+        // Extract info about the second system involved
+        int32_t const & systemIdx2 = forceCoupling.systemIdx2;
+        systemHolder_t const & system2 = systems_[systemIdx2];
+        vectorN_t const & q2 = qSplit[systemIdx2];
+        vectorN_t const & v2 = vSplit[systemIdx2];
+        frameIndex_t const & frameIdx2 = forceCoupling.frameIdx2;
+        forceVector_t & fext2 = systemsDataHolder_[systemIdx2].state.fExternal;
+
+        // Compute the coupling force
+        pinocchio::Force force = forceCoupling.forceFct(t, q1, v1, q2, v2);
+        if (isAppliedToFirst)
+        {
             jointIndex_t const & parentJointIdx1 = system1.robot->pncModel_.frames[frameIdx1].parent;
             fext1[parentJointIdx1] += convertForceGlobalFrameToJoint(
                 system1.robot->pncModel_, system1.robot->pncData_, frameIdx1, force);
+        }
 
-            // Move force from frame1 to frame2 to apply it to the second system
+        // Move force from frame1 to frame2 to apply it to the second system
+        if (isAppliedToSecond)
+        {
             force.toVector() *= -1;
             jointIndex_t const & parentJointIdx2 = system2.robot->pncModel_.frames[frameIdx2].parent;
             vector3_t const offset = system2.robot->pncData_.oMf[frameIdx2].translation() -
@@ -3669,6 +4862,16 @@ namespace jiminy
         }
     }
 
+    void EngineMultiRobot::computeForcesCoupling(float64_t              const & t,
+                                                 std::vector<vectorN_t> const & qSplit,
+                                                 std::vector<vectorN_t> const & vSplit)
+    {
+        for (auto const & forceCoupling : forcesCoupling_)
+        {
+            computeForceCoupling(forceCoupling, t, qSplit, vSplit, true, true);
+        }
+    }
+
     void EngineMultiRobot::computeAllTerms(float64_t              const & t,
                                            std::vector<vectorN_t> const & qSplit,
                                            std::vector<vectorN_t> const & vSplit)
@@ -3714,7 +4917,9 @@ namespace jiminy
     hresult_t EngineMultiRobot::computeSystemsDynamics(float64_t              const & t,
                                                        std::vector<vectorN_t> const & qSplit,
                                                        std::vector<vectorN_t> const & vSplit,
-                                                       std::vector<vectorN_t>       & aSplit)
+                                                       std::vector<vectorN_t> const & sSplit,
+                                                       std::vector<vectorN_t>       & aSplit,
+                                                       std::vector<vectorN_t>       & dsSplit)
     {
         /* - Note that the position of the free flyer is in world frame,
              whereas the velocities and accelerations are relative to
@@ -3727,8 +4932,9 @@ namespace jiminy
             return hresult_t::ERROR_INIT_FAILED;
         }
 
-        // Make sure memory has been allocated for the output acceleration
+        // Make sure memory has been allocated for the output acceleration and motor state derivative
         aSplit.resize(vSplit.size());
+        dsSplit.resize(sSplit.size());
 
         // Update the kinematics of each system
         auto systemIt = systems_.begin();
@@ -3753,72 +4959,179 @@ namespace jiminy
         systemDataIt = systemsDataHolder_.begin();
         qIt = qSplit.begin();
         vIt = vSplit.begin();
+        auto sIt = sSplit.begin();
         auto fPrevIt = fPrev_.begin();
         auto aPrevIt = aPrev_.begin();
         auto aIt = aSplit.begin();
+        auto dsIt = dsSplit.begin();
         for ( ; systemIt != systems_.end();
-             ++systemIt, ++systemDataIt, ++qIt, ++vIt, ++aIt, ++fPrevIt, ++aPrevIt)
+             ++systemIt, ++systemDataIt, ++qIt, ++vIt, ++sIt, ++aIt, ++dsIt, ++fPrevIt, ++aPrevIt)
         {
-            // Define some proxies
-            vectorN_t & u = systemDataIt->state.u;
-            vectorN_t & command = systemDataIt->state.command;
-            vectorN_t & uMotor = systemDataIt->state.uMotor;
-            vectorN_t & uInternal = systemDataIt->state.uInternal;
-            vectorN_t & uCustom = systemDataIt->state.uCustom;
-            forceVector_t & fext = systemDataIt->state.fExternal;
-            vectorN_t const & aPrev = systemDataIt->statePrev.a;
-            vectorN_t const & uMotorPrev = systemDataIt->statePrev.uMotor;
-            forceVector_t const & fextPrev = systemDataIt->statePrev.fExternal;
+            computeSystemDynamics(*systemIt, *systemDataIt, *fPrevIt, *aPrevIt,
+                                  t, *qIt, *vIt, *sIt, *aIt, *dsIt);
+        }
 
-            /* Update the sensor data if necessary (only for infinite update frequency).
-               Note that it is impossible to have access to the current accelerations
-               and efforts since they depend on the sensor values themselves. */
-            if (engineOptions_->stepper.sensorsUpdatePeriod < EPS)
-            {
-                // Roll back to forces and accelerations computed at previous iteration
-                fPrevIt->swap(systemIt->robot->pncData_.f);
-                aPrevIt->swap(systemIt->robot->pncData_.a);
+        return hresult_t::SUCCESS;
+    }
 
-                // Update sensors based on previous accelerations and forces
-                systemIt->robot->setSensorsData(t, *qIt, *vIt, aPrev, uMotorPrev, fextPrev);
+    void EngineMultiRobot::computeSystemDynamics(systemHolder_t           & system,
+                                                 systemDataHolder_t       & systemData,
+                                                 forceVector_t            & fPrevJoints,
+                                                 motionVector_t           & aPrevJoints,
+                                                 float64_t          const & t,
+                                                 vectorN_t          const & q,
+                                                 vectorN_t          const & v,
+                                                 vectorN_t          const & s,
+                                                 vectorN_t                & a,
+                                                 vectorN_t                & ds)
+    {
+        // Define some proxies
+        vectorN_t & u = systemData.state.u;
+        vectorN_t & command = systemData.state.command;
+        vectorN_t & uMotor = systemData.state.uMotor;
+        vectorN_t & uInternal = systemData.state.uInternal;
+        vectorN_t & uCustom = systemData.state.uCustom;
+        forceVector_t & fext = systemData.state.fExternal;
+        vectorN_t const & aPrev = systemData.statePrev.a;
+        vectorN_t const & uMotorPrev = systemData.statePrev.uMotor;
+        forceVector_t const & fextPrev = systemData.statePrev.fExternal;
 
-                // Restore current forces and accelerations
-                fPrevIt->swap(systemIt->robot->pncData_.f);
-                aPrevIt->swap(systemIt->robot->pncData_.a);
-            }
+        /* Update the sensor data if necessary (only for infinite update frequency).
+           Note that it is impossible to have access to the current accelerations
+           and efforts since they depend on the sensor values themselves. */
+        if (engineOptions_->stepper.sensorsUpdatePeriod < EPS)
+        {
+            // Roll back to forces and accelerations computed at previous iteration
+            fPrevJoints.swap(system.robot->pncData_.f);
+            aPrevJoints.swap(system.robot->pncData_.a);
 
-            /* Update the controller command if necessary (only for infinite update frequency).
-               Make sure that the sensor state has been updated beforehand. */
-            if (engineOptions_->stepper.controllerUpdatePeriod < EPS)
-            {
-                computeCommand(*systemIt, t, *qIt, *vIt, command);
-            }
+            // Update sensors based on previous accelerations and forces
+            system.robot->setSensorsData(t, q, v, aPrev, uMotorPrev, fextPrev);
+
+            // Restore current forces and accelerations
+            fPrevJoints.swap(system.robot->pncData_.f);
+            aPrevJoints.swap(system.robot->pncData_.a);
+        }
+
+        /* Update the controller command if necessary (only for infinite update frequency).
+           Make sure that the sensor state has been updated beforehand. */
+        if (engineOptions_->stepper.controllerUpdatePeriod < EPS)
+        {
+            computeCommand(system, t, q, v, command);
+        }
+
+        /* Compute the actual motor effort and the derivative of their internal state.
+           Note that it is impossible to have access to the current accelerations. */
+        system.robot->computeMotorsEfforts(t, q, v, aPrev, s, command);
+        uMotor = system.robot->getMotorsEfforts();
+        ds = system.robot->getMotorsStateDerivative();
+
+        /* Compute the user-defined internal dynamics.
+           Make sure that the sensor state has been updated beforehand since
+           the user-defined internal dynamics may rely on it. */
+        uCustom.setZero();
+        if (system.controller->getHasInternalDynamics())
+        {
+            system.controller->internalDynamics(t, q, v, uCustom);
+        }
 
-            /* Compute the actual motor effort.
-               Note that it is impossible to have access to the current accelerations. */
-            systemIt->robot->computeMotorsEfforts(t, *qIt, *vIt, aPrev, command);
-            uMotor = systemIt->robot->getMotorsEfforts();
+        // Compute the total effort vector
+        u = uInternal + uCustom;
+        for (auto const & motor : system.robot->getMotors())
+        {
+            std::size_t const & motorIdx = motor->getIdx();
+            int32_t const & motorVelocityIdx = motor->getJointVelocityIdx();
+            u[motorVelocityIdx] += uMotor[motorIdx];
+        }
+
+        // Compute the dynamics
+        a = computeAcceleration(system, systemData, q, v, u, fext);
+    }
 
-            /* Compute the user-defined internal dynamics.
-               Make sure that the sensor state has been updated beforehand since
-               the user-defined internal dynamics may rely on it. */
-            uCustom.setZero();
-            systemIt->controller->internalDynamics(t, *qIt, *vIt, uCustom);
+    void EngineMultiRobot::computeSystemDynamicsMultiRate(std::size_t            const & systemIdx,
+                                                          float64_t              const & t,
+                                                          std::vector<vectorN_t> const & qSplit,
+                                                          std::vector<vectorN_t> const & vSplit,
+                                                          std::vector<vectorN_t> const & sSplit,
+                                                          std::vector<vectorN_t>       & aSplit,
+                                                          std::vector<vectorN_t>       & dsSplit)
+    {
+        // The stepper state is only updated once every system reached the end of the macro step
+        float64_t const & tStart = stepperState_.t;
+        float64_t const dtStart = t - tStart;
+        float64_t const ratio = dtStart / (multiRateState_.tNext - tStart);
 
-            // Compute the total effort vector
-            u = uInternal + uCustom;
-            for (auto const & motor : systemIt->robot->getMotors())
+        // Define some proxies
+        systemHolder_t & system = systems_[systemIdx];
+        systemDataHolder_t & systemData = systemsDataHolder_[systemIdx];
+        vectorN_t const & q = qSplit[0];
+        vectorN_t const & v = vSplit[0];
+        qSplitInterp_[systemIdx] = q;
+        vSplitInterp_[systemIdx] = v;
+
+        /* Estimate the state of the systems coupled to the one being integrated at the current
+           time, then update their frame placements, which are involved in the coupling forces.
+           The other systems are held at the beginning of the macro step since they do not
+           affect the dynamics of the system being integrated. */
+        for (std::size_t const & i : multiRateState_.coupledSystemsIdx[systemIdx])
+        {
+            pinocchio::Model const & model = systems_[i].robot->pncModel_;
+            pinocchio::Data & data = systems_[i].robot->pncData_;
+            vectorN_t & qOther = qSplitInterp_[i];
+            vectorN_t & vOther = vSplitInterp_[i];
+            vectorN_t const & qStart = stepperState_.qSplit[i];
+            vectorN_t const & vStart = stepperState_.vSplit[i];
+            vectorN_t & dq = multiRateState_.dqSplit[i];
+            if (multiRateState_.isSystemIntegrated[i])
             {
-                std::size_t const & motorIdx = motor->getIdx();
-                int32_t const & motorVelocityIdx = motor->getJointVelocityIdx();
-                u[motorVelocityIdx] += uMotor[motorIdx];
+                // Interpolate linearly over the macro step since the system has already been integrated
+                vectorN_t const & qNext = multiRateState_.qSplitNext[i];
+                vectorN_t const & vNext = multiRateState_.vSplitNext[i];
+                pinocchio::difference(model, qStart, qNext, dq);
+                dq *= ratio;
+                vOther = vStart + ratio * (vNext - vStart);
             }
+            else
+            {
+                // Extrapolate at constant acceleration since the system has not been integrated yet
+                vectorN_t const & aStart = stepperState_.aSplit[i];
+                dq = dtStart * (vStart + (0.5 * dtStart) * aStart);
+                vOther = vStart + dtStart * aStart;
+            }
+            pinocchio::integrate(model, qStart, dq, qOther);
+            pinocchio::forwardKinematics(model, data, qOther, vOther);
+            pinocchio::updateFramePlacements(model, data);
+        }
+
+        // Update the kinematics of the system being integrated
+        computeForwardKinematics(system, q, v, systemData.statePrev.a);
 
-            // Compute the dynamics
-            *aIt = computeAcceleration(*systemIt, *systemDataIt, *qIt, *vIt, u, fext);
+        // Reinitialize the external forces and internal efforts of the system being integrated
+        forceVector_t & fext = systemData.state.fExternal;
+        vectorN_t & uInternal = systemData.state.uInternal;
+        for (pinocchio::Force & fext_i : fext)
+        {
+            fext_i.setZero();
         }
+        uInternal.setZero();
 
-        return hresult_t::SUCCESS;
+        // Compute the coupling forces applied on the system being integrated only
+        for (std::size_t const & forceCouplingIdx : multiRateState_.forcesCouplingIdx[systemIdx])
+        {
+            forceCoupling_t const & forceCoupling = forcesCoupling_[forceCouplingIdx];
+            computeForceCoupling(forceCoupling, t, qSplitInterp_, vSplitInterp_,
+                                 static_cast<std::size_t>(forceCoupling.systemIdx1) == systemIdx,
+                                 static_cast<std::size_t>(forceCoupling.systemIdx2) == systemIdx);
+        }
+
+        // Compute the internal dynamics, the collision forces and the external forces
+        computeInternalDynamics(system, systemData, t, q, v, uInternal);
+        computeCollisionForces(system, systemData, fext);
+        computeExternalForces(system, systemData, t, q, v, fext);
+
+        // Compute the dynamics of the system being integrated
+        computeSystemDynamics(system, systemData, fPrev_[systemIdx], aPrev_[systemIdx],
+                              t, q, v, sSplit[0], aSplit[0], dsSplit[0]);
     }
 
     vectorN_t const & EngineMultiRobot::computeAcceleration(systemHolder_t & system,
@@ -3833,24 +5146,14 @@ namespace jiminy
 
         if (system.robot->hasConstraints())
         {
-            // Define some proxies for convenience
-            matrix6N_t & jointJacobian = systemData.jointJacobian;
-
             // Compute kinematic constraints
             system.robot->computeConstraints(q, v);
 
-            // Project external forces from cartesian space to joint space
+            /* Project external forces from cartesian space to joint space.
+               Note that it must be done before calling `nonLinearEffects`,
+               since it overwrites `data.f`. */
             data.u = u;
-            for (int32_t i = 1; i < model.njoints; ++i)
-            {
-                jointJacobian.setZero();
-                pinocchio::getJointJacobian(model,
-                                            data,
-                                            i,
-                                            pinocchio::LOCAL,
-                                            jointJacobian);
-                data.u.noalias() += jointJacobian.transpose() * fext[i].toVector();
-            }
+            pinocchio_overload::projectExternalForces(model, data, fext);
 
             // Compute non-linear effects
             pinocchio::nonLinearEffects(model, data, q, v);
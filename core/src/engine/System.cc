@@ -100,6 +100,39 @@ namespace jiminy
         // Empty on purpose
     }
 
+    // ===============================================
+    // ============= contactFramesBatch_t ============
+    // ===============================================
+
+    contactFramesBatch_t::contactFramesBatch_t(void) :
+    pos(),
+    vel(),
+    nGround(),
+    vTangential(),
+    fextInWorld(),
+    zGround(),
+    depth(),
+    vDepth(),
+    fextNormal(),
+    fextTangential()
+    {
+        // Empty on purpose.
+    }
+
+    void contactFramesBatch_t::resize(Eigen::Index const & nFrames)
+    {
+        pos.setZero(3, nFrames);
+        vel.setZero(3, nFrames);
+        nGround.setZero(3, nFrames);
+        vTangential.setZero(3, nFrames);
+        fextInWorld.setZero(3, nFrames);
+        zGround.setZero(nFrames);
+        depth.setZero(nFrames);
+        vDepth.setZero(nFrames);
+        fextNormal.setZero(nFrames);
+        fextTangential.setZero(nFrames);
+    }
+
     // ===============================================
     // ================ systemState_t ================
     // ===============================================
@@ -108,6 +141,8 @@ namespace jiminy
     q(),
     v(),
     a(),
+    s(),
+    ds(),
     command(),
     u(),
     uMotor(),
@@ -130,6 +165,8 @@ namespace jiminy
         q = pinocchio::neutral(robot.pncModel_);
         v.setZero(robot.nv());
         a.setZero(robot.nv());
+        s = robot.getMotorsState();
+        ds.setZero(robot.ns());
         command.setZero(robot.getMotorsNames().size());
         u.setZero(robot.nv());
         uMotor.setZero(robot.getMotorsNames().size());
@@ -152,6 +189,8 @@ namespace jiminy
         q.resize(0);
         v.resize(0);
         a.resize(0);
+        s.resize(0);
+        ds.resize(0);
         command.resize(0);
         u.resize(0);
         uMotor.resize(0);
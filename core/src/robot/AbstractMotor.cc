@@ -1,21 +1,47 @@
+#include <algorithm>
+#include <typeindex>
+
 #include "jiminy/core/robot/Robot.h"
 #include "jiminy/core/Macros.h"
 
 #include "jiminy/core/utilities/Pinocchio.h"
+#include "jiminy/core/utilities/Helpers.h"
 #include "jiminy/core/robot/AbstractMotor.h"
 
 
 namespace jiminy
 {
+    void refreshMotorsGroups(MotorSharedDataHolder_t & sharedHolder)
+    {
+        // Gather the motors by type, preserving their order
+        std::vector<std::type_index> motorsTypes;
+        sharedHolder.motorsGroups_.clear();
+        for (AbstractMotorBase * motor : sharedHolder.motors_)
+        {
+            std::type_index const motorType(typeid(*motor));
+            auto motorTypeIt = std::find(motorsTypes.begin(), motorsTypes.end(), motorType);
+            if (motorTypeIt == motorsTypes.end())
+            {
+                motorsTypes.push_back(motorType);
+                sharedHolder.motorsGroups_.emplace_back();
+                motorTypeIt = std::prev(motorsTypes.end());
+            }
+            sharedHolder.motorsGroups_[std::distance(motorsTypes.begin(), motorTypeIt)].push_back(motor);
+        }
+    }
+
     AbstractMotorBase::AbstractMotorBase(std::string const & name) :
     baseMotorOptions_(nullptr),
     motorOptionsHolder_(),
+    optionsVersion_(0U),
     isInitialized_(false),
     isAttached_(false),
     robot_(),
     notifyRobot_(),
     name_(name),
     motorIdx_(0),
+    stateSize_(0),
+    stateIdx_(0),
     jointName_(),
     jointModelIdx_(0),
     jointType_(joint_t::NONE),
@@ -68,9 +94,18 @@ namespace jiminy
         sharedHolder_->data_.conservativeResize(sharedHolder_->num_ + 1);
         sharedHolder_->data_.tail<1>().setZero();
 
+        // Add the internal state of the motor at the end of the shared state buffers
+        stateIdx_ = sharedHolder_->state_.size();
+        for (vectorN_t * buffer : {&sharedHolder_->state_, &sharedHolder_->stateDerivative_})
+        {
+            buffer->conservativeResize(stateIdx_ + stateSize_);
+            buffer->tail(stateSize_).setZero();
+        }
+
         // Add the motor to the shared memory
         sharedHolder_->motors_.push_back(this);
         ++sharedHolder_->num_;
+        refreshMotorsGroups(*sharedHolder_);
 
         // Update the flag
         isAttached_ = true;
@@ -97,15 +132,26 @@ namespace jiminy
         }
         sharedHolder_->data_.conservativeResize(sharedHolder_->num_ - 1);
 
-        // Shift the motor ids
+        // Remove the internal state of the motor from the shared state buffers
+        Eigen::Index const stateShift = sharedHolder_->state_.size() - stateIdx_ - stateSize_;
+        for (vectorN_t * buffer : {&sharedHolder_->state_, &sharedHolder_->stateDerivative_})
+        {
+            buffer->segment(stateIdx_, stateShift) =
+                buffer->segment(stateIdx_ + stateSize_, stateShift).eval();  // eval to avoid aliasing
+            buffer->conservativeResize(buffer->size() - stateSize_);
+        }
+
+        // Shift the motor ids and the indices of their internal state
         for (std::size_t i = motorIdx_ + 1; i < sharedHolder_->num_; ++i)
         {
             --sharedHolder_->motors_[i]->motorIdx_;
+            sharedHolder_->motors_[i]->stateIdx_ -= stateSize_;
         }
 
         // Remove the motor to the shared memory
         sharedHolder_->motors_.erase(std::next(sharedHolder_->motors_.begin(), motorIdx_));
         --sharedHolder_->num_;
+        refreshMotorsGroups(*sharedHolder_);
 
         // Clear the references to the robot and shared data
         robot_.reset();
@@ -137,8 +183,10 @@ namespace jiminy
             return hresult_t::ERROR_GENERIC;
         }
 
-        // Clear the shared data buffer
+        // Clear the shared data buffers
         sharedHolder_->data_.setZero();
+        sharedHolder_->state_.setZero();
+        sharedHolder_->stateDerivative_.setZero();
 
         // Update motor scope information
         for (AbstractMotorBase * motor : sharedHolder_->motors_)
@@ -147,7 +195,17 @@ namespace jiminy
             motor->refreshProxies();
         }
 
-        return hresult_t::SUCCESS;
+        // Reset the internal state of the motors and prepare their batched evaluation
+        hresult_t returnCode = hresult_t::SUCCESS;
+        for (auto const & motorsGroup : sharedHolder_->motorsGroups_)
+        {
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = motorsGroup.front()->resetBatch(motorsGroup);
+            }
+        }
+
+        return returnCode;
     }
 
     hresult_t AbstractMotorBase::setOptions(configHolder_t const & motorOptions)
@@ -178,6 +236,7 @@ namespace jiminy
         // Update the motor's options
         motorOptionsHolder_ = motorOptions;
         baseMotorOptions_ = std::make_unique<abstractMotorOptions_t const>(motorOptionsHolder_);
+        optionsVersion_ = generateVersion();
 
         // Refresh the proxies if the robot is initialized if available
         if (auto robot = robot_.lock())
@@ -196,6 +255,17 @@ namespace jiminy
         return motorOptionsHolder_;
     }
 
+    std::size_t const & AbstractMotorBase::getOptionsVersion(void) const
+    {
+        return optionsVersion_;
+    }
+
+    hresult_t AbstractMotorBase::attachCopy(Robot & /* robot */) const
+    {
+        PRINT_ERROR("Motor '", name_, "' does not support being copied.");
+        return hresult_t::ERROR_GENERIC;
+    }
+
     hresult_t AbstractMotorBase::refreshProxies(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -304,6 +374,22 @@ namespace jiminy
         return sharedHolder_->data_[motorIdx_];
     }
 
+    Eigen::VectorBlock<vectorN_t> AbstractMotorBase::state(void)
+    {
+        return sharedHolder_->state_.segment(stateIdx_, stateSize_);
+    }
+
+    Eigen::VectorBlock<vectorN_t const> AbstractMotorBase::state(void) const
+    {
+        vectorN_t const & stateAll = sharedHolder_->state_;
+        return stateAll.segment(stateIdx_, stateSize_);
+    }
+
+    Eigen::VectorBlock<vectorN_t> AbstractMotorBase::stateDerivative(void)
+    {
+        return sharedHolder_->stateDerivative_.segment(stateIdx_, stateSize_);
+    }
+
     vectorN_t const & AbstractMotorBase::getAll(void) const
     {
         return sharedHolder_->data_;
@@ -346,6 +432,16 @@ namespace jiminy
         return motorIdx_;
     }
 
+    Eigen::Index const & AbstractMotorBase::getStateSize(void) const
+    {
+        return stateSize_;
+    }
+
+    Eigen::Index const & AbstractMotorBase::getStateIdx(void) const
+    {
+        return stateIdx_;
+    }
+
     std::string const & AbstractMotorBase::getJointName(void) const
     {
         return jointName_;
@@ -396,8 +492,28 @@ namespace jiminy
             returnCode = hresult_t::ERROR_GENERIC;
         }
 
-        // Compute the actual effort of every motor
-        for (AbstractMotorBase * motor : sharedHolder_->motors_)
+        // Compute the actual effort of every motor, gathered by type
+        for (auto const & motorsGroup : sharedHolder_->motorsGroups_)
+        {
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = motorsGroup.front()->computeEffortBatch(t, q, v, a, command, motorsGroup);
+            }
+        }
+
+        return returnCode;
+    }
+
+    hresult_t AbstractMotorBase::computeEffortBatch(float64_t const & t,
+                                                    vectorN_t const & q,
+                                                    vectorN_t const & v,
+                                                    vectorN_t const & a,
+                                                    vectorN_t const & command,
+                                                    std::vector<AbstractMotorBase *> const & motors)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        for (AbstractMotorBase * motor : motors)
         {
             if (returnCode == hresult_t::SUCCESS)
             {
@@ -420,4 +536,9 @@ namespace jiminy
 
         return returnCode;
     }
+
+    hresult_t AbstractMotorBase::resetBatch(std::vector<AbstractMotorBase *> const & /* motors */)
+    {
+        return hresult_t::SUCCESS;
+    }
 }
@@ -1,6 +1,7 @@
 #include "jiminy/core/robot/Robot.h"
 
 #include "jiminy/core/utilities/Random.h"
+#include "jiminy/core/utilities/Helpers.h"
 #include "jiminy/core/robot/AbstractSensor.h"
 
 
@@ -9,6 +10,7 @@ namespace jiminy
     AbstractSensorBase::AbstractSensorBase(std::string const & name) :
     baseSensorOptions_(nullptr),
     sensorOptionsHolder_(),
+    optionsVersion_(0U),
     isInitialized_(false),
     isAttached_(false),
     isTelemetryConfigured_(false),
@@ -20,6 +22,12 @@ namespace jiminy
         setOptions(getDefaultSensorOptions());
     }
 
+    hresult_t AbstractSensorBase::attachCopy(Robot & /* robot */) const
+    {
+        PRINT_ERROR("Sensor '", name_, "' does not support being copied.");
+        return hresult_t::ERROR_GENERIC;
+    }
+
     hresult_t AbstractSensorBase::configureTelemetry(std::shared_ptr<TelemetryData> telemetryData,
                                                      std::string const & objectPrefixName)
     {
@@ -87,6 +95,7 @@ namespace jiminy
     {
         sensorOptionsHolder_ = sensorOptions;
         baseSensorOptions_ = std::make_unique<abstractSensorOptions_t const>(sensorOptionsHolder_);
+        optionsVersion_ = generateVersion();
         return hresult_t::SUCCESS;
     }
 
@@ -95,6 +104,11 @@ namespace jiminy
         return sensorOptionsHolder_;
     }
 
+    std::size_t const & AbstractSensorBase::getOptionsVersion(void) const
+    {
+        return optionsVersion_;
+    }
+
     bool_t const & AbstractSensorBase::getIsInitialized(void) const
     {
         return isInitialized_;
@@ -1,5 +1,8 @@
+#include <cmath>
 #include <algorithm>
+#include <typeinfo>
 
+#include "jiminy/core/robot/Robot.h"
 #include "jiminy/core/utilities/Helpers.h"
 
 #include "jiminy/core/robot/BasicMotors.h"
@@ -7,9 +10,40 @@
 
 namespace jiminy
 {
+    namespace
+    {
+        template<typename T>
+        hresult_t attachMotorCopy(T           const & motorOrig,
+                                  Robot             & robot,
+                                  std::string const & motorName,
+                                  std::string const & jointName)
+        {
+            hresult_t returnCode = hresult_t::SUCCESS;
+
+            /* Make sure the motor is not of a user-defined type deriving from a built-in one,
+               since it would be copied as the built-in type otherwise. */
+            if (typeid(motorOrig) != typeid(T))
+            {
+                PRINT_ERROR("Motor '", motorName, "' is of a user-defined type, which does not support being copied.");
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            auto motor = std::make_shared<T>(motorName);
+            returnCode = robot.attachMotor(motor);
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = motor->initialize(jointName);
+            }
+
+            return returnCode;
+        }
+    }
+
     SimpleMotor::SimpleMotor(std::string const & name) :
     AbstractMotorBase(name),
-    motorOptions_(nullptr)
+    motorOptions_(nullptr),
+    isBatchOutdated_(true),
+    batch_()
     {
         /* AbstractMotorBase constructor calls the base implementations of
            the virtual methods since the derived class is not available at
@@ -34,6 +68,11 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t SimpleMotor::attachCopy(Robot & robot) const
+    {
+        return attachMotorCopy<SimpleMotor>(*this, robot, name_, jointName_);
+    }
+
     hresult_t SimpleMotor::setOptions(configHolder_t const & motorOptions)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -74,6 +113,7 @@ namespace jiminy
         if (returnCode == hresult_t::SUCCESS)
         {
             motorOptions_ = std::make_unique<motorOptions_t const>(motorOptions);
+            isBatchOutdated_ = true;
         }
 
         return returnCode;
@@ -118,4 +158,364 @@ namespace jiminy
 
         return hresult_t::SUCCESS;
     }
+
+    hresult_t SimpleMotor::computeEffortBatch(float64_t const & t,
+                                              vectorN_t const & q,
+                                              vectorN_t const & v,
+                                              vectorN_t const & a,
+                                              vectorN_t const & command,
+                                              std::vector<AbstractMotorBase *> const & motors)
+    {
+        // Fallback to the generic implementation if the group has changed since the last reset
+        if (batch_.motors != motors)
+        {
+            return AbstractMotorBase::computeEffortBatch(t, q, v, a, command, motors);
+        }
+
+        // Pack the options again if some of them have changed since the last reset
+        if (std::any_of(motors.begin(), motors.end(),
+                        [](AbstractMotorBase const * motor)
+                        {
+                            return static_cast<SimpleMotor const *>(motor)->isBatchOutdated_;
+                        }))
+        {
+            packBatch(motors);
+        }
+
+        // Gather the inputs of every motors
+        for (std::size_t i = 0; i < motors.size(); ++i)
+        {
+            SimpleMotor const * motor = static_cast<SimpleMotor const *>(motors[i]);
+            batch_.velocity[i] = v[motor->jointVelocityIdx_];
+            batch_.command[i] = command[motor->motorIdx_];
+        }
+
+        // Compute the motor efforts on joint side, taking into account the limit, if any
+        batch_.effort.array() = batch_.mechanicalReduction.array() *
+            batch_.command.array().min(batch_.commandLimit.array()).max(- batch_.commandLimit.array());
+
+        /* Add friction to the joints associated with the motors. The coefficients
+           of the motors for which it is disabled are zero. */
+        auto velocity = batch_.velocity.array();
+        auto frictionDry = (batch_.frictionDrySlope.array() * velocity).tanh();
+        batch_.effort.array() += (velocity > 0.0).select(
+            batch_.frictionViscousPositive.array() * velocity + batch_.frictionDryPositive.array() * frictionDry,
+            batch_.frictionViscousNegative.array() * velocity + batch_.frictionDryNegative.array() * frictionDry);
+
+        // Scatter the efforts back to every motors
+        for (std::size_t i = 0; i < motors.size(); ++i)
+        {
+            static_cast<SimpleMotor *>(motors[i])->data() = batch_.effort[i];
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t SimpleMotor::resetBatch(std::vector<AbstractMotorBase *> const & motors)
+    {
+        // Pack the options of every motors, unless some of them are not initialized
+        batch_.motors.clear();
+        for (AbstractMotorBase const * motor : motors)
+        {
+            if (!motor->getIsInitialized())
+            {
+                return hresult_t::SUCCESS;
+            }
+        }
+        packBatch(motors);
+
+        return hresult_t::SUCCESS;
+    }
+
+    void SimpleMotor::packBatch(std::vector<AbstractMotorBase *> const & motors)
+    {
+        // Resize the buffers and copy the options of every motors
+        Eigen::Index const nMotors = static_cast<Eigen::Index>(motors.size());
+        for (vectorN_t * buffer : {&batch_.mechanicalReduction, &batch_.commandLimit,
+                                   &batch_.frictionViscousPositive, &batch_.frictionViscousNegative,
+                                   &batch_.frictionDryPositive, &batch_.frictionDryNegative,
+                                   &batch_.frictionDrySlope, &batch_.velocity, &batch_.command,
+                                   &batch_.effort})
+        {
+            buffer->setZero(nMotors);
+        }
+        for (Eigen::Index i = 0; i < nMotors; ++i)
+        {
+            SimpleMotor * motor = static_cast<SimpleMotor *>(motors[i]);
+            motorOptions_t const & options = *motor->motorOptions_;
+            batch_.mechanicalReduction[i] = options.mechanicalReduction;
+            batch_.commandLimit[i] = options.enableCommandLimit ? motor->commandLimit_ : INF;
+            if (options.enableFriction)
+            {
+                batch_.frictionViscousPositive[i] = options.frictionViscousPositive;
+                batch_.frictionViscousNegative[i] = options.frictionViscousNegative;
+                batch_.frictionDryPositive[i] = options.frictionDryPositive;
+                batch_.frictionDryNegative[i] = options.frictionDryNegative;
+                batch_.frictionDrySlope[i] = options.frictionDrySlope;
+            }
+            motor->isBatchOutdated_ = false;
+        }
+        batch_.motors = motors;
+    }
+
+    DCMotor::DCMotor(std::string const & name) :
+    AbstractMotorBase(name),
+    motorOptions_(nullptr),
+    isBatchOutdated_(true),
+    batch_()
+    {
+        /* AbstractMotorBase constructor calls the base implementations of
+           the virtual methods since the derived class is not available at
+           this point. Thus it must be called explicitly in the constructor. */
+        setOptions(getDefaultMotorOptions());
+
+        // The internal state gathers the current and the temperature of the winding
+        stateSize_ = 2;
+    }
+
+    hresult_t DCMotor::initialize(std::string const & jointName)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        jointName_ = jointName;
+        isInitialized_ = true;
+        returnCode = refreshProxies();
+
+        if (returnCode != hresult_t::SUCCESS)
+        {
+            jointName_.clear();
+            isInitialized_ = false;
+        }
+
+        return returnCode;
+    }
+
+    hresult_t DCMotor::attachCopy(Robot & robot) const
+    {
+        return attachMotorCopy<DCMotor>(*this, robot, name_, jointName_);
+    }
+
+    hresult_t DCMotor::setOptions(configHolder_t const & motorOptions)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        returnCode = AbstractMotorBase::setOptions(motorOptions);
+
+        // Check if the electrical and thermal parameters make sense
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            for (std::string const & name : {"torqueConstant",
+                                             "windingResistance",
+                                             "currentBandwidth",
+                                             "thermalResistance",
+                                             "thermalCapacitance"})
+            {
+                if (boost::get<float64_t>(motorOptions.at(name)) <= 0.0)
+                {
+                    PRINT_ERROR("'", name, "' must be strictly positive.");
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                }
+            }
+            if (boost::get<float64_t>(motorOptions.at("voltageLimit")) < 0.0)
+            {
+                PRINT_ERROR("'voltageLimit' must be positive.");
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            motorOptions_ = std::make_unique<motorOptions_t const>(motorOptions);
+            isBatchOutdated_ = true;
+        }
+
+        return returnCode;
+    }
+
+    float64_t const & DCMotor::getCurrent(void) const
+    {
+        static float64_t const currentEmpty = 0.0;
+        if (isAttached_)
+        {
+            return state().data()[0];
+        }
+        return currentEmpty;
+    }
+
+    float64_t const & DCMotor::getTemperature(void) const
+    {
+        if (isAttached_)
+        {
+            return state().data()[1];
+        }
+        return motorOptions_->ambientTemperature;
+    }
+
+    hresult_t DCMotor::computeEffort(float64_t const & /* t */,
+                                     Eigen::VectorBlock<vectorN_t const> const & /* q */,
+                                     float64_t const & v,
+                                     float64_t const & /* a */,
+                                     float64_t command)
+    {
+        if (!isInitialized_)
+        {
+            PRINT_ERROR("Motor not initialized. Impossible to compute actual motor effort.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // Get the internal state, which is integrated by the stepper of the engine
+        float64_t const current = state()[0];
+        float64_t const temperature = state()[1];
+        float64_t const resistance = motorOptions_->windingResistance * (1.0 +
+            motorOptions_->resistanceTemperatureCoeff * (temperature - motorOptions_->ambientTemperature));
+
+        // Compute the target current, taking into account the command limit, if any
+        if (motorOptions_->enableCommandLimit)
+        {
+            command = std::clamp(command, -commandLimit_, commandLimit_);
+        }
+        float64_t currentTarget = command / motorOptions_->torqueConstant;
+
+        /* Saturate the target current by the voltage left once the back-EMF has
+           been subtracted. It is computed on motor side, ie before the transmission. */
+        if (motorOptions_->enableVoltageLimit)
+        {
+            float64_t const backEMF = motorOptions_->torqueConstant * motorOptions_->mechanicalReduction * v;
+            currentTarget = std::clamp(currentTarget,
+                                       (- motorOptions_->voltageLimit - backEMF) / resistance,
+                                       (motorOptions_->voltageLimit - backEMF) / resistance);
+        }
+
+        // Compute the motor effort on joint side, ie after the transmission
+        data() = motorOptions_->mechanicalReduction * motorOptions_->torqueConstant * current;
+
+        // Compute the time derivative of the current loop and of the thermal model
+        stateDerivative()[0] = motorOptions_->currentBandwidth * (currentTarget - current);
+        stateDerivative()[1] = (resistance * current * current -
+            (temperature - motorOptions_->ambientTemperature) / motorOptions_->thermalResistance) /
+            motorOptions_->thermalCapacitance;
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t DCMotor::computeEffortBatch(float64_t const & t,
+                                          vectorN_t const & q,
+                                          vectorN_t const & v,
+                                          vectorN_t const & a,
+                                          vectorN_t const & command,
+                                          std::vector<AbstractMotorBase *> const & motors)
+    {
+        // Fallback to the generic implementation if the group has changed since the last reset
+        if (batch_.motors != motors)
+        {
+            return AbstractMotorBase::computeEffortBatch(t, q, v, a, command, motors);
+        }
+
+        // Pack the options again if some of them have changed since the last reset
+        if (std::any_of(motors.begin(), motors.end(),
+                        [](AbstractMotorBase const * motor)
+                        {
+                            return static_cast<DCMotor const *>(motor)->isBatchOutdated_;
+                        }))
+        {
+            packBatch(motors);
+        }
+
+        // Gather the inputs and the internal state of every motors
+        for (std::size_t i = 0; i < motors.size(); ++i)
+        {
+            DCMotor const * motor = static_cast<DCMotor const *>(motors[i]);
+            auto const motorState = motor->state();
+            batch_.velocity[i] = v[motor->jointVelocityIdx_];
+            batch_.command[i] = command[motor->motorIdx_];
+            batch_.current[i] = motorState[0];
+            batch_.temperature[i] = motorState[1];
+        }
+
+        // Compute the target currents, saturated by the command limit and the voltage left
+        batch_.resistance.array() = batch_.windingResistance.array() * (1.0 +
+            batch_.resistanceTemperatureCoeff.array() * (batch_.temperature - batch_.ambientTemperature).array());
+        auto backEMF = batch_.torqueConstant.array() * batch_.mechanicalReduction.array() * batch_.velocity.array();
+        batch_.currentTarget = (batch_.command.array().min(batch_.commandLimit.array())
+                                                      .max(- batch_.commandLimit.array())
+                                / batch_.torqueConstant.array())
+                               .min((batch_.voltageLimit.array() - backEMF) / batch_.resistance.array())
+                               .max((- batch_.voltageLimit.array() - backEMF) / batch_.resistance.array());
+
+        // Compute the motor efforts on joint side, then the time derivative of the internal states
+        batch_.effort.array() = batch_.mechanicalReduction.array() * batch_.torqueConstant.array() * batch_.current.array();
+        batch_.currentRate.array() = batch_.currentBandwidth.array() * (batch_.currentTarget - batch_.current).array();
+        batch_.temperatureRate.array() = (batch_.resistance.array() * batch_.current.array().square() -
+            (batch_.temperature - batch_.ambientTemperature).array() / batch_.thermalResistance.array()) /
+            batch_.thermalCapacitance.array();
+
+        // Scatter the efforts and the time derivatives back to every motors
+        for (std::size_t i = 0; i < motors.size(); ++i)
+        {
+            DCMotor * motor = static_cast<DCMotor *>(motors[i]);
+            motor->data() = batch_.effort[i];
+            auto motorStateDerivative = motor->stateDerivative();
+            motorStateDerivative[0] = batch_.currentRate[i];
+            motorStateDerivative[1] = batch_.temperatureRate[i];
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t DCMotor::resetBatch(std::vector<AbstractMotorBase *> const & motors)
+    {
+        // Reset the internal state of every motors
+        for (AbstractMotorBase * motorBase : motors)
+        {
+            DCMotor * motor = static_cast<DCMotor *>(motorBase);
+            auto motorState = motor->state();
+            motorState[0] = 0.0;
+            motorState[1] = motor->motorOptions_->ambientTemperature;
+        }
+
+        // Pack the options of every motors, unless some of them are not initialized
+        batch_.motors.clear();
+        for (AbstractMotorBase const * motor : motors)
+        {
+            if (!motor->getIsInitialized())
+            {
+                return hresult_t::SUCCESS;
+            }
+        }
+        packBatch(motors);
+
+        return hresult_t::SUCCESS;
+    }
+
+    void DCMotor::packBatch(std::vector<AbstractMotorBase *> const & motors)
+    {
+        // Resize the buffers and copy the options of every motors
+        Eigen::Index const nMotors = static_cast<Eigen::Index>(motors.size());
+        for (vectorN_t * buffer : {&batch_.torqueConstant, &batch_.mechanicalReduction, &batch_.commandLimit,
+                                   &batch_.voltageLimit, &batch_.windingResistance, &batch_.resistanceTemperatureCoeff,
+                                   &batch_.ambientTemperature, &batch_.currentBandwidth, &batch_.thermalResistance,
+                                   &batch_.thermalCapacitance, &batch_.velocity, &batch_.command, &batch_.current,
+                                   &batch_.temperature, &batch_.resistance, &batch_.currentTarget, &batch_.effort,
+                                   &batch_.currentRate, &batch_.temperatureRate})
+        {
+            buffer->setZero(nMotors);
+        }
+        for (Eigen::Index i = 0; i < nMotors; ++i)
+        {
+            DCMotor * motor = static_cast<DCMotor *>(motors[i]);
+            motorOptions_t const & options = *motor->motorOptions_;
+            batch_.torqueConstant[i] = options.torqueConstant;
+            batch_.mechanicalReduction[i] = options.mechanicalReduction;
+            batch_.commandLimit[i] = options.enableCommandLimit ? motor->commandLimit_ : INF;
+            batch_.voltageLimit[i] = options.enableVoltageLimit ? options.voltageLimit : INF;
+            batch_.windingResistance[i] = options.windingResistance;
+            batch_.resistanceTemperatureCoeff[i] = options.resistanceTemperatureCoeff;
+            batch_.ambientTemperature[i] = options.ambientTemperature;
+            batch_.currentBandwidth[i] = options.currentBandwidth;
+            batch_.thermalResistance[i] = options.thermalResistance;
+            batch_.thermalCapacitance[i] = options.thermalCapacitance;
+            motor->isBatchOutdated_ = false;
+        }
+        batch_.motors = motors;
+    }
 }
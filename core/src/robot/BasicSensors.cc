@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <typeinfo>
 
 #include "pinocchio/spatial/explog.hpp"    // `pinocchio::exp3`
 #include "pinocchio/spatial/se3.hpp"       // `pinocchio::SE3`
@@ -49,6 +50,14 @@
     }
 
 
+#define CHECK_SENSOR_INITIALIZED(sensor) \
+    if (!(sensor)->isInitialized_) \
+    { \
+        PRINT_ERROR("Sensor '", (sensor)->name_, "' not initialized. Impossible to update sensor."); \
+        return hresult_t::ERROR_INIT_FAILED; \
+    }
+
+
 #define GET_ROBOT_IF_INITIALIZED() \
     if (!isInitialized_) \
     { \
@@ -61,6 +70,35 @@
 
 namespace jiminy
 {
+    namespace
+    {
+        template<typename T>
+        hresult_t attachSensorCopy(T           const & sensorOrig,
+                                   Robot             & robot,
+                                   std::string const & sensorName,
+                                   std::string const & location)
+        {
+            hresult_t returnCode = hresult_t::SUCCESS;
+
+            /* Make sure the sensor is not of a user-defined type deriving from a built-in one,
+               since it would be copied as the built-in type otherwise. */
+            if (typeid(sensorOrig) != typeid(T))
+            {
+                PRINT_ERROR("Sensor '", sensorName, "' is of a user-defined type, which does not support being copied.");
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            auto sensor = std::make_shared<T>(sensorName);
+            returnCode = robot.attachSensor(sensor);
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = sensor->initialize(location);
+            }
+
+            return returnCode;
+        }
+    }
+
     // ===================== ImuSensor =========================
 
     template<>
@@ -97,6 +135,11 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t ImuSensor::attachCopy(Robot & robot) const
+    {
+        return attachSensorCopy<ImuSensor>(*this, robot, name_, frameName_);
+    }
+
     hresult_t ImuSensor::setOptions(configHolder_t const & sensorOptions)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -166,25 +209,65 @@ namespace jiminy
     {
         GET_ROBOT_IF_INITIALIZED()
 
+        computeData(*robot);
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t ImuSensor::setDataAll(float64_t     const & /* t */,
+                                    vectorN_t     const & /* q */,
+                                    vectorN_t     const & /* v */,
+                                    vectorN_t     const & /* a */,
+                                    vectorN_t     const & /* uMotor */,
+                                    forceVector_t const & /* fExternal */)
+    {
+        // Lock the robot only once for all the sensors
+        auto robot = robot_.lock();
+        if (!robot)
+        {
+            PRINT_ERROR("Robot has been deleted. Impossible to update sensors.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        for (AbstractSensorBase * sensorBase : sharedHolder_->sensors_)
+        {
+            ImuSensor * sensor = static_cast<ImuSensor *>(sensorBase);
+            CHECK_SENSOR_INITIALIZED(sensor)
+            sensor->computeData(*robot);
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    void ImuSensor::computeData(Robot const & robot)
+    {
         // Compute quaternion
-        matrix3_t const & rot = robot->pncData_.oMf[frameIdx_].rotation();
+        matrix3_t const & rot = robot.pncData_.oMf[frameIdx_].rotation();
         quaternion_t const quat(rot);  // Convert a rotation matrix to a quaternion
         data().head<4>() = quat.coeffs();  // (x,y,z,w)
 
         // Compute gyroscope signal
         pinocchio::Motion const velocity = pinocchio::getFrameVelocity(
-            robot->pncModel_, robot->pncData_, frameIdx_, pinocchio::LOCAL);
+            robot.pncModel_, robot.pncData_, frameIdx_, pinocchio::LOCAL);
         data().segment<3>(4) = velocity.angular();
 
         // Compute accelerometer signal
         pinocchio::Motion const acceleration = pinocchio::getFrameAcceleration(
-            robot->pncModel_, robot->pncData_, frameIdx_, pinocchio::LOCAL);
+            robot.pncModel_, robot.pncData_, frameIdx_, pinocchio::LOCAL);
 
         // Accelerometer signal is sensor linear acceleration (not spatial acceleration !) minus gravity
         data().tail<3>() = acceleration.linear() + velocity.angular().cross(velocity.linear())  // 'getFrameClassicalAcceleration'
-                           - quat.conjugate() * robot->pncModel_.gravity.linear();
+                           - quat.conjugate() * robot.pncModel_.gravity.linear();
+    }
 
-        return hresult_t::SUCCESS;
+    void ImuSensor::skewDataAll(void)
+    {
+        /* The bias and noise of the orientation are not additive, so each
+           sensor must be handled separately. */
+        for (AbstractSensorBase * sensorBase : sharedHolder_->sensors_)
+        {
+            static_cast<ImuSensor *>(sensorBase)->measureData();
+        }
     }
 
     void ImuSensor::measureData(void)
@@ -236,7 +319,8 @@ namespace jiminy
     ContactSensor::ContactSensor(std::string const & name) :
     AbstractSensorTpl(name),
     frameName_(),
-    frameIdx_(0)
+    frameIdx_(0),
+    contactIdx_(0)
     {
         // Empty on purpose
     }
@@ -258,6 +342,11 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t ContactSensor::attachCopy(Robot & robot) const
+    {
+        return attachSensorCopy<ContactSensor>(*this, robot, name_, frameName_);
+    }
+
     hresult_t ContactSensor::refreshProxies(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -273,6 +362,10 @@ namespace jiminy
                 PRINT_ERROR("Sensor frame not associated with any contact point of the robot. Impossible to refresh proxies.");
                 returnCode = hresult_t::ERROR_BAD_INPUT;
             }
+            else
+            {
+                contactIdx_ = std::distance(contactFramesNames.begin(), contactFrameNameIt);
+            }
         }
 
         if (returnCode == hresult_t::SUCCESS)
@@ -302,13 +395,47 @@ namespace jiminy
     {
         GET_ROBOT_IF_INITIALIZED()
 
-        std::vector<frameIndex_t> const & contactFramesIdx = robot->getContactFramesIdx();
-        auto it = std::find(contactFramesIdx.begin(), contactFramesIdx.end(), frameIdx_);
-        data() = robot->contactForces_[std::distance(contactFramesIdx.begin(), it)].linear();
+        computeData(*robot);
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t ContactSensor::setDataAll(float64_t     const & /* t */,
+                                        vectorN_t     const & /* q */,
+                                        vectorN_t     const & /* v */,
+                                        vectorN_t     const & /* a */,
+                                        vectorN_t     const & /* uMotor */,
+                                        forceVector_t const & /* fExternal */)
+    {
+        // Lock the robot only once for all the sensors
+        auto robot = robot_.lock();
+        if (!robot)
+        {
+            PRINT_ERROR("Robot has been deleted. Impossible to update sensors.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        for (AbstractSensorBase * sensorBase : sharedHolder_->sensors_)
+        {
+            ContactSensor * sensor = static_cast<ContactSensor *>(sensorBase);
+            CHECK_SENSOR_INITIALIZED(sensor)
+            sensor->computeData(*robot);
+        }
 
         return hresult_t::SUCCESS;
     }
 
+    void ContactSensor::skewDataAll(void)
+    {
+        // The bias and noise are additive and `measureData` is not overwritten
+        skewDataBatch();
+    }
+
+    void ContactSensor::computeData(Robot const & robot)
+    {
+        data() = robot.contactForces_[contactIdx_].linear();
+    }
+
     // ===================== ForceSensor =========================
 
     template<>
@@ -345,6 +472,11 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t ForceSensor::attachCopy(Robot & robot) const
+    {
+        return attachSensorCopy<ForceSensor>(*this, robot, name_, frameName_);
+    }
+
     hresult_t ForceSensor::refreshProxies(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -386,20 +518,57 @@ namespace jiminy
                                vectorN_t     const & /* uMotor */,
                                forceVector_t const & fExternal)
     {
-        // Returns the force applied on parent body in frame
-
         GET_ROBOT_IF_INITIALIZED()
 
+        computeData(*robot, fExternal);
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t ForceSensor::setDataAll(float64_t     const & /* t */,
+                                      vectorN_t     const & /* q */,
+                                      vectorN_t     const & /* v */,
+                                      vectorN_t     const & /* a */,
+                                      vectorN_t     const & /* uMotor */,
+                                      forceVector_t const & fExternal)
+    {
+        // Lock the robot only once for all the sensors
+        auto robot = robot_.lock();
+        if (!robot)
+        {
+            PRINT_ERROR("Robot has been deleted. Impossible to update sensors.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        for (AbstractSensorBase * sensorBase : sharedHolder_->sensors_)
+        {
+            ForceSensor * sensor = static_cast<ForceSensor *>(sensorBase);
+            CHECK_SENSOR_INITIALIZED(sensor)
+            sensor->computeData(*robot, fExternal);
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    void ForceSensor::skewDataAll(void)
+    {
+        // The bias and noise are additive and `measureData` is not overwritten
+        skewDataBatch();
+    }
+
+    void ForceSensor::computeData(Robot         const & robot,
+                                  forceVector_t const & fExternal)
+    {
+        // Returns the force applied on parent body in frame
+
         // Get the sum of external forces applied on parent joint
         jointIndex_t const & i = parentJointIdx_;
         pinocchio::Force const & fJoint = fExternal[i];
 
         // Transform the force from joint frame to sensor frame
-        pinocchio::SE3 const & framePlacement = robot->pncModel_.frames[frameIdx_].placement;
+        pinocchio::SE3 const & framePlacement = robot.pncModel_.frames[frameIdx_].placement;
         f_ = framePlacement.actInv(fJoint);
         data() = - f_.toVector();
-
-        return hresult_t::SUCCESS;
     }
 
     // ===================== EncoderSensor =========================
@@ -415,7 +584,9 @@ namespace jiminy
     AbstractSensorTpl(name),
     jointName_(),
     jointIdx_(0),
-    jointType_(joint_t::NONE)
+    jointType_(joint_t::NONE),
+    jointPositionIdx_(0),
+    jointVelocityIdx_(0)
     {
         // Empty on purpose
     }
@@ -437,6 +608,11 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t EncoderSensor::attachCopy(Robot & robot) const
+    {
+        return attachSensorCopy<EncoderSensor>(*this, robot, name_, jointName_);
+    }
+
     hresult_t EncoderSensor::refreshProxies(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -465,6 +641,13 @@ namespace jiminy
             }
         }
 
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            auto const & joint = robot->pncModel_.joints[jointIdx_];
+            jointPositionIdx_ = joint.idx_q();
+            jointVelocityIdx_ = joint.idx_v();
+        }
+
         return returnCode;
     }
 
@@ -490,24 +673,55 @@ namespace jiminy
                                  vectorN_t     const & /* uMotor */,
                                  forceVector_t const & /* fExternal */)
     {
-        GET_ROBOT_IF_INITIALIZED()
+        if (!isInitialized_)
+        {
+            PRINT_ERROR("Sensor not initialized. Impossible to set sensor data.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        computeData(q, v);
 
-        auto const & joint = robot->pncModel_.joints[jointIdx_];
-        int32_t const & jointPositionIdx = joint.idx_q();
-        int32_t const & jointVelocityIdx = joint.idx_v();
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t EncoderSensor::setDataAll(float64_t     const & /* t */,
+                                        vectorN_t     const & q,
+                                        vectorN_t     const & v,
+                                        vectorN_t     const & /* a */,
+                                        vectorN_t     const & /* uMotor */,
+                                        forceVector_t const & /* fExternal */)
+    {
+        for (AbstractSensorBase * sensorBase : sharedHolder_->sensors_)
+        {
+            EncoderSensor * sensor = static_cast<EncoderSensor *>(sensorBase);
+            CHECK_SENSOR_INITIALIZED(sensor)
+            sensor->computeData(q, v);
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    void EncoderSensor::skewDataAll(void)
+    {
+        // The bias and noise are additive and `measureData` is not overwritten
+        skewDataBatch();
+    }
+
+    void EncoderSensor::computeData(vectorN_t const & q,
+                                    vectorN_t const & v)
+    {
+        // Joint indices are cached when refreshing the proxies, so that the robot is not needed
         if (jointType_ == joint_t::ROTARY_UNBOUNDED)
         {
-            float64_t const & cosTheta = q[jointPositionIdx];
-            float64_t const & sinTheta = q[jointPositionIdx + 1];
+            float64_t const & cosTheta = q[jointPositionIdx_];
+            float64_t const & sinTheta = q[jointPositionIdx_ + 1];
             data()[0] = std::atan2(sinTheta, cosTheta);
         }
         else
         {
-            data()[0] = q[jointPositionIdx];
+            data()[0] = q[jointPositionIdx_];
         }
-        data()[1] = v[jointVelocityIdx];
-
-        return hresult_t::SUCCESS;
+        data()[1] = v[jointVelocityIdx_];
     }
 
     // ===================== EffortSensor =========================
@@ -544,6 +758,11 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t EffortSensor::attachCopy(Robot & robot) const
+    {
+        return attachSensorCopy<EffortSensor>(*this, robot, name_, motorName_);
+    }
+
     hresult_t EffortSensor::refreshProxies(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -587,8 +806,36 @@ namespace jiminy
             return hresult_t::ERROR_INIT_FAILED;
         }
 
-        data()[0] = uMotor[motorIdx_];
+        computeData(uMotor);
 
         return hresult_t::SUCCESS;
     }
+
+    hresult_t EffortSensor::setDataAll(float64_t     const & /* t */,
+                                       vectorN_t     const & /* q */,
+                                       vectorN_t     const & /* v */,
+                                       vectorN_t     const & /* a */,
+                                       vectorN_t     const & uMotor,
+                                       forceVector_t const & /* fExternal */)
+    {
+        for (AbstractSensorBase * sensorBase : sharedHolder_->sensors_)
+        {
+            EffortSensor * sensor = static_cast<EffortSensor *>(sensorBase);
+            CHECK_SENSOR_INITIALIZED(sensor)
+            sensor->computeData(uMotor);
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    void EffortSensor::skewDataAll(void)
+    {
+        // The bias and noise are additive and `measureData` is not overwritten
+        skewDataBatch();
+    }
+
+    void EffortSensor::computeData(vectorN_t const & uMotor)
+    {
+        data()[0] = uMotor[motorIdx_];
+    }
 }
@@ -1,5 +1,6 @@
 #include <fstream>
 #include <exception>
+#include <mutex>
 
 #include "pinocchio/spatial/symmetric3.hpp"                // `pinocchio::Symmetric3 `
 #include "pinocchio/spatial/explog.hpp"                    // `pinocchio::exp3`
@@ -41,6 +42,11 @@
 
 namespace jiminy
 {
+    /* Degrees of freedom fixed by the constraints associated with the contact points and the
+       collision bodies, namely the translation and the rotation around the normal. */
+    Eigen::Matrix<bool_t, 6, 1> const CONTACT_FIXED_DOFS_MASK =
+        (Eigen::Matrix<bool_t, 6, 1>() << true, true, true, false, false, true).finished();
+
     void constraintsHolder_t::clear(void)
     {
         boundJoints.clear();
@@ -175,6 +181,13 @@ namespace jiminy
         return constraintsMapPtr->end();
     }
 
+    struct Model::deferredVisualModel_t
+    {
+        std::mutex mutex;                ///< Guard preventing the model and its clones from building it concurrently
+        bool_t isLoaded = false;         ///< Whether the visual model has been built already
+        pinocchio::GeometryModel model;  ///< Visual model of the rigid model built from the URDF file
+    };
+
     Model::Model(void) :
     pncModelOrig_(),
     pncModel_(),
@@ -213,6 +226,20 @@ namespace jiminy
     velocityFieldnames_(),
     accelerationFieldnames_(),
     forceExternalFieldnames_(),
+    modelUpdateDepth_(0U),
+    isDataOrigStale_(false),
+    isModelFlexibleStale_(false),
+    isModelBiasedStale_(false),
+    areProxiesStale_(false),
+    areGeometryProxiesStale_(false),
+    areContactsProxiesStale_(false),
+    pncModelOrigHash_(0U),
+    geometryModelsVersion_(0U),
+    optionsVersion_(0U),
+    cacheDir_(),
+    loadVisualMeshes_(false),
+    nThreads_(1U),
+    visualModelDeferred_(nullptr),
     pncModelFlexibleOrig_(),
     jointsAcceleration_(),
     nq_(0),
@@ -247,11 +274,13 @@ namespace jiminy
             urdfData_ = "";
             hasFreeflyer_ = (rootJointType == joint_t::FREE);
             meshPackageDirs_.clear();
+            cacheDir_.clear();
 
             // Set the models
             pncModelOrig_ = pncModel;
             collisionModelOrig_ = collisionModel;
             visualModelOrig_ = visualModel;
+            visualModelDeferred_.reset();
 
             // Add ground geometry object to collision model is not already available
             if (!collisionModelOrig_.existGeometryName("ground"))
@@ -334,17 +363,31 @@ namespace jiminy
     hresult_t Model::initialize(std::string              const & urdfPath,
                                 bool_t                   const & hasFreeflyer,
                                 std::vector<std::string> const & meshPackageDirs,
-                                bool_t                   const & loadVisualMeshes)
+                                bool_t                   const & loadVisualMeshes,
+                                std::string              const & cacheDir,
+                                bool_t                   const & deferVisualModel,
+                                uint32_t                 const & nThreads)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
-        // Load new robot and collision models
+        /* Load new robot and collision models, along with the visual model unless deferred.
+           If so, it is only built on first access, since it is useless unless rendering,
+           and loading its meshes is expensive. */
         pinocchio::Model pncModel;
         pinocchio::GeometryModel pncCollisionModel;
         pinocchio::GeometryModel pncVisualModel;
-        returnCode = buildModelsFromUrdf(
-            urdfPath, hasFreeflyer, meshPackageDirs, pncModel,
-            pncCollisionModel, pncVisualModel, loadVisualMeshes);
+        if (deferVisualModel)
+        {
+            returnCode = buildModelsFromUrdf(
+                urdfPath, hasFreeflyer, meshPackageDirs, pncModel,
+                pncCollisionModel, std::nullopt, false, cacheDir, nThreads);
+        }
+        else
+        {
+            returnCode = buildModelsFromUrdf(
+                urdfPath, hasFreeflyer, meshPackageDirs, pncModel,
+                pncCollisionModel, pncVisualModel, loadVisualMeshes, cacheDir, nThreads);
+        }
 
         // Initialize jiminy model
         if (returnCode == hresult_t::SUCCESS)
@@ -360,11 +403,213 @@ namespace jiminy
             urdfData_ = std::string((std::istreambuf_iterator<char_t>(urdfFileStream)),
                                      std::istreambuf_iterator<char_t>());
             meshPackageDirs_ = meshPackageDirs;
+            cacheDir_ = cacheDir;
+            loadVisualMeshes_ = loadVisualMeshes;
+            nThreads_ = nThreads;
+            if (deferVisualModel)
+            {
+                visualModelDeferred_ = std::make_shared<deferredVisualModel_t>();
+            }
+        }
+
+        return returnCode;
+    }
+
+    hresult_t Model::copyFrom(Model const & model)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (!model.isInitialized_)
+        {
+            PRINT_ERROR("Model not initialized.");
+            returnCode = hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            if (!model.constraintsHolder_.registered.empty())
+            {
+                PRINT_ERROR("Impossible to copy a model having user-registered constraints.");
+                returnCode = hresult_t::ERROR_GENERIC;
+            }
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            // Clear existing constraints
+            constraintsHolder_.clear();
+            jointsAcceleration_.clear();
+
+            /* Copy the options without going through 'setOptions', since the models
+               must not be regenerated. */
+            mdlOptionsHolder_ = model.mdlOptionsHolder_;
+            mdlOptions_ = std::make_unique<modelOptions_t const>(mdlOptionsHolder_);
+            optionsVersion_ = generateVersion();
+
+            // Copy URDF info
+            urdfPath_ = model.urdfPath_;
+            urdfData_ = model.urdfData_;
+            meshPackageDirs_ = model.meshPackageDirs_;
+            cacheDir_ = model.cacheDir_;
+            hasFreeflyer_ = model.hasFreeflyer_;
+
+            /* Copy the models, including the biases added to the dynamics properties.
+               Note that the geometries are stored by shared pointer in pinocchio, so
+               that meshes and their BVH are not duplicated. */
+            pncModelOrig_ = model.pncModelOrig_;
+            pncModelFlexibleOrig_ = model.pncModelFlexibleOrig_;
+            pncModel_ = model.pncModel_;
+            pncModelOrigHash_ = model.pncModelOrigHash_;
+            collisionModelOrig_ = model.collisionModelOrig_;
+            visualModelOrig_ = model.visualModelOrig_;
+            loadVisualMeshes_ = model.loadVisualMeshes_;
+            nThreads_ = model.nThreads_;
+            visualModelDeferred_ = model.visualModelDeferred_;  // Built once for the model and its clones
+            pncDataOrig_ = model.pncDataOrig_;
+
+            // Copy the names used to generate the proxies
+            collisionBodiesNames_ = model.collisionBodiesNames_;
+            contactFramesNames_ = model.contactFramesNames_;
+            rigidJointsNames_ = model.rigidJointsNames_;
+            flexibleJointsNames_ = model.flexibleJointsNames_;
+
+            // Initialize Pinocchio Data internal state
+            pncData_ = pinocchio::Data(pncModel_);
+            pinocchio::forwardKinematics(pncModel_, pncData_,
+                                         pinocchio::neutral(pncModel_),
+                                         vectorN_t::Zero(pncModel_.nv));
+            pinocchio::updateFramePlacements(pncModel_, pncData_);
+            pinocchio::centerOfMass(pncModel_, pncData_,
+                                    pinocchio::neutral(pncModel_));
+
+            // Assume the model is fully initialized at this point
+            isInitialized_ = true;
+        }
+
+        /* Re-create the internal constraints, since they are bound to a given model.
+           Note that collision bodies are stored by body, so they must be added one by one. */
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            constraintsMap_t jointConstraintsMap;
+            jointConstraintsMap.reserve(model.constraintsHolder_.boundJoints.size());
+            for (auto const & constraintPair : model.constraintsHolder_.boundJoints)
+            {
+                std::string const & jointName = constraintPair.first;
+                jointConstraintsMap.emplace_back(jointName, std::make_shared<JointConstraint>(jointName));
+            }
+            returnCode = addConstraints(jointConstraintsMap, constraintsHolderType_t::BOUNDS_JOINTS);
+        }
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            constraintsMap_t frameConstraintsMap;
+            frameConstraintsMap.reserve(model.constraintsHolder_.contactFrames.size());
+            for (auto const & constraintPair : model.constraintsHolder_.contactFrames)
+            {
+                std::string const & frameName = constraintPair.first;
+                frameConstraintsMap.emplace_back(frameName, std::make_shared<FixedFrameConstraint>(
+                    frameName, CONTACT_FIXED_DOFS_MASK));
+            }
+            returnCode = addConstraints(frameConstraintsMap, constraintsHolderType_t::CONTACT_FRAMES);
+        }
+        for (constraintsMap_t const & collisionBody : model.constraintsHolder_.collisionBodies)
+        {
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                constraintsMap_t collisionConstraintsMap;
+                collisionConstraintsMap.reserve(collisionBody.size());
+                for (auto const & constraintPair : collisionBody)
+                {
+                    std::string const & frameName = constraintPair.first;
+                    collisionConstraintsMap.emplace_back(frameName, std::make_shared<FixedFrameConstraint>(
+                        frameName, CONTACT_FIXED_DOFS_MASK));
+                }
+                returnCode = addConstraints(collisionConstraintsMap, constraintsHolderType_t::COLLISION_BODIES);
+            }
+        }
+
+        // Refresh all proxies, including the collision and visual models and data
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = refreshProxies();
+        }
+
+        // Unset the initialization flag in case of failure
+        if (returnCode != hresult_t::SUCCESS)
+        {
+            constraintsHolder_.clear();
+            isInitialized_ = false;
         }
 
         return returnCode;
     }
 
+    void Model::beginModelUpdate(void)
+    {
+        ++modelUpdateDepth_;
+    }
+
+    hresult_t Model::endModelUpdate(void)
+    {
+        if (modelUpdateDepth_ == 0)
+        {
+            PRINT_ERROR("No batch of updates in progress.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        --modelUpdateDepth_;
+        return flushModelUpdates();
+    }
+
+    hresult_t Model::flushModelUpdates(void)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        // Nothing to do until the end of the batch of updates
+        if (modelUpdateDepth_ > 0)
+        {
+            return returnCode;
+        }
+
+        if (isDataOrigStale_)
+        {
+            pncDataOrig_ = pinocchio::Data(pncModelOrig_);
+        }
+
+        // Apply the most complete update only, since it includes all the others
+        if (isModelFlexibleStale_)
+        {
+            returnCode = regenerateModels();
+        }
+        else if (isModelBiasedStale_)
+        {
+            returnCode = generateModelBiased();
+        }
+        else if (areProxiesStale_)
+        {
+            returnCode = refreshProxies();
+        }
+        else
+        {
+            if (areGeometryProxiesStale_)
+            {
+                returnCode = refreshGeometryProxies();
+            }
+            if (returnCode == hresult_t::SUCCESS && areContactsProxiesStale_)
+            {
+                returnCode = refreshContactsProxies();
+            }
+        }
+
+        isDataOrigStale_ = false;
+        isModelFlexibleStale_ = false;
+        isModelBiasedStale_ = false;
+        areProxiesStale_ = false;
+        areGeometryProxiesStale_ = false;
+        areContactsProxiesStale_ = false;
+
+        return returnCode;
+    }
+
     void Model::reset(void)
     {
         /* Do NOT reset the constraints, since it will be handled by the engine.
@@ -374,13 +619,41 @@ namespace jiminy
 
         if (isInitialized_)
         {
-            /* Re-generate the true flexible model in case the original rigid
-               model has been manually modified by the user. */
-            generateModelFlexible();
+            // The error, if any, has already been reported
+            regenerateModels();
+        }
+    }
+
+    hresult_t Model::regenerateModels(void)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        /* Re-generate the true flexible model in case the original rigid
+           model has been manually modified by the user, or its structure
+           has changed. Otherwise, it is much faster to only update the
+           biases added to the dynamics properties of the model in-place. */
+        std::size_t const pncModelOrigHash = hashModel(pncModelOrig_);
+        if (isModelFlexibleStale_ || pncModelOrigHash != pncModelOrigHash_)
+        {
+            returnCode = generateModelFlexible();
 
             // Update the biases added to the dynamics properties of the model
-            generateModelBiased();
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = generateModelBiased();
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                pncModelOrigHash_ = pncModelOrigHash;
+            }
+        }
+        else
+        {
+            returnCode = randomizeModel();
         }
+
+        return returnCode;
     }
 
     hresult_t Model::addFrame(std::string          const & frameName,
@@ -416,7 +689,7 @@ namespace jiminy
                 pinocchio::SE3 const jointFramePlacement = parentFramePlacement.act(framePlacement);
                 pinocchio::Frame const frame(frameName, parentJointId, parentFrameId, jointFramePlacement, frameType);
                 pncModelOrig_.addFrame(frame);
-                pncDataOrig_ = pinocchio::Data(pncModelOrig_);
+                isDataOrigStale_ = true;
             }
 
             // Add the frame to the the original flexible model
@@ -433,7 +706,8 @@ namespace jiminy
                Note that it is unecessary to call 'reset' since the proxies
                are still up-to-date, because the frame is added at the end
                of the vector. */
-            generateModelBiased();
+            isModelBiasedStale_ = true;
+            returnCode = flushModelUpdates();
         }
 
         return returnCode;
@@ -488,11 +762,10 @@ namespace jiminy
                 pncModelFlexibleOrig_.nframes--;
             }
 
-            // Regenerate rigid data
-            pncDataOrig_ = pinocchio::Data(pncModelOrig_);
-
-            // One must reset the model after removing a frame
-            reset();
+            // One must regenerate rigid data and reset the model after removing a frame
+            isDataOrigStale_ = true;
+            isModelFlexibleStale_ = true;
+            returnCode = flushModelUpdates();
         }
 
         return returnCode;
@@ -574,6 +847,9 @@ namespace jiminy
         // Add the list of bodies to the set of collision bodies
         collisionBodiesNames_.insert(collisionBodiesNames_.end(), bodyNames.begin(), bodyNames.end());
 
+        // Update the model only once, after adding all the frames
+        ModelUpdateGuard modelUpdateGuard(*this);
+
         // Create the collision pairs and add them to the geometry model of the robot
         pinocchio::GeomIndex const & groundId = collisionModelOrig_.getGeometryId("ground");
         for (std::string const & name : bodyNames)
@@ -612,7 +888,7 @@ namespace jiminy
                             // collisionConstraintsMap.emplace_back(geom.name, std::make_shared<SphereConstraint>(
                             //     geom.name, sphere.radius));
                             collisionConstraintsMap.emplace_back(geom.name, std::make_shared<FixedFrameConstraint>(
-                                geom.name, (Eigen::Matrix<bool_t, 6, 1>() << true, true, true, false, false, true).finished()));
+                                geom.name, CONTACT_FIXED_DOFS_MASK));
                         }
 
                         // TODO: Add warning or error to notify that a geometry has been ignored
@@ -630,7 +906,12 @@ namespace jiminy
         // Refresh proxies associated with the collisions only
         if (returnCode == hresult_t::SUCCESS)
         {
-            refreshGeometryProxies();
+            areGeometryProxiesStale_ = true;
+        }
+        hresult_t const updateReturnCode = modelUpdateGuard.end();
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = updateReturnCode;
         }
 
         return returnCode;
@@ -704,13 +985,23 @@ namespace jiminy
         }
 
         // Remove the constraints and associated frames
-        removeConstraints(collisionConstraintsNames, constraintsHolderType_t::COLLISION_BODIES);
-        removeFrames(collisionConstraintsNames);
+        ModelUpdateGuard modelUpdateGuard(*this);
+        hresult_t returnCode = removeConstraints(
+            collisionConstraintsNames, constraintsHolderType_t::COLLISION_BODIES);
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = removeFrames(collisionConstraintsNames);
+        }
 
         // Refresh proxies associated with the collisions only
-        refreshGeometryProxies();
+        areGeometryProxiesStale_ = true;
+        hresult_t const updateReturnCode = modelUpdateGuard.end();
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = updateReturnCode;
+        }
 
-        return hresult_t::SUCCESS;
+        return returnCode;
     }
 
     hresult_t Model::addContactPoints(std::vector<std::string> const & frameNames)
@@ -737,10 +1028,14 @@ namespace jiminy
             return hresult_t::ERROR_BAD_INPUT;
         }
 
-        // Make sure that all the frames exist
+        /* Make sure that all the frames exist.
+           Note that the original models are used since 'pncModel_' may be
+           out-of-date if a batch of updates is in progress. */
+        pinocchio::Model const & pncModel = mdlOptions_->dynamics.enableFlexibleModel ?
+            pncModelFlexibleOrig_ : pncModelOrig_;
         for (std::string const & name : frameNames)
         {
-            if (!pncModel_.existFrame(name))
+            if (!pncModel.existFrame(name))
             {
                 PRINT_ERROR("At least one of the frames does not exist.");
                 return hresult_t::ERROR_BAD_INPUT;
@@ -756,14 +1051,15 @@ namespace jiminy
         for (std::string const & frameName : frameNames)
         {
             frameConstraintsMap.emplace_back(frameName, std::make_shared<FixedFrameConstraint>(
-                frameName, (Eigen::Matrix<bool_t, 6, 1>() << true, true, true, false, false, true).finished()));
+                frameName, CONTACT_FIXED_DOFS_MASK));
         }
         returnCode = addConstraints(frameConstraintsMap, constraintsHolderType_t::CONTACT_FRAMES);
 
         // Refresh proxies associated with contacts and constraints
         if (returnCode == hresult_t::SUCCESS)
         {
-            refreshContactsProxies();
+            areContactsProxiesStale_ = true;
+            returnCode = flushModelUpdates();
         }
 
         return returnCode;
@@ -805,9 +1101,8 @@ namespace jiminy
         }
 
         // Refresh proxies associated with contacts and constraints
-        refreshContactsProxies();
-
-        return hresult_t::SUCCESS;
+        areContactsProxiesStale_ = true;
+        return flushModelUpdates();
     }
 
     hresult_t Model::addConstraints(constraintsMap_t const & constraintsMap,
@@ -1076,6 +1371,103 @@ namespace jiminy
         return returnCode;
     }
 
+    void Model::addModelBiases(void)
+    {
+        for (std::string const & jointName : rigidJointsNames_)
+        {
+            jointIndex_t const & jointIdx = pncModel_.getJointId(jointName);
+
+            // Add bias to com position
+            float64_t const & comBiasStd = mdlOptions_->dynamics.centerOfMassPositionBodiesBiasStd;
+            if (comBiasStd > EPS)
+            {
+                vector3_t & comRelativePositionBody = pncModel_.inertias[jointIdx].lever();
+                comRelativePositionBody.array() *= 1.0 + randVectorNormal(3U, comBiasStd).array();
+            }
+
+            /* Add bias to body mass.
+               Note that it cannot be less than min(original mass, 1g) for numerical stability. */
+            float64_t const & massBiasStd = mdlOptions_->dynamics.massBodiesBiasStd;
+            if (massBiasStd > EPS)
+            {
+                float64_t & massBody = pncModel_.inertias[jointIdx].mass();
+                massBody = std::max(massBody * (1.0 + randNormal(0.0, massBiasStd)),
+                                    std::min(massBody, 1.0e-3));
+            }
+
+            /* Add bias to inertia matrix of body.
+               To preserve positive semi-definite property after noise addition, the principal
+               axes and moments are computed from the original inertia matrix, then independent
+               gaussian distributed noise is added on each principal moments, and a random small
+               rotation is applied to the principal axes based on a randomly generated rotation
+               axis. Finally, the biased inertia matrix is obtained doing A @ diag(M) @ A.T.
+               If no bias, the original inertia matrix is recovered. */
+            float64_t const & inertiaBiasStd = mdlOptions_->dynamics.inertiaBodiesBiasStd;
+            if (inertiaBiasStd > EPS)
+            {
+                pinocchio::Symmetric3 & inertiaBody = pncModel_.inertias[jointIdx].inertia();
+                Eigen::SelfAdjointEigenSolver<matrix3_t> solver(inertiaBody.matrix());
+                vector3_t inertiaBodyMoments = solver.eigenvalues();
+                matrix3_t inertiaBodyAxes = solver.eigenvectors();
+                vector3_t const randAxis = randVectorNormal(3U, inertiaBiasStd);
+                inertiaBodyAxes = inertiaBodyAxes * quaternion_t(pinocchio::exp3(randAxis));
+                inertiaBodyMoments.array() *= 1.0 + randVectorNormal(3U, inertiaBiasStd).array();
+                inertiaBody = pinocchio::Symmetric3((
+                    inertiaBodyAxes * inertiaBodyMoments.asDiagonal() * inertiaBodyAxes.transpose()).eval());
+            }
+
+            // Add bias to relative body position (rotation excluded !)
+            float64_t const & relativeBodyPosBiasStd = mdlOptions_->dynamics.relativePositionBodiesBiasStd;
+            if (relativeBodyPosBiasStd > EPS)
+            {
+                vector3_t & relativePositionBody = pncModel_.jointPlacements[jointIdx].translation();
+                relativePositionBody.array() *= 1.0 + randVectorNormal(3U, relativeBodyPosBiasStd).array();
+            }
+        }
+    }
+
+    hresult_t Model::randomizeModel(void)
+    {
+        // Make sure the model is initialized
+        if (!isInitialized_)
+        {
+            PRINT_ERROR("Model not initialized.");
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // Make sure the structure of the model is up-to-date
+        pinocchio::Model const & pncModelNominal = mdlOptions_->dynamics.enableFlexibleModel ?
+            pncModelFlexibleOrig_ : pncModelOrig_;
+        if (pncModel_.njoints != pncModelNominal.njoints || pncModel_.nframes != pncModelNominal.nframes)
+        {
+            PRINT_ERROR("The structure of the model has changed. Please reset it first.");
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        /* Restore the nominal dynamics properties of the model, then add new biases.
+           Note that only the properties affected by the biases are restored, and it
+           does not reallocate memory since the number of joints is unchanged. */
+        pncModel_.inertias = pncModelNominal.inertias;
+        pncModel_.jointPlacements = pncModelNominal.jointPlacements;
+        addModelBiases();
+
+        // Update Pinocchio Data internal state in-place
+        vectorN_t const qNeutral = pinocchio::neutral(pncModel_);
+        pinocchio::forwardKinematics(pncModel_, pncData_, qNeutral, vectorN_t::Zero(pncModel_.nv));
+        pinocchio::updateFramePlacements(pncModel_, pncData_);
+        pinocchio::centerOfMass(pncModel_, pncData_, qNeutral);
+
+        /* The placement of the geometries only depends on the biases if the model is flexible,
+           since it is computed wrt the flexibility joints in such a case. */
+        if (mdlOptions_->dynamics.enableFlexibleModel &&
+            mdlOptions_->dynamics.relativePositionBodiesBiasStd > EPS)
+        {
+            return refreshGeometryProxies();
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
     hresult_t Model::generateModelBiased(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -1099,57 +1491,8 @@ namespace jiminy
                 pncModel_ = pncModelOrig_;
             }
 
-            for (std::string const & jointName : rigidJointsNames_)
-            {
-                jointIndex_t const & jointIdx = pncModel_.getJointId(jointName);
-
-                // Add bias to com position
-                float64_t const & comBiasStd = mdlOptions_->dynamics.centerOfMassPositionBodiesBiasStd;
-                if (comBiasStd > EPS)
-                {
-                    vector3_t & comRelativePositionBody = pncModel_.inertias[jointIdx].lever();
-                    comRelativePositionBody.array() *= 1.0 + randVectorNormal(3U, comBiasStd).array();
-                }
-
-                /* Add bias to body mass.
-                   Note that it cannot be less than min(original mass, 1g) for numerical stability. */
-                float64_t const & massBiasStd = mdlOptions_->dynamics.massBodiesBiasStd;
-                if (massBiasStd > EPS)
-                {
-                    float64_t & massBody = pncModel_.inertias[jointIdx].mass();
-                    massBody = std::max(massBody * (1.0 + randNormal(0.0, massBiasStd)),
-                                        std::min(massBody, 1.0e-3));
-                }
-
-                /* Add bias to inertia matrix of body.
-                   To preserve positive semi-definite property after noise addition, the principal
-                   axes and moments are computed from the original inertia matrix, then independent
-                   gaussian distributed noise is added on each principal moments, and a random small
-                   rotation is applied to the principal axes based on a randomly generated rotation
-                   axis. Finally, the biased inertia matrix is obtained doing A @ diag(M) @ A.T.
-                   If no bias, the original inertia matrix is recovered. */
-                float64_t const & inertiaBiasStd = mdlOptions_->dynamics.inertiaBodiesBiasStd;
-                if (inertiaBiasStd > EPS)
-                {
-                    pinocchio::Symmetric3 & inertiaBody = pncModel_.inertias[jointIdx].inertia();
-                    Eigen::SelfAdjointEigenSolver<matrix3_t> solver(inertiaBody.matrix());
-                    vector3_t inertiaBodyMoments = solver.eigenvalues();
-                    matrix3_t inertiaBodyAxes = solver.eigenvectors();
-                    vector3_t const randAxis = randVectorNormal(3U, inertiaBiasStd);
-                    inertiaBodyAxes = inertiaBodyAxes * quaternion_t(pinocchio::exp3(randAxis));
-                    inertiaBodyMoments.array() *= 1.0 + randVectorNormal(3U, inertiaBiasStd).array();
-                    inertiaBody = pinocchio::Symmetric3((
-                        inertiaBodyAxes * inertiaBodyMoments.asDiagonal() * inertiaBodyAxes.transpose()).eval());
-                }
-
-                // Add bias to relative body position (rotation excluded !)
-                float64_t const & relativeBodyPosBiasStd = mdlOptions_->dynamics.relativePositionBodiesBiasStd;
-                if (relativeBodyPosBiasStd > EPS)
-                {
-                    vector3_t & relativePositionBody = pncModel_.jointPlacements[jointIdx].translation();
-                    relativePositionBody.array() *= 1.0 + randVectorNormal(3U, relativeBodyPosBiasStd).array();
-                }
-            }
+            // Add biases to the dynamics properties of the model
+            addModelBiases();
 
             // Initialize Pinocchio Data internal state
             pncData_ = pinocchio::Data(pncModel_);
@@ -1432,57 +1775,111 @@ namespace jiminy
         return returnCode;
     }
 
-    hresult_t Model::refreshGeometryProxies(void)
+    void Model::refreshGeometryModel(pinocchio::GeometryModel const & geomModelOrig,
+                                     pinocchio::GeometryModel       & geomModel,
+                                     pinocchio::GeometryData        & geomData)
     {
-        hresult_t returnCode = hresult_t::SUCCESS;
+        // Restore the geometry model
+        geomModel = geomModelOrig;
+        geometryModelsVersion_ = generateVersion();
+
+        // Update joint/frame fix for every geometry objects
+        if (mdlOptions_->dynamics.enableFlexibleModel)
+        {
+            for (pinocchio::GeometryObject & geom : geomModel.geometryObjects)
+            {
+                // Only the frame name remains unchanged no matter what
+                pinocchio::Frame const & frameOrig = pncModelOrig_.frames[geom.parentFrame];
+                pinocchio::JointIndex const jointIdxOrig = frameOrig.parent;
+                pinocchio::FrameIndex const frameIdx = pncModel_.getFrameId(frameOrig.name);
+                pinocchio::Frame const & frame = pncModel_.frames[frameIdx];
+                pinocchio::JointIndex const jointIdx = frame.parent;
+                geom.parentFrame = frameIdx;
+                geom.parentJoint = jointIdx;
+
+                /* Compute the relative displacement between the new and old joint placement
+                   wrt their common parent joint. */
+                pinocchio::SE3 geomPlacementRef = pinocchio::SE3::Identity();
+                for(pinocchio::JointIndex i=jointIdx; i >= jointIdxOrig && i > 0; i=pncModel_.parents[i])
+                {
+                    geomPlacementRef = pncModel_.jointPlacements[i] * geomPlacementRef;
+                }
+                geom.placement = geomPlacementRef.actInv(pncModelOrig_.jointPlacements[frameOrig.parent]).act(geom.placement);
+            }
+        }
+
+        // Update the geometry data object
+        geomData = pinocchio::GeometryData(geomModel);
+        pinocchio::updateGeometryPlacements(pncModel_, pncData_, geomModel, geomData);
+    }
+
+    hresult_t Model::loadVisualModel(void)
+    {
+        if (!visualModelDeferred_)
+        {
+            return hresult_t::SUCCESS;
+        }
 
         if (!isInitialized_)
         {
             PRINT_ERROR("Model not initialized.");
-            returnCode = hresult_t::ERROR_INIT_FAILED;
+            return hresult_t::ERROR_INIT_FAILED;
         }
 
-        if (returnCode == hresult_t::SUCCESS)
-        {
-            // Restore collision and visual models
-            collisionModel_ = collisionModelOrig_;
-            visualModel_ = visualModelOrig_;
+        hresult_t returnCode = hresult_t::SUCCESS;
 
-            // Update joint/frame fix for every geometry objects
-            if (mdlOptions_->dynamics.enableFlexibleModel)
+        {
+            // Build the visual model, unless it has been done already by a clone of the model
+            std::lock_guard<std::mutex> lock(visualModelDeferred_->mutex);
+            if (!visualModelDeferred_->isLoaded)
             {
-                for (auto model : std::array<pinocchio::GeometryModel *, 2>{{&collisionModel_, &visualModel_}})
+                /* Build the visual model alone from the content of the URDF file, for the
+                   original rigid model, going through the cache of the models if any. */
+                pinocchio::GeometryModel visualModel;
+                returnCode = buildVisualModelFromUrdf(urdfData_,
+                                                      hasFreeflyer_,
+                                                      meshPackageDirs_,
+                                                      pncModelOrig_,
+                                                      visualModel,
+                                                      loadVisualMeshes_,
+                                                      cacheDir_,
+                                                      nThreads_);
+
+                if (returnCode == hresult_t::SUCCESS)
                 {
-                    for (pinocchio::GeometryObject & geom : model->geometryObjects)
-                    {
-                        // Only the frame name remains unchanged no matter what
-                        pinocchio::Frame const & frameOrig = pncModelOrig_.frames[geom.parentFrame];
-                        pinocchio::JointIndex const jointIdxOrig = frameOrig.parent;
-                        pinocchio::FrameIndex const frameIdx = pncModel_.getFrameId(frameOrig.name);
-                        pinocchio::Frame const & frame = pncModel_.frames[frameIdx];
-                        pinocchio::JointIndex const jointIdx = frame.parent;
-                        geom.parentFrame = frameIdx;
-                        geom.parentJoint = jointIdx;
-
-                        /* Compute the relative displacement between the new and old joint placement
-                           wrt their common parent joint. */
-                        pinocchio::SE3 geomPlacementRef = pinocchio::SE3::Identity();
-                        for(pinocchio::JointIndex i=jointIdx; i >= jointIdxOrig && i > 0; i=pncModel_.parents[i])
-                        {
-                            geomPlacementRef = pncModel_.jointPlacements[i] * geomPlacementRef;
-                        }
-                        geom.placement = geomPlacementRef.actInv(pncModelOrig_.jointPlacements[frameOrig.parent]).act(geom.placement);
-                    }
+                    visualModelDeferred_->model = std::move(visualModel);
+                    visualModelDeferred_->isLoaded = true;
                 }
             }
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            visualModelOrig_ = visualModelDeferred_->model;
+            refreshGeometryModel(visualModelOrig_, visualModel_, visualData_);
+            visualModelDeferred_.reset();
+        }
 
-            /* Update geometry data object after changing the collision pairs
+        return returnCode;
+    }
+
+    hresult_t Model::refreshGeometryProxies(void)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (!isInitialized_)
+        {
+            PRINT_ERROR("Model not initialized.");
+            returnCode = hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            /* Restore collision and visual models, then update the geometry data objects.
                Note that copy assignment is used to avoid changing memory pointers,
                which would result in dangling reference at Python-side. */
-            collisionData_ = pinocchio::GeometryData(collisionModel_);
-            pinocchio::updateGeometryPlacements(pncModel_, pncData_, collisionModel_, collisionData_);
-            visualData_ = pinocchio::GeometryData(visualModel_);
-            pinocchio::updateGeometryPlacements(pncModel_, pncData_, visualModel_, visualData_);
+            refreshGeometryModel(collisionModelOrig_, collisionModel_, collisionData_);
+            refreshGeometryModel(visualModelOrig_, visualModel_, visualData_);
 
             // Set the max number of contact points per collision pairs
             for (hpp::fcl::CollisionRequest & collisionRequest : collisionData_.collisionRequests)
@@ -1715,21 +2112,20 @@ namespace jiminy
 
         // Create a fast struct accessor
         mdlOptions_ = std::make_unique<modelOptions_t const>(mdlOptionsHolder_);
+        optionsVersion_ = generateVersion();
 
-        if (areModelsInvalid)
-        {
-            // Trigger models regeneration
-            reset();
-        }
-        else if (internalBuffersMustBeUpdated)
-        {
-            // Update the info extracted from the model
-            refreshProxies();
-        }
-        else if (isCollisionDataInvalid)
+        // Trigger models regeneration
+        isModelFlexibleStale_ |= areModelsInvalid;
+
+        // Update the info extracted from the model
+        areProxiesStale_ |= internalBuffersMustBeUpdated;
+
+        // Update the visual and collision data
+        areGeometryProxiesStale_ |= isCollisionDataInvalid;
+
+        if (areModelsInvalid || internalBuffersMustBeUpdated || isCollisionDataInvalid)
         {
-            // Update the visual and collision data
-            refreshGeometryProxies();
+            return flushModelUpdates();
         }
 
         return hresult_t::SUCCESS;
@@ -1770,6 +2166,16 @@ namespace jiminy
         return hasFreeflyer_;
     }
 
+    std::size_t const & Model::getGeometryModelsVersion(void) const
+    {
+        return geometryModelsVersion_;
+    }
+
+    std::size_t Model::getOptionsVersion(void) const
+    {
+        return optionsVersion_;
+    }
+
     hresult_t Model::getFlexibleConfigurationFromRigid(vectorN_t const & qRigid,
                                                        vectorN_t       & qFlex) const
     {
@@ -2067,4 +2473,29 @@ namespace jiminy
     {
         return nx_;
     }
+
+    ModelUpdateGuard::ModelUpdateGuard(Model & model) :
+    model_(&model)
+    {
+        model_->beginModelUpdate();
+    }
+
+    ModelUpdateGuard::~ModelUpdateGuard(void)
+    {
+        end();
+    }
+
+    hresult_t ModelUpdateGuard::end(void)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        // The batch must be ended only once, whether it is done explicitly or not
+        if (model_)
+        {
+            returnCode = model_->endModelUpdate();
+            model_ = nullptr;
+        }
+
+        return returnCode;
+    }
 }
@@ -26,6 +26,9 @@ namespace jiminy
     commandFieldnames_(),
     motorEffortFieldnames_(),
     nmotors_(0U),
+    ns_(0),
+    sensorsDataFlat_(),
+    sensorsDataOffsets_(),
     mutexLocal_(std::make_unique<MutexLocal>()),
     motorsSharedHolder_(std::make_shared<MotorSharedDataHolder_t>()),
     sensorsSharedHolder_()
@@ -43,7 +46,10 @@ namespace jiminy
     hresult_t Robot::initialize(std::string const & urdfPath,
                                 bool_t const & hasFreeflyer,
                                 std::vector<std::string> const & meshPackageDirs,
-                                bool_t const & loadVisualMeshes)
+                                bool_t const & loadVisualMeshes,
+                                std::string const & cacheDir,
+                                bool_t const & deferVisualModel,
+                                uint32_t const & nThreads)
     {
         // Detach all the motors and sensors
         detachSensors({});
@@ -51,7 +57,8 @@ namespace jiminy
 
         /* Delete the current model and generate a new one.
            Note that is also refresh all proxies automatically. */
-        return Model::initialize(urdfPath, hasFreeflyer, meshPackageDirs, loadVisualMeshes);
+        return Model::initialize(urdfPath, hasFreeflyer, meshPackageDirs, loadVisualMeshes, cacheDir,
+                                 deferVisualModel, nThreads);
     }
 
     hresult_t Robot::initialize(pinocchio::Model const & pncModel,
@@ -67,6 +74,48 @@ namespace jiminy
         return Model::initialize(pncModel, collisionModel, visualModel);
     }
 
+    hresult_t Robot::clone(std::shared_ptr<Robot> & robot) const
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        // Copy the model, sharing its geometries
+        auto robotCopy = std::make_shared<Robot>();
+        returnCode = robotCopy->copyFrom(*this);
+
+        /* Attach a copy of every motors and sensors, preserving their order.
+           Note that the motors must be attached first since some sensors depend on them. */
+        for (auto const & motor : motorsHolder_)
+        {
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = motor->attachCopy(*robotCopy);
+            }
+        }
+        for (auto const & sensorGroup : sensorsGroupHolder_)
+        {
+            for (auto const & sensor : sensorGroup.second)
+            {
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    returnCode = sensor->attachCopy(*robotCopy);
+                }
+            }
+        }
+
+        // Copy the options of the motors, sensors and telemetry
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = robotCopy->setOptions(getOptions());
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            robot = robotCopy;
+        }
+
+        return returnCode;
+    }
+
     void Robot::reset(void)
     {
         // Reset the model
@@ -86,6 +135,7 @@ namespace jiminy
                 (*sensorGroup.second.begin())->resetAll();
             }
         }
+        sensorsDataFlat_.setZero();
 
         // Reset the telemetry flag
         isTelemetryConfigured_ = false;
@@ -206,6 +256,7 @@ namespace jiminy
         {
             // Add the motor to the holder
             motorsHolder_.push_back(motor);
+            optionsVersion_ = generateVersion();
 
             // Refresh the motors proxies
             refreshMotorsProxies();
@@ -245,6 +296,7 @@ namespace jiminy
 
         // Remove the motor from the holder
         motorsHolder_.erase(motorIt);
+        optionsVersion_ = generateVersion();
 
         // Refresh the motors proxies
         refreshMotorsProxies();
@@ -360,6 +412,7 @@ namespace jiminy
         {
             // Create the sensor and add it to its group
             sensorsGroupHolder_[sensorType].push_back(sensor);
+            optionsVersion_ = generateVersion();
 
             // Refresh the sensors proxies
             refreshSensorsProxies();
@@ -409,6 +462,7 @@ namespace jiminy
 
         // Remove the sensor from its group
         sensorGroupIt->second.erase(sensorIt);
+        optionsVersion_ = generateVersion();
 
         // Remove the sensor group if there is no more sensors left
         if (sensorGroupIt->second.empty())
@@ -508,8 +562,9 @@ namespace jiminy
 
         if (returnCode == hresult_t::SUCCESS)
         {
-            // Determine the number of motors
+            // Determine the number of motors and the dimension of their internal state
             nmotors_ = motorsHolder_.size();
+            ns_ = static_cast<int32_t>(motorsSharedHolder_->state_.size());
 
             // Extract the motor names
             motorsNames_.clear();
@@ -572,6 +627,24 @@ namespace jiminy
                                });
                 sensorsNames_.insert({sensorGroup.first, std::move(sensorGroupNames)});
             }
+
+            /* Compute the layout of the contiguous buffer of measurements.
+               The order of the sensor types must be the same as the one of
+               `setSensorsData`, which is the case as long as the shared data
+               holders are not modified in-between. */
+            sensorsDataOffsets_.clear();
+            Eigen::Index sensorsDataSize = 0;
+            for (auto const & sensorSharedHolder : sensorsSharedHolder_)
+            {
+                auto & sensorTypeOffsets = sensorsDataOffsets_[sensorSharedHolder.first];
+                for (AbstractSensorBase const * sensor : sensorSharedHolder.second->sensors_)
+                {
+                    sensorTypeOffsets.emplace(sensor->getName(), sensorsDataSize +
+                        static_cast<Eigen::Index>(sensor->getIdx() * sensor->getSize()));
+                }
+                sensorsDataSize += sensorSharedHolder.second->dataMeasured_.size();
+            }
+            sensorsDataFlat_.setZero(sensorsDataSize);
         }
 
         return returnCode;
@@ -1131,10 +1204,29 @@ namespace jiminy
             }
             sensorGroupTelemetryOption.second = boost::get<bool_t>(sensorTelemetryOptionIt->second);
         }
+        optionsVersion_ = generateVersion();
 
         return hresult_t::SUCCESS;
     }
 
+    std::size_t Robot::getOptionsVersion(void) const
+    {
+        // The most recent version of the options of the robot, its motors and its sensors
+        std::size_t optionsVersion = Model::getOptionsVersion();
+        for (auto const & motor : motorsHolder_)
+        {
+            optionsVersion = std::max(optionsVersion, motor->getOptionsVersion());
+        }
+        for (auto const & sensorGroup : sensorsGroupHolder_)
+        {
+            for (auto const & sensor : sensorGroup.second)
+            {
+                optionsVersion = std::max(optionsVersion, sensor->getOptionsVersion());
+            }
+        }
+        return optionsVersion;
+    }
+
     configHolder_t Robot::getTelemetryOptions(void) const
     {
         configHolder_t telemetryOptions;
@@ -1179,14 +1271,32 @@ namespace jiminy
                                      vectorN_t const & q,
                                      vectorN_t const & v,
                                      vectorN_t const & a,
+                                     vectorN_t const & s,
                                      vectorN_t const & command)
     {
         if (!motorsHolder_.empty())
         {
+            setMotorsState(s);
             (*motorsHolder_.begin())->computeEffortAll(t, q, v, a, command);
         }
     }
 
+    vectorN_t const & Robot::getMotorsState(void) const
+    {
+        return motorsSharedHolder_->state_;
+    }
+
+    void Robot::setMotorsState(vectorN_t const & s)
+    {
+        assert(s.size() == ns_ && "The state is not consistent with the motors of the robot.");
+        motorsSharedHolder_->state_ = s;
+    }
+
+    vectorN_t const & Robot::getMotorsStateDerivative(void) const
+    {
+        return motorsSharedHolder_->stateDerivative_;
+    }
+
     vectorN_t const & Robot::getMotorsEfforts(void) const
     {
         static vectorN_t const motorsEffortsEmpty;
@@ -1235,6 +1345,79 @@ namespace jiminy
                 (*sensorGroup.second.begin())->setAll(t, q, v, a, uMotor, fExternal);
             }
         }
+
+        // Gather the measurements of every sensors in the contiguous buffer
+        Eigen::Index sensorsDataIdx = 0;
+        for (auto const & sensorSharedHolder : sensorsSharedHolder_)
+        {
+            matrixN_t const & dataMeasured = sensorSharedHolder.second->dataMeasured_;
+            sensorsDataFlat_.segment(sensorsDataIdx, dataMeasured.size()) =
+                Eigen::Map<vectorN_t const>(dataMeasured.data(), dataMeasured.size());
+            sensorsDataIdx += dataMeasured.size();
+        }
+    }
+
+    vectorN_t const & Robot::getSensorsDataFlat(void) const
+    {
+        return sensorsDataFlat_;
+    }
+
+    void Robot::getSensorsState(sensorsState_t & sensorsState) const
+    {
+        std::size_t const nSensorsTypes = sensorsSharedHolder_.size();
+        sensorsState.time.resize(nSensorsTypes);
+        sensorsState.data.resize(nSensorsTypes);
+        sensorsState.head.resize(nSensorsTypes);
+        sensorsState.size.resize(nSensorsTypes);
+        sensorsState.dropped.resize(nSensorsTypes);
+        std::size_t i = 0;
+        for (auto const & sensorSharedHolder : sensorsSharedHolder_)
+        {
+            SensorSharedDataHolder_t const & sharedHolder = *sensorSharedHolder.second;
+            sensorsState.time[i] = sharedHolder.time_;
+            sensorsState.data[i] = sharedHolder.data_;
+            sensorsState.head[i] = sharedHolder.head_;
+            sensorsState.size[i] = sharedHolder.size_;
+            sensorsState.dropped[i] = sharedHolder.dropped_;
+            ++i;
+        }
+        sensorsState.dataMeasured = sensorsDataFlat_;
+    }
+
+    hresult_t Robot::setSensorsState(sensorsState_t const & sensorsState)
+    {
+        if (sensorsState.time.size() != sensorsSharedHolder_.size()
+         || sensorsState.dataMeasured.size() != sensorsDataFlat_.size())
+        {
+            PRINT_ERROR("The state is not consistent with the sensors of the robot.");
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Restore the ring buffers, then the current measurements from the contiguous buffer
+        std::size_t i = 0;
+        Eigen::Index sensorsDataIdx = 0;
+        for (auto & sensorSharedHolder : sensorsSharedHolder_)
+        {
+            SensorSharedDataHolder_t & sharedHolder = *sensorSharedHolder.second;
+            sharedHolder.time_ = sensorsState.time[i];
+            sharedHolder.data_ = sensorsState.data[i];
+            sharedHolder.head_ = sensorsState.head[i];
+            sharedHolder.size_ = sensorsState.size[i];
+            sharedHolder.dropped_ = sensorsState.dropped[i];
+            matrixN_t & dataMeasured = sharedHolder.dataMeasured_;
+            Eigen::Map<vectorN_t>(dataMeasured.data(), dataMeasured.size()) =
+                sensorsState.dataMeasured.segment(sensorsDataIdx, dataMeasured.size());
+            sensorsDataIdx += dataMeasured.size();
+            ++i;
+        }
+        sensorsDataFlat_ = sensorsState.dataMeasured;
+
+        return hresult_t::SUCCESS;
+    }
+
+    Robot::sensorsDataOffsets_t const & Robot::getSensorsDataOffsets(void) const
+    {
+        return sensorsDataOffsets_;
     }
 
     sensorsDataMap_t Robot::getSensorsData(void) const
@@ -1438,4 +1621,9 @@ namespace jiminy
     {
         return nmotors_;
     }
+
+    int32_t const & Robot::ns(void) const
+    {
+        return ns_;
+    }
 }
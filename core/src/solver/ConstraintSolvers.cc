@@ -105,6 +105,62 @@ namespace jiminy
         yPrev_.resize(constraintsRowsMax);
     }
 
+    bool_t PGSSolver::isCompatible(constraintsHolder_t & constraintsHolder) const
+    {
+        if (J_.cols() != model_->nv)
+        {
+            return false;
+        }
+
+        bool_t isCompatible = true;
+        std::size_t constraintIdx = 0U;
+        constraintsHolder.foreach(
+            [&](
+                std::shared_ptr<AbstractConstraintBase> const & constraint,
+                constraintsHolderType_t const & /* holderType */)
+            {
+                if (constraintIdx >= constraintsData_.size())
+                {
+                    isCompatible = false;
+                }
+                else
+                {
+                    ConstraintData const & constraintData = constraintsData_[constraintIdx];
+                    if (constraintData.constraint != constraint.get() ||
+                        constraintData.dim != static_cast<Eigen::Index>(constraint->getDim()))
+                    {
+                        isCompatible = false;
+                    }
+                }
+                ++constraintIdx;
+            });
+
+        return isCompatible && constraintIdx == constraintsData_.size();
+    }
+
+    void PGSSolver::setParameters(float64_t const & friction,
+                                  float64_t const & torsion,
+                                  float64_t const & tolAbs,
+                                  float64_t const & tolRel)
+    {
+        tolAbs_ = tolAbs;
+        tolRel_ = tolRel;
+
+        // Only contact constraints have torsional and tangential friction blocks
+        for (ConstraintData & constraintData : constraintsData_)
+        {
+            if (constraintData.nBlocks == 3)
+            {
+                ConstraintBlock & torsionBlock = constraintData.blocks[1];
+                torsionBlock.hi = torsion;
+                torsionBlock.isZero = (torsion < EPS);
+                ConstraintBlock & frictionBlock = constraintData.blocks[2];
+                frictionBlock.hi = friction;
+                frictionBlock.isZero = (friction < EPS);
+            }
+        }
+    }
+
     void PGSSolver::ProjectedGaussSeidelIter(matrixN_t const & A,
                                              vectorN_t::SegmentReturnType const & b,
                                              vectorN_t::SegmentReturnType & x)
@@ -1,9 +1,35 @@
 
+#include <algorithm>
+
 #include "jiminy/core/stepper/AbstractRungeKuttaStepper.h"
 
 
 namespace jiminy
 {
+    namespace
+    {
+        /// \brief Apply a function to every buffers of the continuous extension, in order.
+        template<typename StagesType, typename StateType, typename StateDerivativeType, typename Function>
+        void forEachDenseOutputBuffer(StagesType          & ki,
+                                      StateType           & stateInit,
+                                      StateDerivativeType & stateDerivativeEnd,
+                                      Function           && func)
+        {
+            for (auto & k : ki)
+            {
+                std::for_each(k.v.begin(), k.v.end(), func);
+                std::for_each(k.a.begin(), k.a.end(), func);
+                std::for_each(k.ds.begin(), k.ds.end(), func);
+            }
+            std::for_each(stateInit.q.begin(), stateInit.q.end(), func);
+            std::for_each(stateInit.v.begin(), stateInit.v.end(), func);
+            std::for_each(stateInit.s.begin(), stateInit.s.end(), func);
+            std::for_each(stateDerivativeEnd.v.begin(), stateDerivativeEnd.v.end(), func);
+            std::for_each(stateDerivativeEnd.a.begin(), stateDerivativeEnd.a.end(), func);
+            std::for_each(stateDerivativeEnd.ds.begin(), stateDerivativeEnd.ds.end(), func);
+        }
+    }
+
     AbstractRungeKuttaStepper::AbstractRungeKuttaStepper(systemDynamics const & f,
                                                          std::vector<Robot const *> const & robots,
                                                          matrixN_t const & RungeKuttaMatrix,
@@ -18,8 +44,11 @@ namespace jiminy
     ki_(cNodes.size(), stateDerivative_t(robots)),
     stateIncrement_(robots),
     stateBuffer_(robots),
-    candidateSolution_(robots)
-
+    candidateSolution_(robots),
+    stateInit_(robots),
+    stateDerivativeEnd_(robots),
+    denseOutputWeights_(vectorN_t::Zero(cNodes.size() + 1)),
+    denseOutputWeightsDot_(vectorN_t::Zero(cNodes.size() + 1))
     {
         assert(A_.rows() == A_.cols());
         assert(c_.size() == A_.rows());
@@ -61,6 +90,9 @@ namespace jiminy
         // Compute the next state and state derivative if success
         if (hasSucceeded)
         {
+            // Backup the initial state for dense output
+            stateInit_ = state;
+
             state = candidateSolution_;
             if (isFSAL_)
             {
@@ -68,7 +100,8 @@ namespace jiminy
             }
             else
             {
-                stateDerivative = f(t, state);
+                stateDerivativeEnd_ = f(t, state);
+                stateDerivative = stateDerivativeEnd_;
             }
         }
 
@@ -83,5 +116,90 @@ namespace jiminy
         dt = INF;
         return true;
     }
-}
 
+    bool_t AbstractRungeKuttaStepper::interpolateImpl(float64_t         const & ratio,
+                                                      float64_t         const & dt,
+                                                      state_t                 & state,
+                                                      stateDerivative_t       & stateDerivative)
+    {
+        // Compute the weights of the continuous extension and their derivative
+        computeDenseOutputWeights(ratio, denseOutputWeights_, denseOutputWeightsDot_);
+
+        /* Sum the weighted stages, then integrate them from the initial state of the step.
+           The time derivative does not depend on dt since d(ratio)/dt = 1 / dt. */
+        stateDerivative_t const & stateDerivativeEnd = isFSAL_ ? ki_.back() : stateDerivativeEnd_;
+        stateIncrement_.setZero();
+        stateDerivative.setZero();
+        for (std::size_t i = 0; i < ki_.size(); ++i)
+        {
+            stateIncrement_.sumInPlace(ki_[i], dt * denseOutputWeights_[i]);
+            stateDerivative.sumInPlace(ki_[i], denseOutputWeightsDot_[i]);
+        }
+        stateIncrement_.sumInPlace(stateDerivativeEnd, dt * denseOutputWeights_[ki_.size()]);
+        stateDerivative.sumInPlace(stateDerivativeEnd, denseOutputWeightsDot_[ki_.size()]);
+        stateInit_.sum(stateIncrement_, state);
+
+        return true;
+    }
+
+    void AbstractRungeKuttaStepper::getDenseOutputImpl(std::vector<vectorN_t> & buffers) const
+    {
+        std::size_t bufferIdx = 0U;
+        forEachDenseOutputBuffer(ki_, stateInit_, stateDerivativeEnd_,
+            [&buffers, &bufferIdx](vectorN_t const & buffer)
+            {
+                if (bufferIdx == buffers.size())
+                {
+                    buffers.emplace_back();
+                }
+                buffers[bufferIdx++] = buffer;
+            });
+        buffers.resize(bufferIdx);
+    }
+
+    bool_t AbstractRungeKuttaStepper::setDenseOutputImpl(std::vector<vectorN_t> const & buffers)
+    {
+        // Make sure the buffers are consistent with the stepper before altering it
+        std::size_t bufferIdx = 0U;
+        bool_t isValid = true;
+        forEachDenseOutputBuffer(ki_, stateInit_, stateDerivativeEnd_,
+            [&buffers, &bufferIdx, &isValid](vectorN_t const & buffer)
+            {
+                isValid = isValid && bufferIdx < buffers.size() && buffers[bufferIdx].size() == buffer.size();
+                ++bufferIdx;
+            });
+        if (!isValid || bufferIdx != buffers.size())
+        {
+            return false;
+        }
+
+        bufferIdx = 0U;
+        forEachDenseOutputBuffer(ki_, stateInit_, stateDerivativeEnd_,
+            [&buffers, &bufferIdx](vectorN_t & buffer)
+            {
+                buffer = buffers[bufferIdx++];
+            });
+        return true;
+    }
+
+    void AbstractRungeKuttaStepper::computeDenseOutputWeights(float64_t const & ratio,
+                                                              vectorN_t       & weights,
+                                                              vectorN_t       & weightsDerivative) const
+    {
+        /* Cubic Hermite interpolation, written as a linear combination of the stages,
+           the first one being the state derivative at the beginning of the step. */
+        float64_t const ratio2 = ratio * ratio;
+        float64_t const ratioBis = ratio * (1.0 - ratio);
+        float64_t const ratio2Bis = ratio2 * (1.0 - ratio);
+        weights.resize(b_.size() + 1);
+        weights.head(b_.size()) = (ratio - ratioBis + 2.0 * ratio2Bis) * b_;
+        weights[0] += ratioBis - ratio2Bis;
+        weights[b_.size()] = - ratio2Bis;
+
+        // Derivative of the weights wrt. the ratio
+        weightsDerivative.resize(b_.size() + 1);
+        weightsDerivative.head(b_.size()) = (6.0 * ratioBis) * b_;
+        weightsDerivative[0] += 1.0 - 4.0 * ratio + 3.0 * ratio2;
+        weightsDerivative[b_.size()] = 3.0 * ratio2 - 2.0 * ratio;
+    }
+}
@@ -1,4 +1,6 @@
 
+#include "jiminy/core/Constants.h"
+
 #include "jiminy/core/stepper/AbstractStepper.h"
 
 namespace jiminy
@@ -9,14 +11,20 @@ namespace jiminy
     robots_(robots),
     state_(robots),
     stateDerivative_(robots),
-    fOutput_(robots)
+    fOutput_(robots),
+    stateInterp_(robots),
+    stateDerivativeInterp_(robots),
+    tPrev_(0.0),
+    dtPrev_(0.0)
     {
         // Empty on purpose
     }
 
     bool_t AbstractStepper::tryStep(std::vector<vectorN_t> & qSplit,
                                     std::vector<vectorN_t> & vSplit,
+                                    std::vector<vectorN_t> & sSplit,
                                     std::vector<vectorN_t> & aSplit,
+                                    std::vector<vectorN_t> & dsSplit,
                                     float64_t              & t,
                                     float64_t              & dt)
     {
@@ -24,8 +32,10 @@ namespace jiminy
         float64_t t_next = t + dt;
         state_.q = qSplit;
         state_.v = vSplit;
+        state_.s = sSplit;
         stateDerivative_.v = vSplit;
         stateDerivative_.a = aSplit;
+        stateDerivative_.ds = dsSplit;
 
         // Try doing a single step
         bool_t result = tryStepImpl(state_, stateDerivative_, t, dt);
@@ -33,12 +43,16 @@ namespace jiminy
         // Make sure everything went fine
         if (result)
         {
-            for (vectorN_t const & a : stateDerivative_.a)
+            for (std::vector<vectorN_t> const * derivatives : {&stateDerivative_.a,
+                                                               &stateDerivative_.ds})
             {
-                if ((a.array() != a.array()).any())
+                for (vectorN_t const & x : *derivatives)
                 {
-                    dt = qNAN;
-                    result = false;
+                    if ((x.array() != x.array()).any())
+                    {
+                        dt = qNAN;
+                        result = false;
+                    }
                 }
             }
         }
@@ -46,18 +60,89 @@ namespace jiminy
         // Update output if successfull
         if (result)
         {
+            tPrev_ = t;
+            dtPrev_ = t_next - t;
             t = t_next;
             qSplit = state_.q;
             vSplit = state_.v;
+            sSplit = state_.s;
             aSplit = stateDerivative_.a;
+            dsSplit = stateDerivative_.ds;
         }
         return result;
     }
 
+    bool_t AbstractStepper::interpolate(float64_t              const & t,
+                                        std::vector<vectorN_t>       & qSplit,
+                                        std::vector<vectorN_t>       & vSplit,
+                                        std::vector<vectorN_t>       & sSplit,
+                                        std::vector<vectorN_t>       & aSplit,
+                                        std::vector<vectorN_t>       & dsSplit)
+    {
+        // Make sure that the requested time is within the last successful step
+        if (dtPrev_ < STEPPER_MIN_TIMESTEP
+         || t < tPrev_ - STEPPER_MIN_TIMESTEP
+         || tPrev_ + dtPrev_ + STEPPER_MIN_TIMESTEP < t)
+        {
+            return false;
+        }
+
+        // Evaluate the continuous extension
+        float64_t const ratio = std::min(std::max((t - tPrev_) / dtPrev_, 0.0), 1.0);
+        if (!interpolateImpl(ratio, dtPrev_, stateInterp_, stateDerivativeInterp_))
+        {
+            return false;
+        }
+
+        // Update output
+        qSplit = stateInterp_.q;
+        vSplit = stateInterp_.v;
+        sSplit = stateInterp_.s;
+        aSplit = stateDerivativeInterp_.a;
+        dsSplit = stateDerivativeInterp_.ds;
+        return true;
+    }
+
+    void AbstractStepper::getDenseOutput(stepperDenseOutput_t & denseOutput) const
+    {
+        denseOutput.tPrev = tPrev_;
+        denseOutput.dtPrev = dtPrev_;
+        getDenseOutputImpl(denseOutput.buffers);
+    }
+
+    bool_t AbstractStepper::setDenseOutput(stepperDenseOutput_t const & denseOutput)
+    {
+        if (!setDenseOutputImpl(denseOutput.buffers))
+        {
+            return false;
+        }
+        tPrev_ = denseOutput.tPrev;
+        dtPrev_ = denseOutput.dtPrev;
+        return true;
+    }
+
+    bool_t AbstractStepper::interpolateImpl(float64_t         const & /* ratio */,
+                                            float64_t         const & /* dt */,
+                                            state_t                 & /* state */,
+                                            stateDerivative_t       & /* stateDerivative */)
+    {
+        return false;
+    }
+
+    void AbstractStepper::getDenseOutputImpl(std::vector<vectorN_t> & buffers) const
+    {
+        buffers.clear();
+    }
+
+    bool_t AbstractStepper::setDenseOutputImpl(std::vector<vectorN_t> const & buffers)
+    {
+        return buffers.empty();
+    }
+
     stateDerivative_t const & AbstractStepper::f(float64_t const & t,
                                                  state_t   const & state)
     {
-        f_(t, state.q, state.v, fOutput_.a);
+        f_(t, state.q, state.v, state.s, fOutput_.a, fOutput_.ds);
         fOutput_.v = state.v;
         return fOutput_;
     }
@@ -23,6 +23,17 @@ namespace jiminy
         return adjustStepImpl(error, dt);
     }
 
+    void RungeKuttaDOPRIStepper::computeDenseOutputWeights(float64_t const & ratio,
+                                                           vectorN_t       & weights,
+                                                           vectorN_t       & weightsDerivative) const
+    {
+        // Cubic Hermite interpolation, then add the 4th-order correction
+        AbstractRungeKuttaStepper::computeDenseOutputWeights(ratio, weights, weightsDerivative);
+        float64_t const ratioBis = ratio * (1.0 - ratio);
+        weights.head(DOPRI::d.size()) += (ratioBis * ratioBis) * DOPRI::d;
+        weightsDerivative.head(DOPRI::d.size()) += (2.0 * ratioBis * (1.0 - 2.0 * ratio)) * DOPRI::d;
+    }
+
     float64_t RungeKuttaDOPRIStepper::computeError(state_t const & initialState,
                                                    state_t const & solution,
                                                    float64_t const & dt)
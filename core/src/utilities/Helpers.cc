@@ -1,3 +1,5 @@
+#include <atomic>
+
 #ifndef _WIN32
 #include <pwd.h>
 #include <unistd.h>
@@ -80,6 +82,60 @@ namespace jiminy
     }
     #endif
 
+    // ********************* Versioning utilities *******************
+
+    std::size_t generateVersion(void)
+    {
+        static std::atomic<std::size_t> version{0U};
+        return ++version;
+    }
+
+    // ******************* Configuration utilities ******************
+
+    hresult_t getConfigField(configHolder_t const   & config,
+                             std::string    const   & path,
+                             configField_t  const * & field)
+    {
+        field = nullptr;
+
+        configHolder_t const * configNested = &config;
+        std::size_t posBegin = 0U;
+        while (true)
+        {
+            std::size_t const posEnd = path.find('/', posBegin);
+            std::string const name = path.substr(posBegin, posEnd - posBegin);
+            auto const fieldIt = configNested->find(name);
+            if (fieldIt == configNested->end())
+            {
+                PRINT_ERROR("Option '", path, "' does not exist.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            if (posEnd == std::string::npos)
+            {
+                field = &fieldIt->second;
+                return hresult_t::SUCCESS;
+            }
+            configNested = boost::get<configHolder_t>(&fieldIt->second);
+            if (!configNested)
+            {
+                PRINT_ERROR("Option '", path.substr(0, posEnd), "' is not a group of options.");
+                return hresult_t::ERROR_BAD_INPUT;
+            }
+            posBegin = posEnd + 1;
+        }
+    }
+
+    hresult_t getConfigField(configHolder_t       & config,
+                             std::string    const & path,
+                             configField_t      * & field)
+    {
+        configField_t const * fieldConst;
+        hresult_t const returnCode = getConfigField(
+            const_cast<configHolder_t const &>(config), path, fieldConst);
+        field = const_cast<configField_t *>(fieldConst);
+        return returnCode;
+    }
+
     // ******************* Telemetry utilities **********************
 
     bool_t endsWith(std::string const & fullString, std::string const & ending)
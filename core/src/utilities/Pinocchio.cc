@@ -1,5 +1,14 @@
 #include <numeric>
-
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <system_error>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "pinocchio/config.hpp"                            // `PINOCCHIO_VERSION`
 #include "pinocchio/parsers/urdf.hpp"                      // `pinocchio::urdf::buildGeom`, `pinocchio::urdf::buildModel`
 #include "pinocchio/spatial/se3.hpp"                       // `pinocchio::SE3`
 #include "pinocchio/spatial/force.hpp"                     // `pinocchio::Force`
@@ -14,7 +23,12 @@
 
 #include "hpp/fcl/mesh_loader/loader.h"
 #include "hpp/fcl/BVH/BVH_model.h"
+#include "hpp/fcl/config.hh"                               // `HPP_FCL_VERSION`
+
+#include <boost/filesystem.hpp>
+#include <boost/version.hpp>                               // `BOOST_LIB_VERSION`
 
+#include "jiminy/core/io/Serialization.h"
 #include "jiminy/core/utilities/Helpers.h"
 #include "jiminy/core/utilities/Pinocchio.h"
 
@@ -962,23 +976,204 @@ namespace jiminy
         return joint_M_global.act(fextInGlobal);
     }
 
-    class DummyMeshLoader : public hpp::fcl::MeshLoader
+    namespace
     {
-    public:
-        virtual ~DummyMeshLoader() {}
+        /// \brief Mesh loader that does not load anything, but keeps track of the meshes to
+        ///        load, so that they can be loaded afterward in parallel.
+        class DeferredMeshLoader : public hpp::fcl::MeshLoader
+        {
+        public:
+            struct meshRequest_t
+            {
+                std::string filename;
+                hpp::fcl::Vec3f scale;
+            };
+
+        public:
+            virtual ~DeferredMeshLoader() {}
+
+            DeferredMeshLoader(void) :
+            MeshLoader(hpp::fcl::BV_OBBRSS),
+            requests_()
+            {
+                // Empty on purpose
+            }
+
+            virtual hpp::fcl::BVHModelPtr_t load(std::string     const & filename,
+                                                 hpp::fcl::Vec3f const & scale) override final
+            {
+                hpp::fcl::BVHModelPtr_t placeholder(new hpp::fcl::BVHModel<hpp::fcl::OBBRSS>);
+                requests_.emplace(placeholder.get(), meshRequest_t{filename, scale});
+                return placeholder;
+            }
 
-        DummyMeshLoader(void) :
-        MeshLoader(hpp::fcl::BV_OBBRSS)
+        public:
+            /// \brief Mesh to load for each placeholder geometry
+            std::unordered_map<hpp::fcl::CollisionGeometry const *, meshRequest_t> requests_;
+        };
+
+        /// \brief Run a task for every index in [0, n) over a pool of threads, the indices
+        ///        being distributed dynamically since the tasks may be very unbalanced.
+        ///
+        /// \details The calling thread takes part in the work, so that no thread is spawned if
+        ///          a single one is requested. If a task throws, the remaining indices are
+        ///          skipped, then the first exception is rethrown by the calling thread once all
+        ///          the threads have been joined.
+        template<typename Function>
+        void parallelFor(std::size_t const & n,
+                         uint32_t    const & nThreads,
+                         Function         && task)
         {
-            // Empty on purpose
+            std::atomic<std::size_t> nextIdx(0U);
+            std::exception_ptr exception;
+            std::mutex exceptionMutex;
+            auto worker = [&n, &task, &nextIdx, &exception, &exceptionMutex](void) -> void
+                          {
+                              try
+                              {
+                                  for (std::size_t i = nextIdx++; i < n; i = nextIdx++)
+                                  {
+                                      task(i);
+                                  }
+                              }
+                              catch (...)
+                              {
+                                  std::lock_guard<std::mutex> lock(exceptionMutex);
+                                  if (!exception)
+                                  {
+                                      exception = std::current_exception();
+                                  }
+                                  nextIdx = n;
+                              }
+                          };
+
+            // Spawn the threads. Keep going with the ones available if the system runs out of them.
+            std::size_t const nWorkers = std::min(n, static_cast<std::size_t>(nThreads));
+            std::vector<std::thread> threads;
+            threads.reserve(nWorkers);
+            for (std::size_t i = 1; i < nWorkers; ++i)
+            {
+                try
+                {
+                    threads.emplace_back(worker);
+                }
+                catch (std::system_error const &)
+                {
+                    break;
+                }
+            }
+            worker();
+            for (std::thread & thread : threads)
+            {
+                thread.join();
+            }
+
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
         }
 
-        virtual hpp::fcl::BVHModelPtr_t load(std::string     const & /* filename */,
-                                             hpp::fcl::Vec3f const & /* scale */) override final
+        /// \brief Build a geometry model from either the path of a URDF file, or a stream of its
+        ///        content, see `buildGeomFromUrdf`.
+        template<typename UrdfSource>
+        hresult_t buildGeomFromUrdfSource(pinocchio::Model         const & model,
+                                          UrdfSource               const & urdfSource,
+                                          pinocchio::GeometryType  const & type,
+                                          pinocchio::GeometryModel       & geomModel,
+                                          std::vector<std::string> const & packageDirs,
+                                          bool_t                   const & loadMeshes,
+                                          bool_t                   const & makeConvexMeshes,
+                                          uint32_t                 const & nThreads)
         {
-            return hpp::fcl::BVHModelPtr_t(new hpp::fcl::BVHModel<hpp::fcl::OBBRSS>);
+            /* Load geometry model, without loading the meshes. They are loaded afterward in
+               parallel if requested, since it is by far the most time consuming part. */
+            boost::shared_ptr<DeferredMeshLoader> meshLoader(new DeferredMeshLoader);
+            try
+            {
+                pinocchio::urdf::buildGeom(model, urdfSource, type, geomModel, packageDirs, meshLoader);
+            }
+            catch (std::exception const & e)
+            {
+                PRINT_ERROR("Something is wrong with the URDF. Impossible to load the collision geometries.\n"
+                            "Raised from exception: ", e.what());
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            /* Load the meshes and replace them by their convex representation if necessary.
+               Each geometry object is processed independently, and the result is stored in
+               place, so that the ordering of the geometry model is deterministic. */
+            std::size_t const nGeometries = geomModel.geometryObjects.size();
+            std::vector<std::string> errors(nGeometries);
+            std::atomic<bool_t> isQhullAvailable(true);
+            uint32_t const nThreadsMax = std::max(std::thread::hardware_concurrency(), 1U);
+            try
+            {
+                parallelFor(nGeometries, (nThreads > 0U) ? std::min(nThreads, nThreadsMax) : nThreadsMax,
+                    [&](std::size_t const & i) -> void
+                    {
+                        auto & geometry = geomModel.geometryObjects[i].geometry;
+                        auto requestIt = meshLoader->requests_.find(geometry.get());
+                        if (loadMeshes && requestIt != meshLoader->requests_.end())
+                        {
+                            try
+                            {
+                                hpp::fcl::MeshLoader loader(hpp::fcl::BV_OBBRSS);
+                                geometry = loader.load(requestIt->second.filename, requestIt->second.scale);
+                            }
+                            catch (std::exception const & e)
+                            {
+                                errors[i] = e.what();
+                                return;
+                            }
+                        }
+                        if (makeConvexMeshes && isQhullAvailable &&
+                            geometry->getObjectType() == hpp::fcl::OT_BVH)
+                        {
+                            try
+                            {
+                                hpp::fcl::BVHModelPtr_t bvh = boost::static_pointer_cast<hpp::fcl::BVHModelBase>(geometry);
+                                bvh->buildConvexHull(true);
+                                geometry = bvh->convex;
+                            }
+                            catch (std::logic_error const &)
+                            {
+                                isQhullAvailable = false;
+                            }
+                        }
+                    });
+            }
+            catch (std::exception const & e)
+            {
+                PRINT_ERROR("Impossible to load the meshes.\n"
+                            "Raised from exception: ", e.what());
+                return hresult_t::ERROR_GENERIC;
+            }
+            catch (...)
+            {
+                PRINT_ERROR("Impossible to load the meshes. Unknown exception.");
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            // Report the first error, if any
+            for (std::size_t i = 0; i < nGeometries; ++i)
+            {
+                if (!errors[i].empty())
+                {
+                    PRINT_ERROR("Impossible to load the mesh of geometry '",
+                                geomModel.geometryObjects[i].name, "'.\n"
+                                "Raised from exception: ", errors[i]);
+                    return hresult_t::ERROR_GENERIC;
+                }
+            }
+            if (!isQhullAvailable)
+            {
+                PRINT_WARNING("hpp-fcl not built with qhull. Impossible to convert meshes to convex hulls.");
+            }
+
+            return hresult_t::SUCCESS;
         }
-    };
+    }
 
     hresult_t buildGeomFromUrdf(pinocchio::Model         const & model,
                                 std::string              const & filename,
@@ -986,51 +1181,232 @@ namespace jiminy
                                 pinocchio::GeometryModel       & geomModel,
                                 std::vector<std::string> const & packageDirs,
                                 bool_t                   const & loadMeshes,
-                                bool_t                   const & makeConvexMeshes)
+                                bool_t                   const & makeConvexMeshes,
+                                uint32_t                 const & nThreads)
     {
-        // Load geometry model
-        try
+        return buildGeomFromUrdfSource(
+            model, filename, type, geomModel, packageDirs, loadMeshes, makeConvexMeshes, nThreads);
+    }
+
+    namespace
+    {
+        /// \brief Version of the layout of the model cache files, to be incremented every time
+        ///        the serialization of the models changes.
+        uint32_t const MODEL_CACHE_VERSION = 2U;
+
+        /// \brief Versions of the libraries involved in building and serializing the models. The
+        ///        layout of the serialized models may change with any of them.
+        std::string const MODEL_CACHE_LIBRARIES_VERSION =
+            "pinocchio " PINOCCHIO_VERSION ", hpp-fcl " HPP_FCL_VERSION ", boost " BOOST_LIB_VERSION;
+
+        /// \brief Update a 64-bit FNV-1a hash with the given bytes.
+        ///
+        /// \details Unlike `std::hash` or `boost::hash`, it does not depend on the platform, the
+        ///          compiler or the version of the standard library, which is required for a key
+        ///          of a cache stored on disk.
+        void hashFnv1a(uint64_t & hash, void const * data, std::size_t size)
         {
-            if (loadMeshes)
+            uint64_t const FNV_PRIME = 0x100000001b3ULL;
+            for (uint8_t const * byte = static_cast<uint8_t const *>(data);
+                 byte != static_cast<uint8_t const *>(data) + size; ++byte)
             {
-                pinocchio::urdf::buildGeom(model, filename, type, geomModel, packageDirs);
+                hash ^= *byte;
+                hash *= FNV_PRIME;
             }
-            else
+        }
+
+        /// \brief Update a 64-bit FNV-1a hash with a string, prefixed by its size so that the
+        ///        concatenation of several strings is not ambiguous.
+        void hashFnv1a(uint64_t & hash, std::string const & str)
+        {
+            uint64_t const size = str.size();
+            hashFnv1a(hash, &size, sizeof(size));
+            hashFnv1a(hash, str.data(), str.size());
+        }
+
+        /// \brief Path of the cache file storing the models built from the content of a URDF file.
+        ///
+        /// \param[in] flags Options of the build, including which models are stored.
+        std::string getModelsCachePath(std::string              const & cacheDir,
+                                       std::string              const & urdfData,
+                                       std::vector<std::string> const & meshPackageDirs,
+                                       std::vector<uint8_t>     const & flags)
+        {
+            uint64_t cacheKey = 0xcbf29ce484222325ULL;  // FNV-1a offset basis
+            hashFnv1a(cacheKey, &MODEL_CACHE_VERSION, sizeof(MODEL_CACHE_VERSION));
+            hashFnv1a(cacheKey, MODEL_CACHE_LIBRARIES_VERSION);
+            hashFnv1a(cacheKey, urdfData);
+            hashFnv1a(cacheKey, flags.data(), flags.size());
+            for (std::string const & meshPackageDir : meshPackageDirs)
             {
-                hpp::fcl::MeshLoaderPtr MeshLoaderPtr(new DummyMeshLoader);
-                pinocchio::urdf::buildGeom(model, filename, type, geomModel, packageDirs, MeshLoaderPtr);
+                hashFnv1a(cacheKey, meshPackageDir);
             }
+            std::ostringstream cacheName;
+            cacheName << "model_" << std::hex << std::setw(16) << std::setfill('0') << cacheKey << ".bin";
+            return (boost::filesystem::path(cacheDir) / cacheName.str()).string();
         }
-        catch (std::exception const & e)
+
+        bool_t isMeshPath(std::string const & meshPath)
         {
-            PRINT_ERROR("Something is wrong with the URDF. Impossible to load the collision geometries.\n"
-                        "Raised from exception: ", e.what());
-            return hresult_t::ERROR_GENERIC;
+            // 'meshPath' is the geometry type if it is not an actual mesh
+            return (meshPath.find('/') != std::string::npos ||
+                    meshPath.find('\\') != std::string::npos);
         }
 
-        // Replace the mesh geometry object by its convex representation if necessary
-        if (makeConvexMeshes)
+        hresult_t loadModelsFromCache(std::string const & cachePath,
+                                      std::optional<std::reference_wrapper<pinocchio::Model> > pncModel,
+                                      std::optional<std::reference_wrapper<pinocchio::GeometryModel> > collisionModel,
+                                      std::optional<std::reference_wrapper<pinocchio::GeometryModel> > visualModel)
         {
+            boost::system::error_code errorCode;
+
+            // Get the modification time of the cache, if available
+            std::time_t const cacheTime = boost::filesystem::last_write_time(cachePath, errorCode);
+            if (errorCode)
+            {
+                return hresult_t::ERROR_GENERIC;  // The cache does not exist. Nothing to do.
+            }
+
+            // Read the whole file at once
+            std::ifstream file(cachePath, std::ios::in | std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+            {
+                return hresult_t::ERROR_GENERIC;
+            }
+            std::string data(static_cast<std::size_t>(file.tellg()), '\0');
+            file.seekg(0);
+            file.read(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file.good())
+            {
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            // Deserialize the models
+            pinocchio::Model pncModelCached;
+            pinocchio::GeometryModel collisionModelCached;
+            pinocchio::GeometryModel visualModelCached;
             try
             {
-                for (uint32_t i = 0; i < geomModel.geometryObjects.size(); ++i)
+                std::istringstream is(data);
+                boost::archive::binary_iarchive ia(is);
+                if (pncModel)
+                {
+                    ia >> pncModelCached;
+                }
+                if (collisionModel)
                 {
-                    auto & geometry = geomModel.geometryObjects[i].geometry;
-                    if (geometry->getObjectType() == hpp::fcl::OT_BVH)
+                    ia >> collisionModelCached;
+                }
+                if (visualModel)
+                {
+                    ia >> visualModelCached;
+                }
+            }
+            catch (std::exception const & e)
+            {
+                PRINT_WARNING("Model cache '", cachePath, "' is corrupted. Ignoring it.");
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            /* Make sure that no mesh has been modified since the cache has been written.
+               The resolution of the modification time is coarse, so the cache is discarded
+               conservatively if both have been modified at the same time. */
+            for (pinocchio::GeometryModel const * geomModel : {&collisionModelCached, &visualModelCached})
+            {
+                for (pinocchio::GeometryObject const & geom : geomModel->geometryObjects)
+                {
+                    if (isMeshPath(geom.meshPath))
                     {
-                        hpp::fcl::BVHModelPtr_t bvh = boost::static_pointer_cast<hpp::fcl::BVHModelBase>(geometry);
-                        bvh->buildConvexHull(true);
-                        geometry = bvh->convex;
+                        std::time_t const meshTime = boost::filesystem::last_write_time(geom.meshPath, errorCode);
+                        if (!errorCode && meshTime >= cacheTime)
+                        {
+                            return hresult_t::ERROR_GENERIC;
+                        }
                     }
                 }
             }
-            catch (std::logic_error const & e)
+
+            if (pncModel)
             {
-                PRINT_WARNING("hpp-fcl not built with qhull. Impossible to convert meshes to convex hulls.");
+                pncModel->get() = std::move(pncModelCached);
+            }
+            if (collisionModel)
+            {
+                collisionModel->get() = std::move(collisionModelCached);
+            }
+            if (visualModel)
+            {
+                visualModel->get() = std::move(visualModelCached);
             }
+
+            return hresult_t::SUCCESS;
         }
 
-        return hresult_t::SUCCESS;
+        hresult_t saveModelsToCache(std::string const & cachePath,
+                                    std::optional<std::reference_wrapper<pinocchio::Model> > pncModel,
+                                    std::optional<std::reference_wrapper<pinocchio::GeometryModel> > collisionModel,
+                                    std::optional<std::reference_wrapper<pinocchio::GeometryModel> > visualModel)
+        {
+            boost::system::error_code errorCode;
+
+            // Create the cache directory if necessary
+            boost::filesystem::path const cacheFilePath(cachePath);
+            boost::filesystem::create_directories(cacheFilePath.parent_path(), errorCode);
+            if (errorCode)
+            {
+                PRINT_WARNING("Impossible to create the model cache directory '",
+                              cacheFilePath.parent_path().string(), "'.");
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            /* Write a temporary file first, then rename it, so that other processes
+               sharing the same cache never read a partially written file. */
+            boost::filesystem::path const tmpPath = cacheFilePath.string() + "." +
+                boost::filesystem::unique_path().string() + ".tmp";
+            bool_t isWritten = false;
+            try
+            {
+                std::ofstream file(tmpPath.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+                {
+                    boost::archive::binary_oarchive oa(file);
+                    if (pncModel)
+                    {
+                        oa << static_cast<pinocchio::Model const &>(pncModel->get());
+                    }
+                    if (collisionModel)
+                    {
+                        oa << static_cast<pinocchio::GeometryModel const &>(collisionModel->get());
+                    }
+                    if (visualModel)
+                    {
+                        oa << static_cast<pinocchio::GeometryModel const &>(visualModel->get());
+                    }
+                }
+
+                // Make sure everything has been written, eg the disk is not full, before renaming
+                file.close();
+                isWritten = file.good();
+            }
+            catch (std::exception const & e)
+            {
+                isWritten = false;
+            }
+            if (!isWritten)
+            {
+                PRINT_WARNING("Impossible to write the model cache '", cachePath, "'.");
+                boost::filesystem::remove(tmpPath, errorCode);
+                return hresult_t::ERROR_GENERIC;
+            }
+            boost::filesystem::rename(tmpPath, cacheFilePath, errorCode);
+            if (errorCode)
+            {
+                PRINT_WARNING("Impossible to write the model cache '", cachePath, "'.");
+                boost::filesystem::remove(tmpPath, errorCode);
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            return hresult_t::SUCCESS;
+        }
     }
 
     hresult_t buildModelsFromUrdf(std::string const & urdfPath,
@@ -1039,17 +1415,38 @@ namespace jiminy
                                   pinocchio::Model & pncModel,
                                   pinocchio::GeometryModel & collisionModel,
                                   std::optional<std::reference_wrapper<pinocchio::GeometryModel> > visualModel,
-                                  bool_t const & loadVisualMeshes)
+                                  bool_t const & loadVisualMeshes,
+                                  std::string const & cacheDir,
+                                  uint32_t const & nThreads)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
         // Make sure the URDF file exists
-        if (!std::ifstream(urdfPath).good())
+        std::ifstream urdfFileStream(urdfPath, std::ios::in | std::ios::binary);
+        if (!urdfFileStream.good())
         {
             PRINT_ERROR("The URDF file '", urdfPath, "' is invalid.");
             return hresult_t::ERROR_BAD_INPUT;
         }
 
+        /* Load the models from the cache if available.
+           Its key depends on the content of the URDF file rather than its path. */
+        std::string cachePath;
+        if (!cacheDir.empty())
+        {
+            std::string const urdfData((std::istreambuf_iterator<char_t>(urdfFileStream)),
+                                        std::istreambuf_iterator<char_t>());
+            cachePath = getModelsCachePath(cacheDir, urdfData, meshPackageDirs,
+                                           {static_cast<uint8_t>(hasFreeflyer),
+                                            static_cast<uint8_t>(visualModel.has_value()),
+                                            static_cast<uint8_t>(loadVisualMeshes)});
+
+            if (loadModelsFromCache(cachePath, pncModel, collisionModel, visualModel) == hresult_t::SUCCESS)
+            {
+                return hresult_t::SUCCESS;
+            }
+        }
+
         // Build physics model
         try
         {
@@ -1079,7 +1476,8 @@ namespace jiminy
                                            collisionModel,
                                            meshPackageDirs,
                                            true,
-                                           true);
+                                           true,
+                                           nThreads);
         }
 
         // Build visual model
@@ -1093,10 +1491,137 @@ namespace jiminy
                                                *visualModel,
                                                meshPackageDirs,
                                                loadVisualMeshes,
-                                               false);
+                                               false,
+                                               nThreads);
             }
         }
 
+        // Store the models in cache. Failing to do so is not an error.
+        if (returnCode == hresult_t::SUCCESS && !cachePath.empty())
+        {
+            saveModelsToCache(cachePath, pncModel, collisionModel, visualModel);
+        }
+
         return returnCode;
     }
+
+    hresult_t buildVisualModelFromUrdf(std::string const & urdfData,
+                                       bool_t const & hasFreeflyer,
+                                       std::vector<std::string> const & meshPackageDirs,
+                                       pinocchio::Model const & pncModel,
+                                       pinocchio::GeometryModel & visualModel,
+                                       bool_t const & loadVisualMeshes,
+                                       std::string const & cacheDir,
+                                       uint32_t const & nThreads)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        /* Load the visual model from the cache if available. It is stored alone, with a key
+           of its own, since the other models have been built already. */
+        std::string cachePath;
+        if (!cacheDir.empty())
+        {
+            cachePath = getModelsCachePath(cacheDir, urdfData, meshPackageDirs,
+                                           {static_cast<uint8_t>(hasFreeflyer),
+                                            static_cast<uint8_t>(true),
+                                            static_cast<uint8_t>(loadVisualMeshes),
+                                            static_cast<uint8_t>(true)});  // Visual model only
+            if (loadModelsFromCache(cachePath, std::nullopt, std::nullopt, visualModel) == hresult_t::SUCCESS)
+            {
+                return hresult_t::SUCCESS;
+            }
+        }
+
+        // Build visual model
+        std::istringstream urdfStream(urdfData);
+        returnCode = buildGeomFromUrdfSource(pncModel,
+                                             urdfStream,
+                                             pinocchio::VISUAL,
+                                             visualModel,
+                                             meshPackageDirs,
+                                             loadVisualMeshes,
+                                             false,
+                                             nThreads);
+
+        // Store the visual model in cache. Failing to do so is not an error.
+        if (returnCode == hresult_t::SUCCESS && !cachePath.empty())
+        {
+            saveModelsToCache(cachePath, std::nullopt, std::nullopt, visualModel);
+        }
+
+        return returnCode;
+    }
+
+    struct hashJointAxisAlgo
+    : public pinocchio::fusion::JointUnaryVisitorBase<hashJointAxisAlgo>
+    {
+        typedef boost::fusion::vector<std::size_t & /* seed */> ArgsType;
+
+        template<typename JointModel>
+        static void algo(pinocchio::JointModelBase<JointModel> const & model,
+                         std::size_t & seed)
+        {
+            hashJointAxis(model.derived(), seed);
+        }
+
+        template<typename JointModel>
+        static std::enable_if_t<is_pinocchio_joint_prismatic_unaligned_v<JointModel>
+                             || is_pinocchio_joint_revolute_unaligned_v<JointModel>
+                             || is_pinocchio_joint_revolute_unbounded_unaligned_v<JointModel>, void>
+        hashJointAxis(JointModel const & model,
+                      std::size_t & seed)
+        {
+            hashCombine(seed, model.axis);
+        }
+
+        template<typename JointModel>
+        static std::enable_if_t<!(is_pinocchio_joint_prismatic_unaligned_v<JointModel>
+                               || is_pinocchio_joint_revolute_unaligned_v<JointModel>
+                               || is_pinocchio_joint_revolute_unbounded_unaligned_v<JointModel>), void>
+        hashJointAxis(JointModel const & /* model */,
+                      std::size_t & /* seed */)
+        {
+            // The axis of the other joints is fully determined by their type
+        }
+    };
+
+    std::size_t hashModel(pinocchio::Model const & model)
+    {
+        std::size_t seed = 0U;
+        hashCombine(seed, model.nq);
+        hashCombine(seed, model.nv);
+        hashCombine(seed, model.njoints);
+        hashCombine(seed, model.nframes);
+        for (jointIndex_t i = 0; i < static_cast<jointIndex_t>(model.njoints); ++i)
+        {
+            hashCombine(seed, model.names[i]);
+            hashCombine(seed, model.joints[i].shortname());
+            hashJointAxisAlgo::run(model.joints[i], typename hashJointAxisAlgo::ArgsType(seed));
+            hashCombine(seed, model.parents[i]);
+            hashCombine(seed, model.jointPlacements[i].translation());
+            hashCombine(seed, model.jointPlacements[i].rotation());
+            hashCombine(seed, model.inertias[i].mass());
+            hashCombine(seed, model.inertias[i].lever());
+            hashCombine(seed, model.inertias[i].inertia().data());
+        }
+        for (pinocchio::Frame const & frame : model.frames)
+        {
+            hashCombine(seed, frame.name);
+            hashCombine(seed, frame.parent);
+            hashCombine(seed, frame.previousFrame);
+            hashCombine(seed, static_cast<int32_t>(frame.type));
+            hashCombine(seed, frame.placement.translation());
+            hashCombine(seed, frame.placement.rotation());
+        }
+        hashCombine(seed, model.gravity.toVector());
+        hashCombine(seed, model.lowerPositionLimit);
+        hashCombine(seed, model.upperPositionLimit);
+        hashCombine(seed, model.velocityLimit);
+        hashCombine(seed, model.effortLimit);
+        hashCombine(seed, model.rotorInertia);
+        hashCombine(seed, model.rotorGearRatio);
+        hashCombine(seed, model.friction);
+        hashCombine(seed, model.damping);
+        return seed;
+    }
 }
@@ -137,6 +137,16 @@ namespace jiminy
         return hresult_t::SUCCESS;
     }
 
+    std::mt19937 const & getRandomGenerator(void)
+    {
+        return generator_;
+    }
+
+    void setRandomGenerator(std::mt19937 const & generator)
+    {
+        generator_ = generator;
+    }
+
     float64_t randUniform(float64_t const & lo,
                           float64_t const & hi)
     {
@@ -0,0 +1,268 @@
+// Test the contact dynamics of the simulation engine.
+// The test system is the double pendulum, with contact points at both masses.
+#include <gtest/gtest.h>
+
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/solver/ConstraintSolvers.h"
+#include "jiminy/core/utilities/Helpers.h"
+#include "jiminy/core/Constants.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+std::vector<std::string> const CONTACT_FRAME_NAMES{"PendulumMass", "SecondPendulumMass"};
+
+
+TEST(ContactDynamics, BatchedSpringDamperMatchesPerFrame)
+{
+    // Verify that the contact forces computed for every contact frames at once match
+    // the spring-damper contact law evaluated frame by frame.
+
+    // Double pendulum with a contact point at both masses
+    auto robot = createDoublePendulum(false);
+    robot->addContactPoints(CONTACT_FRAME_NAMES);
+    pinocchio::Model const & model = robot->pncModel_;
+
+    // Both masses at the same height, moving in different directions
+    vectorN_t q0(2);
+    q0 << 2.8, 3.0 * M_PI / 2.0 - 2.8;
+    vectorN_t v0(2);
+    v0 << 0.5, -0.3;
+
+    // Compute the kinematics of the contact frames independently from the engine
+    pinocchio::Data data(model);
+    pinocchio::forwardKinematics(model, data, q0, v0);
+    pinocchio::updateFramePlacements(model, data);
+    std::vector<frameIndex_t> const & contactFramesIdx = robot->getContactFramesIdx();
+    float64_t zMax = -INF;
+    for (frameIndex_t const & frameIdx : contactFramesIdx)
+    {
+        zMax = std::max(zMax, data.oMf[frameIdx].translation()[2]);
+    }
+
+    // Flat but tilted ground slightly above both masses
+    float64_t const zGround = zMax + 2.0e-3;
+    vector3_t const nGround = vector3_t(0.0, 0.1, 1.0).normalized();
+    float64_t const stiffness = 1.0e6;
+    float64_t const damping = 2.0e3;
+    float64_t const friction = 0.8;
+    float64_t const transitionEps = 1.0e-3;
+    float64_t const transitionVelocity = 1.0e-2;
+
+    // Create and configure the engine
+    auto engine = std::make_shared<Engine>();
+    engine->initialize(robot, callbackNoStop);
+    configHolder_t simuOptions = engine->getDefaultEngineOptions();
+    configHolder_t & contactsOptions = boost::get<configHolder_t>(simuOptions.at("contacts"));
+    boost::get<std::string>(contactsOptions.at("model")) = std::string("spring_damper");
+    boost::get<float64_t>(contactsOptions.at("stiffness")) = stiffness;
+    boost::get<float64_t>(contactsOptions.at("damping")) = damping;
+    boost::get<float64_t>(contactsOptions.at("friction")) = friction;
+    boost::get<float64_t>(contactsOptions.at("transitionEps")) = transitionEps;
+    boost::get<float64_t>(contactsOptions.at("transitionVelocity")) = transitionVelocity;
+    boost::get<heightmapFunctor_t>(boost::get<configHolder_t>(simuOptions.at("world")).at("groundProfile")) =
+        [zGround, nGround](vector3_t const & /* pos */) -> std::pair<float64_t, vector3_t>
+        {
+            return {zGround, nGround};
+        };
+    ASSERT_EQ(engine->setOptions(simuOptions), hresult_t::SUCCESS);
+
+    // Compute the dynamics at the initial state
+    engine->reset();
+    ASSERT_EQ(engine->start(q0, v0), hresult_t::SUCCESS);
+
+    // Compare the contact forces with the per-frame contact law
+    for (std::size_t i = 0; i < contactFramesIdx.size(); ++i)
+    {
+        frameIndex_t const & frameIdx = contactFramesIdx[i];
+        vector3_t const & posFrame = data.oMf[frameIdx].translation();
+        vector3_t const vFrame = pinocchio::getFrameVelocity(
+            model, data, frameIdx, pinocchio::LOCAL_WORLD_ALIGNED).linear();
+
+        float64_t const depth = (posFrame[2] - zGround) * nGround[2];
+        ASSERT_LT(depth, 0.0);
+        float64_t const vDepth = vFrame.dot(nGround);
+        float64_t const fextNormal = - std::min(stiffness * depth + damping * vDepth, 0.0);
+        vector3_t const vTangential = vFrame - vDepth * nGround;
+        float64_t const vRatio = std::min(vTangential.norm() / transitionVelocity, 1.0);
+        vector3_t fextInWorld = fextNormal * nGround - friction * vRatio * fextNormal * vTangential;
+        fextInWorld *= std::tanh(- 2.0 * depth / transitionEps);
+        vector3_t const fextInFrame = data.oMf[frameIdx].rotation().transpose() * fextInWorld;
+
+        pinocchio::Force const & fextEngine = robot->contactForces_[i];
+        ASSERT_GT(fextInFrame.norm(), 0.0);
+        ASSERT_TRUE(fextEngine.linear().isApprox(fextInFrame, TOLERANCE));
+        ASSERT_NEAR(fextEngine.angular().norm(), 0.0, TOLERANCE * fextInFrame.norm());
+    }
+
+    engine->stop();
+}
+
+
+// Simulate the double pendulum falling on the ground and return the minimum distance to the
+// ground of the first mass among the two logged samples surrounding its first touchdown.
+static float64_t simulateTouchdown(bool_t const & detectContactEvents,
+                                   float64_t const & updatePeriod)
+{
+    float64_t const zGround = -0.5;
+
+    auto robot = createDoublePendulum(false);
+    robot->addContactPoints({CONTACT_FRAME_NAMES[0]});
+
+    auto engine = std::make_shared<Engine>();
+    engine->initialize(robot, callbackNoStop);
+    configHolder_t simuOptions = engine->getDefaultEngineOptions();
+    configHolder_t & stepperOptions = boost::get<configHolder_t>(simuOptions.at("stepper"));
+    boost::get<bool_t>(stepperOptions.at("detectContactEvents")) = detectContactEvents;
+    boost::get<bool_t>(stepperOptions.at("logInternalStepperSteps")) = true;
+    boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod")) = updatePeriod;
+    boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod")) = updatePeriod;
+    boost::get<std::string>(boost::get<configHolder_t>(simuOptions.at("contacts")).at("model")) =
+        std::string("spring_damper");
+    boost::get<heightmapFunctor_t>(boost::get<configHolder_t>(simuOptions.at("world")).at("groundProfile")) =
+        [zGround](vector3_t const & /* pos */) -> std::pair<float64_t, vector3_t>
+        {
+            return {zGround, vector3_t::UnitZ()};
+        };
+    engine->setOptions(simuOptions);
+
+    // Release the pendulum in horizontal position
+    vectorN_t q0 = vectorN_t::Zero(2);
+    q0[0] = M_PI / 2.0;
+    vectorN_t v0 = vectorN_t::Zero(2);
+    engine->reset();
+    EXPECT_EQ(engine->simulate(1.0, q0, v0), hresult_t::SUCCESS);
+
+    // Extract the logged configurations
+    std::vector<std::string> fieldnames;
+    matrixN_t logData;
+    engine->getLogData(fieldnames, logData);
+    std::vector<std::string> const & positionFieldnames = robot->getPositionFieldnames();
+    matrixN_t qLog(logData.rows(), static_cast<Eigen::Index>(positionFieldnames.size()));
+    for (std::size_t i = 0; i < positionFieldnames.size(); ++i)
+    {
+        qLog.col(static_cast<Eigen::Index>(i)) = getLogFieldValue(
+            ENGINE_TELEMETRY_NAMESPACE + TELEMETRY_FIELDNAME_DELIMITER + positionFieldnames[i],
+            fieldnames, logData);
+    }
+
+    // Find the first touchdown of the first mass
+    pinocchio::Model const & model = robot->pncModel_;
+    pinocchio::Data data(model);
+    frameIndex_t const & frameIdx = robot->getContactFramesIdx()[0];
+    float64_t depthPrev = INF;
+    for (Eigen::Index i = 0; i < qLog.rows(); ++i)
+    {
+        pinocchio::framesForwardKinematics(model, data, qLog.row(i).transpose());
+        float64_t const depth = data.oMf[frameIdx].translation()[2] - zGround;
+        if (depth < 0.0 && depthPrev >= 0.0)
+        {
+            return std::min(std::abs(depthPrev), std::abs(depth));
+        }
+        depthPrev = depth;
+    }
+    return INF;
+}
+
+
+TEST(ContactDynamics, ContactEventsAreBreakpoints)
+{
+    // Verify that the integration steps end up exactly at touchdown if contact
+    // events detection is enabled, both in continuous and discrete-time mode.
+    for (float64_t const & updatePeriod : {0.0, 1.0e-2})
+    {
+        // A step ends at touchdown up to SIMULATION_MIN_TIMESTEP
+        ASSERT_LT(simulateTouchdown(true, updatePeriod), 1.0e-5);
+    }
+}
+
+
+// Create the double pendulum with contact points at the given masses.
+static std::shared_ptr<Robot> createContactPendulum(std::vector<std::string> const & contactFrameNames)
+{
+    auto robot = createDoublePendulum(false);
+    robot->addContactPoints(contactFrameNames);
+    return robot;
+}
+
+
+// Create the engine simulating the double pendulum falling on the ground, using the constraint
+// contact model.
+static std::shared_ptr<Engine> createFallingPendulumEngine(std::shared_ptr<Robot> const & robot,
+                                                           float64_t const & friction)
+{
+    auto engine = std::make_shared<Engine>();
+    engine->initialize(robot, callbackNoStop);
+    configHolder_t simuOptions = engine->getDefaultEngineOptions();
+    configHolder_t & contactsOptions = boost::get<configHolder_t>(simuOptions.at("contacts"));
+    boost::get<std::string>(contactsOptions.at("model")) = std::string("constraint");
+    boost::get<float64_t>(contactsOptions.at("friction")) = friction;
+    boost::get<heightmapFunctor_t>(boost::get<configHolder_t>(simuOptions.at("world")).at("groundProfile")) =
+        [](vector3_t const & /* pos */) -> std::pair<float64_t, vector3_t>
+        {
+            return {-0.5, vector3_t::UnitZ()};
+        };
+    engine->setOptions(simuOptions);
+    return engine;
+}
+
+
+// Simulate the double pendulum released in horizontal position, and return its final state.
+static vectorN_t simulateFall(Engine & engine)
+{
+    vectorN_t q0 = vectorN_t::Zero(2);
+    q0[0] = M_PI / 2.0;
+    vectorN_t const v0 = vectorN_t::Zero(2);
+    EXPECT_EQ(engine.simulate(1.0, q0, v0), hresult_t::SUCCESS);
+
+    systemState_t const * systemState;
+    engine.getSystemState(systemState);
+    vectorN_t x(4);
+    x << systemState->q, systemState->v;
+    return x;
+}
+
+
+TEST(ContactDynamics, SuccessiveSimulationsMatchFreshEngine)
+{
+    // Verify that successive simulations give the same results as a fresh engine, whether the
+    // constraint solver of the previous simulation is reused or must be instantiated again.
+    auto robot = createContactPendulum({CONTACT_FRAME_NAMES[0]});
+    auto engine = createFallingPendulumEngine(robot, 1.0);
+    vectorN_t const xFirst = simulateFall(*engine);
+    ASSERT_TRUE(simulateFall(*engine).isApprox(xFirst, TOLERANCE));
+
+    // Same constraints, but different parameters of the solver
+    ASSERT_EQ(engine->setOption("contacts/friction", float64_t(0.1)), hresult_t::SUCCESS);
+    vectorN_t xRef = simulateFall(*createFallingPendulumEngine(
+        createContactPendulum({CONTACT_FRAME_NAMES[0]}), 0.1));
+    ASSERT_TRUE(simulateFall(*engine).isApprox(xRef, TOLERANCE));
+
+    // Different constraints
+    ASSERT_EQ(robot->addContactPoints({CONTACT_FRAME_NAMES[1]}), hresult_t::SUCCESS);
+    xRef = simulateFall(*createFallingPendulumEngine(createContactPendulum(CONTACT_FRAME_NAMES), 0.1));
+    ASSERT_TRUE(simulateFall(*engine).isApprox(xRef, TOLERANCE));
+}
+
+
+TEST(ContactDynamics, ConstraintSolverCompatibility)
+{
+    // Verify that the constraint solver is only deemed reusable for the very same constraints
+    auto robot = createContactPendulum({CONTACT_FRAME_NAMES[0]});
+    constraintsHolder_t constraintsHolder = robot->getConstraints();
+    PGSSolver solver(&robot->pncModel_, &robot->pncData_, &constraintsHolder,
+                     1.0, 0.0, 1.0e-10, 1.0e-10, PGS_MAX_ITERATIONS);
+    ASSERT_TRUE(solver.isCompatible(constraintsHolder));
+    constraintsHolder_t constraintsHolderCopy = robot->getConstraints();
+    ASSERT_TRUE(solver.isCompatible(constraintsHolderCopy));
+
+    ASSERT_EQ(robot->addContactPoints({CONTACT_FRAME_NAMES[1]}), hresult_t::SUCCESS);
+    constraintsHolder_t constraintsHolderOther = robot->getConstraints();
+    ASSERT_FALSE(solver.isCompatible(constraintsHolderOther));
+}
@@ -0,0 +1,298 @@
+// Test the native controllers, both in isolation and during a simulation.
+// The test system is the double pendulum, possibly swinging under the action of a controller.
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <functional>
+
+#include <boost/filesystem.hpp>
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/robot/BasicSensors.h"
+#include "jiminy/core/control/ControllerFunctor.h"
+#include "jiminy/core/control/ControllerPlugin.h"
+#include "jiminy/core/control/MlpController.h"
+#include "jiminy/core/control/PDController.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+float64_t const KP = 50.0;
+float64_t const KD = 2.0;
+
+
+// Proportional-derivative control of every joints toward zero.
+static void computeCommandPd(float64_t        const & /* t */,
+                             vectorN_t        const & q,
+                             vectorN_t        const & v,
+                             sensorsDataMap_t const & /* sensorsData */,
+                             vectorN_t              & command)
+{
+    command = - KP * q - KD * v;
+}
+
+// No internal dynamics.
+static void internalDynamicsNone(float64_t        const & /* t */,
+                                 vectorN_t        const & /* q */,
+                                 vectorN_t        const & /* v */,
+                                 sensorsDataMap_t const & /* sensorsData */,
+                                 vectorN_t              & /* uCustom */)
+{
+    // Empty on purpose
+}
+
+
+// Create the reference PD controller, implemented as a functor.
+static std::shared_ptr<AbstractController> createFunctorPd(void)
+{
+    return std::make_shared<
+        ControllerFunctor<decltype(computeCommandPd), decltype(internalDynamicsNone)>
+    >(computeCommandPd, internalDynamicsNone);
+}
+
+
+// Create the PD controller implemented by the example plugin, with the given configuration.
+static std::shared_ptr<ControllerPlugin> createPluginPd(std::string const & config)
+{
+    auto controller = std::make_shared<ControllerPlugin>();
+    configHolder_t ctrlOptions = controller->getOptions();
+    boost::get<std::string>(ctrlOptions.at("libraryPath")) = UNIT_TEST_CONTROLLER_PLUGIN;
+    boost::get<std::string>(ctrlOptions.at("config")) = config;
+    controller->setOptions(ctrlOptions);
+    return controller;
+}
+
+
+// Simulate the double pendulum released away from its equilibrium, and return its final state.
+// The given callback is called after resetting the engine, to alter the controller before starting.
+static vectorN_t simulateSwing(std::shared_ptr<Robot>              robot,
+                               std::shared_ptr<AbstractController> controller,
+                               float64_t                   const & tEnd,
+                               std::function<void(void)>   const & onReset = {})
+{
+    EXPECT_EQ(controller->initialize(robot), hresult_t::SUCCESS);
+    auto engine = std::make_shared<Engine>();
+    EXPECT_EQ(engine->initialize(robot, controller, callbackNoStop), hresult_t::SUCCESS);
+
+    vectorN_t q0 = vectorN_t::Zero(2);
+    q0[0] = 1.0;
+    vectorN_t v0 = vectorN_t::Zero(2);
+    EXPECT_EQ(engine->reset(), hresult_t::SUCCESS);
+    if (onReset)
+    {
+        onReset();
+    }
+    EXPECT_EQ(engine->start(q0, v0), hresult_t::SUCCESS);
+    EXPECT_EQ(engine->step(tEnd), hresult_t::SUCCESS);
+    engine->stop();
+
+    systemState_t const * systemState;
+    engine->getSystemState(systemState);
+    vectorN_t x(4);
+    x << systemState->q, systemState->v;
+    return x;
+}
+
+
+TEST(Controllers, ControllerPluginMatchesFunctor)
+{
+    // Verify that the example plugin behaves exactly as the equivalent functor
+    vectorN_t const xRef = simulateSwing(createDoublePendulum(), createFunctorPd(), 1.0);
+    vectorN_t const x = simulateSwing(
+        createDoublePendulum(), createPluginPd(std::to_string(KP) + " " + std::to_string(KD)), 1.0);
+    ASSERT_TRUE(x.isApprox(xRef, TOLERANCE));
+
+    // The controller must actually have an effect on the dynamics
+    vectorN_t const xFree = simulateSwing(
+        createDoublePendulum(), createPluginPd("0.0 0.0"), 1.0);
+    ASSERT_FALSE(x.isApprox(xFree, 1.0e-3));
+}
+
+
+TEST(Controllers, ControllerPluginReportsLoadingErrors)
+{
+    // Verify that failing to load the library is reported at initialization
+    auto robot = createDoublePendulum();
+    auto controller = createPluginPd("invalid");
+    ASSERT_NE(controller->initialize(robot), hresult_t::SUCCESS);
+    ASSERT_FALSE(controller->getIsInitialized());
+
+    configHolder_t ctrlOptions = controller->getOptions();
+    boost::get<std::string>(ctrlOptions.at("libraryPath")) = UNIT_TEST_DATA_DIR "does_not_exist";
+    controller->setOptions(ctrlOptions);
+    ASSERT_NE(controller->initialize(robot), hresult_t::SUCCESS);
+
+    // Verify that it is also reported when the library is reloaded by the engine
+    controller = createPluginPd("50.0 2.0");
+    ASSERT_EQ(controller->initialize(robot), hresult_t::SUCCESS);
+    auto engine = std::make_shared<Engine>();
+    ASSERT_EQ(engine->initialize(robot, controller, callbackNoStop), hresult_t::SUCCESS);
+    ctrlOptions = controller->getOptions();
+    boost::get<std::string>(ctrlOptions.at("config")) = "invalid";
+    controller->setOptions(ctrlOptions);
+    ASSERT_NE(engine->reset(), hresult_t::SUCCESS);
+    vectorN_t const q0 = vectorN_t::Zero(2);
+    ASSERT_NE(engine->simulate(1.0, q0, q0), hresult_t::SUCCESS);
+}
+
+
+// Create the double pendulum with an encoder on every joints, so that the sensor data has 4 elements.
+static std::shared_ptr<Robot> createEncodedDoublePendulum(void)
+{
+    auto robot = createDoublePendulum();
+    for (std::string const & jointName : DOUBLE_PENDULUM_JOINT_NAMES)
+    {
+        auto encoder = std::make_shared<EncoderSensor>(jointName);
+        robot->attachSensor(encoder);
+        encoder->initialize(jointName);
+    }
+    return robot;
+}
+
+
+// Create a network controller for the given robot, either from its parameters or from a file.
+static std::shared_ptr<MlpController> createMlp(std::shared_ptr<Robot>         robot,
+                                                std::vector<matrixN_t> const & weights,
+                                                std::vector<vectorN_t> const & biases,
+                                                std::string            const & weightsPath,
+                                                vectorN_t              const & inputOffset,
+                                                hresult_t              const & returnCodeExpected)
+{
+    auto controller = std::make_shared<MlpController>();
+    configHolder_t ctrlOptions = controller->getOptions();
+    boost::get<std::vector<matrixN_t> >(ctrlOptions.at("weights")) = weights;
+    boost::get<std::vector<vectorN_t> >(ctrlOptions.at("biases")) = biases;
+    boost::get<std::string>(ctrlOptions.at("weightsPath")) = weightsPath;
+    boost::get<vectorN_t>(ctrlOptions.at("inputOffset")) = inputOffset;
+    controller->setOptions(ctrlOptions);
+    EXPECT_EQ(controller->initialize(robot), returnCodeExpected);
+    return controller;
+}
+
+
+TEST(Controllers, MlpControllerLoadsSavedNetwork)
+{
+    // Verify that a saved network is loaded back identically, and evaluated as expected
+    auto robot = createEncodedDoublePendulum();
+    std::vector<matrixN_t> const weights{matrixN_t::Random(3, 4), matrixN_t::Random(2, 3)};
+    std::vector<vectorN_t> const biases{vectorN_t::Random(3), vectorN_t::Random(2)};
+    vectorN_t inputOffset(4);
+    inputOffset << 1.0, -2.0, 3.0, -4.0;
+    std::string const weightsPath =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+    ASSERT_EQ(MlpController::saveNetwork(weightsPath, weights, biases), hresult_t::SUCCESS);
+    auto controllerRef = createMlp(robot, weights, biases, "", inputOffset, hresult_t::SUCCESS);
+    auto controller = createMlp(robot, {}, {}, weightsPath, inputOffset, hresult_t::SUCCESS);
+
+    vectorN_t const input = robot->getSensorsDataFlat() - inputOffset;
+    vectorN_t const commandExpected = weights[1] * (weights[0] * input + biases[0]).array().tanh().matrix() + biases[1];
+    vectorN_t const zeros = vectorN_t::Zero(2);
+    vectorN_t commandRef(2), command(2);
+    ASSERT_EQ(controllerRef->computeCommand(0.0, zeros, zeros, commandRef), hresult_t::SUCCESS);
+    ASSERT_EQ(controller->computeCommand(0.0, zeros, zeros, command), hresult_t::SUCCESS);
+    ASSERT_TRUE(commandRef.isApprox(commandExpected, TOLERANCE));
+    ASSERT_TRUE(command == commandRef);
+
+    boost::filesystem::remove(weightsPath);
+}
+
+
+TEST(Controllers, MlpControllerRejectsCorruptedNetwork)
+{
+    // Verify that truncated files, extra data and dimensions larger than the file are rejected
+    auto robot = createEncodedDoublePendulum();
+    std::vector<matrixN_t> const weights{matrixN_t::Random(2, 4)};
+    std::vector<vectorN_t> const biases{vectorN_t::Random(2)};
+    vectorN_t const inputOffset;
+    std::string const weightsPath =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+    ASSERT_EQ(MlpController::saveNetwork(weightsPath, weights, biases), hresult_t::SUCCESS);
+    std::string content;
+    {
+        std::ifstream file(weightsPath, std::ios::in | std::ios::binary);
+        content.assign(std::istreambuf_iterator<char_t>(file), std::istreambuf_iterator<char_t>());
+    }
+    auto writeContent = [&weightsPath](std::string const & data)
+    {
+        std::ofstream file(weightsPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    };
+
+    writeContent(content.substr(0, content.size() - sizeof(float64_t)));
+    createMlp(robot, {}, {}, weightsPath, inputOffset, hresult_t::ERROR_BAD_INPUT);
+
+    writeContent(content + std::string(sizeof(float64_t), '\0'));
+    createMlp(robot, {}, {}, weightsPath, inputOffset, hresult_t::ERROR_BAD_INPUT);
+
+    // The number of outputs of the first layer follows the magic number, the version and the number of layers
+    std::string contentHuge = content;
+    uint32_t const nOutHuge = 0xFFFFFFFFU;
+    contentHuge.replace(12U, sizeof(uint32_t), reinterpret_cast<char_t const *>(&nOutHuge), sizeof(uint32_t));
+    writeContent(contentHuge);
+    createMlp(robot, {}, {}, weightsPath, inputOffset, hresult_t::ERROR_BAD_INPUT);
+
+    writeContent(content);
+    createMlp(robot, {}, {}, weightsPath, inputOffset, hresult_t::SUCCESS);
+
+    boost::filesystem::remove(weightsPath);
+}
+
+
+TEST(Controllers, PDControllerMatchesFunctor)
+{
+    // Verify that the PD controller reading the encoders follows the documented control law,
+    // with gains specified per motor or for every motor at once.
+    vectorN_t kp(2), qTarget(2), vTarget(2), uTarget(2);
+    kp << 50.0, 30.0;
+    float64_t const kd = 0.1;
+    qTarget << 0.3, -0.2;
+    vTarget << 0.0, 0.1;
+    uTarget << 1.0, -1.0;
+    auto computeCommandRef =
+        [&](float64_t        const & /* t */,
+            vectorN_t        const & q,
+            vectorN_t        const & v,
+            sensorsDataMap_t const & /* sensorsData */,
+            vectorN_t              & command)
+        {
+            command = - (kp.array() * ((q - qTarget) + kd * (v - vTarget)).array()).matrix() + uTarget;
+        };
+    auto controllerRef = std::make_shared<
+        ControllerFunctor<decltype(computeCommandRef), decltype(internalDynamicsNone)>
+    >(computeCommandRef, internalDynamicsNone);
+    vectorN_t const xRef = simulateSwing(createEncodedDoublePendulum(), controllerRef, 1.0);
+
+    auto controller = std::make_shared<PDController>();
+    configHolder_t ctrlOptions = controller->getOptions();
+    boost::get<vectorN_t>(ctrlOptions.at("kp")) = kp;
+    boost::get<vectorN_t>(ctrlOptions.at("kd")) = vectorN_t::Constant(1, kd);
+    controller->setOptions(ctrlOptions);
+
+    // The targets are reset with the engine, then updated in-place before starting
+    float64_t const * qTargetData = nullptr;
+    vectorN_t const x = simulateSwing(createEncodedDoublePendulum(), controller, 1.0,
+        [&]()
+        {
+            ASSERT_TRUE(controller->getPositionTarget().isZero());
+            qTargetData = controller->getPositionTarget().data();
+            ASSERT_EQ(controller->setTarget(qTarget, vTarget, uTarget), hresult_t::SUCCESS);
+        });
+    ASSERT_EQ(controller->getPositionTarget().data(), qTargetData);
+    ASSERT_TRUE(x.isApprox(xRef, TOLERANCE));
+}
+
+
+TEST(Controllers, PDControllerRequiresEncoders)
+{
+    // Verify that the initialization fails without encoder or with gains of inconsistent size
+    auto controller = std::make_shared<PDController>();
+    ASSERT_NE(controller->initialize(createDoublePendulum()), hresult_t::SUCCESS);
+
+    configHolder_t ctrlOptions = controller->getOptions();
+    boost::get<vectorN_t>(ctrlOptions.at("kp")) = vectorN_t::Ones(3);
+    controller->setOptions(ctrlOptions);
+    ASSERT_NE(controller->initialize(createEncodedDoublePendulum()), hresult_t::SUCCESS);
+}
@@ -0,0 +1,47 @@
+// Test the update of the options of the engine, independently of any robot.
+#include <gtest/gtest.h>
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/utilities/Random.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+
+TEST(EngineOptions, SetOptionUpdatesSingleOption)
+{
+    // Verify that updating a single option is equivalent to updating the whole configuration,
+    // and that an invalid value leaves the options unchanged.
+    Engine engine;
+    float64_t const dtMax = engine.engineOptions_->stepper.dtMax;
+
+    ASSERT_EQ(engine.setOption("contacts/friction", float64_t(0.5)), hresult_t::SUCCESS);
+    configHolder_t const & contactsOptions = boost::get<configHolder_t>(engine.getOptions().at("contacts"));
+    ASSERT_EQ(boost::get<float64_t>(contactsOptions.at("friction")), 0.5);
+    ASSERT_EQ(engine.engineOptions_->contacts.friction, 0.5);
+    ASSERT_EQ(engine.engineOptions_->stepper.dtMax, dtMax);
+
+    // Invalid value, wrong type or unknown option
+    ASSERT_EQ(engine.setOption("contacts/transitionVelocity", float64_t(0.0)), hresult_t::ERROR_BAD_INPUT);
+    ASSERT_GT(boost::get<float64_t>(contactsOptions.at("transitionVelocity")), 0.0);
+    ASSERT_GT(engine.engineOptions_->contacts.transitionVelocity, 0.0);
+    ASSERT_EQ(engine.setOption("contacts/friction", std::string("high")), hresult_t::ERROR_BAD_INPUT);
+    ASSERT_EQ(engine.setOption("contacts/unknown", float64_t(0.5)), hresult_t::ERROR_BAD_INPUT);
+    ASSERT_EQ(engine.setOption("unknown/friction", float64_t(0.5)), hresult_t::ERROR_BAD_INPUT);
+    ASSERT_EQ(engine.engineOptions_->contacts.friction, 0.5);
+
+    // The other options of the same group are taken into account
+    ASSERT_EQ(engine.setOption("stepper/detectContactEvents", bool_t(true)), hresult_t::SUCCESS);
+    ASSERT_EQ(engine.setOption("stepper/odeSolver", std::string("euler_explicit")), hresult_t::ERROR_BAD_INPUT);
+    ASSERT_EQ(engine.engineOptions_->stepper.odeSolver, "runge_kutta_dopri5");
+    ASSERT_TRUE(engine.engineOptions_->stepper.detectContactEvents);
+
+    // The random number generators are reset as if the whole configuration was updated
+    ASSERT_EQ(engine.setOption("stepper/randomSeed", uint32_t(5U)), hresult_t::SUCCESS);
+    float64_t const value = randUniform();
+    resetRandomGenerators(5U);
+    ASSERT_EQ(randUniform(), value);
+}
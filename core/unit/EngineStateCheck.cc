@@ -0,0 +1,111 @@
+// Test the snapshot and restore of the internal state of a running simulation.
+// The test system is the double pendulum, driven by DC motors and a PD controller reading encoders,
+// so that the motors and the controller both have an internal state.
+#include <gtest/gtest.h>
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/robot/BasicMotors.h"
+#include "jiminy/core/robot/BasicSensors.h"
+#include "jiminy/core/control/PDController.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+
+// Get the state of the pendulum and of its motors, as a single vector.
+static vectorN_t getStatefulPendulumState(Engine                                 const & engine,
+                                          std::vector<std::shared_ptr<DCMotor> > const & motors)
+{
+    systemState_t const * systemState;
+    engine.getSystemState(systemState);
+    vectorN_t x(8);
+    x << systemState->q, systemState->v,
+         motors[0]->getCurrent(), motors[1]->getCurrent(),
+         motors[0]->getTemperature(), motors[1]->getTemperature();
+    return x;
+}
+
+
+TEST(EngineState, RestoredSimulationIsBitIdentical)
+{
+    // Verify that stepping after restoring a snapshot reproduces exactly the same trajectory,
+    // including the internal state of the motors and of the controller.
+    std::vector<std::shared_ptr<DCMotor> > motors;
+    auto robot = createDCMotorDoublePendulum(motors, true);
+    auto controller = std::make_shared<PDController>();
+    configHolder_t ctrlOptions = controller->getOptions();
+    boost::get<vectorN_t>(ctrlOptions.at("kp")) = vectorN_t::Constant(1, 50.0);
+    boost::get<vectorN_t>(ctrlOptions.at("kd")) = vectorN_t::Constant(1, 0.1);
+    controller->setOptions(ctrlOptions);
+    ASSERT_EQ(controller->initialize(robot), hresult_t::SUCCESS);
+    auto engine = std::make_shared<Engine>();
+    ASSERT_EQ(engine->initialize(robot, controller, callbackNoStop), hresult_t::SUCCESS);
+
+    // Discrete-time update of the controller and the sensors, to go through the breakpoints
+    configHolder_t engineOptions = engine->getOptions();
+    configHolder_t & stepperOptions = boost::get<configHolder_t>(engineOptions.at("stepper"));
+    boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod")) = 1.0e-3;
+    boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod")) = 1.0e-3;
+    ASSERT_EQ(engine->setOptions(engineOptions), hresult_t::SUCCESS);
+
+    vectorN_t q0(2), qTarget(2), qTargetOther(2);
+    q0 << 1.0, 0.0;
+    qTarget << 0.3, -0.2;
+    qTargetOther << -0.5, 0.5;
+    vectorN_t const zeros = vectorN_t::Zero(2);
+    ASSERT_EQ(engine->reset(), hresult_t::SUCCESS);
+    ASSERT_EQ(controller->setTarget(qTarget, zeros), hresult_t::SUCCESS);
+    ASSERT_EQ(engine->start(q0, zeros), hresult_t::SUCCESS);
+    ASSERT_EQ(engine->step(0.3), hresult_t::SUCCESS);
+
+    // Take a snapshot, then step a first time
+    engineState_t engineState;
+    ASSERT_EQ(engine->saveState(engineState), hresult_t::SUCCESS);
+    ASSERT_EQ(engine->step(0.5), hresult_t::SUCCESS);
+    vectorN_t const xRef = getStatefulPendulumState(*engine, motors);
+
+    // Diverge from the original trajectory, by altering the state of the controller
+    ASSERT_EQ(controller->setTarget(qTargetOther, zeros), hresult_t::SUCCESS);
+    ASSERT_EQ(engine->step(0.2), hresult_t::SUCCESS);
+    ASSERT_FALSE(getStatefulPendulumState(*engine, motors) == xRef);
+
+    // Restore the snapshot, then step again
+    ASSERT_EQ(engine->restoreState(engineState), hresult_t::SUCCESS);
+    ASSERT_TRUE(controller->getPositionTarget() == qTarget);
+    ASSERT_EQ(engine->step(0.5), hresult_t::SUCCESS);
+    vectorN_t const x = getStatefulPendulumState(*engine, motors);
+    engine->stop();
+
+    // The trajectories must be bit-identical
+    ASSERT_TRUE(x == xRef);
+    ASSERT_GT(xRef[4], DCMotor::motorOptions_t(motors[0]->getOptions()).ambientTemperature);
+}
+
+
+TEST(EngineState, RestoreRejectsInconsistentState)
+{
+    // Verify that restoring the state of another simulation fails without altering the current one
+    std::vector<std::shared_ptr<DCMotor> > motors;
+    auto robot = createDCMotorDoublePendulum(motors, true);
+    auto controller = std::make_shared<PDController>();
+    ASSERT_EQ(controller->initialize(robot), hresult_t::SUCCESS);
+    auto engine = std::make_shared<Engine>();
+    ASSERT_EQ(engine->initialize(robot, controller, callbackNoStop), hresult_t::SUCCESS);
+
+    vectorN_t const zeros = vectorN_t::Zero(2);
+    ASSERT_EQ(engine->reset(), hresult_t::SUCCESS);
+    ASSERT_EQ(engine->start(zeros, zeros), hresult_t::SUCCESS);
+    ASSERT_EQ(engine->step(0.1), hresult_t::SUCCESS);
+    engineState_t engineState;
+    ASSERT_EQ(engine->saveState(engineState), hresult_t::SUCCESS);
+    vectorN_t const xRef = getStatefulPendulumState(*engine, motors);
+
+    vectorN_t & sSnapshot = engineState.systems[0].state.s;
+    sSnapshot.conservativeResize(sSnapshot.size() - 1);
+    ASSERT_EQ(engine->restoreState(engineState), hresult_t::ERROR_BAD_INPUT);
+    ASSERT_TRUE(getStatefulPendulumState(*engine, motors) == xRef);
+    engine->stop();
+}
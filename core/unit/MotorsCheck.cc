@@ -0,0 +1,165 @@
+// Test the motors of the robot, mostly independently of the engine.
+// The test system is the double pendulum, with a motor on every joints.
+#include <gtest/gtest.h>
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/robot/BasicMotors.h"
+#include "jiminy/core/control/ControllerFunctor.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+
+TEST(Motors, DCMotorStateDerivativeMatchesModel)
+{
+    // Verify the effort and the time derivative of the current and the temperature of the motors
+    // for a given internal state, which is integrated by the engine.
+    std::vector<std::shared_ptr<DCMotor> > motors;
+    auto robot = createDCMotorDoublePendulum(motors);
+    DCMotor::motorOptions_t const options(motors[0]->getOptions());
+    ASSERT_EQ(robot->ns(), 4);
+    vectorN_t command(2);
+    command << 0.5, -0.3;
+    vectorN_t s(4);
+    s << 0.2, options.ambientTemperature + 10.0, -0.1, options.ambientTemperature + 5.0;
+
+    vectorN_t const zeros = vectorN_t::Zero(2);
+    robot->computeMotorsEfforts(0.0, zeros, zeros, zeros, s, command);
+    vectorN_t const & ds = robot->getMotorsStateDerivative();
+    for (std::size_t i = 0; i < motors.size(); ++i)
+    {
+        Eigen::Index const & stateIdx = motors[i]->getStateIdx();
+        float64_t const current = s[stateIdx];
+        float64_t const temperature = s[stateIdx + 1];
+        ASSERT_DOUBLE_EQ(motors[i]->getCurrent(), current);
+        ASSERT_DOUBLE_EQ(motors[i]->getTemperature(), temperature);
+
+        float64_t const currentTarget = command[static_cast<Eigen::Index>(i)] / options.torqueConstant;
+        float64_t const resistance = options.windingResistance * (1.0 +
+            options.resistanceTemperatureCoeff * (temperature - options.ambientTemperature));
+        ASSERT_NEAR(robot->getMotorsEfforts()[static_cast<Eigen::Index>(i)],
+                    options.mechanicalReduction * options.torqueConstant * current, TOLERANCE);
+        ASSERT_NEAR(ds[stateIdx], options.currentBandwidth * (currentTarget - current), TOLERANCE);
+        ASSERT_NEAR(ds[stateIdx + 1],
+                    (resistance * current * current -
+                     (temperature - options.ambientTemperature) / options.thermalResistance) /
+                    options.thermalCapacitance, TOLERANCE);
+    }
+}
+
+
+TEST(Motors, DCMotorCurrentMatchesAnalyticalSolution)
+{
+    // Verify that the current integrated by the engine follows the first-order step response
+    // of the current loop, whatever the motion of the pendulum.
+    std::vector<std::shared_ptr<DCMotor> > motors;
+    auto robot = createDCMotorDoublePendulum(motors);
+    DCMotor::motorOptions_t const options(motors[0]->getOptions());
+    vectorN_t command(2);
+    command << 0.5, -0.3;
+
+    auto computeCommand =
+        [&command](float64_t        const & /* t */,
+                   vectorN_t        const & /* q */,
+                   vectorN_t        const & /* v */,
+                   sensorsDataMap_t const & /* sensorsData */,
+                   vectorN_t              & commandOut)
+        {
+            commandOut = command;
+        };
+    auto internalDynamics =
+        [](float64_t        const & /* t */,
+           vectorN_t        const & /* q */,
+           vectorN_t        const & /* v */,
+           sensorsDataMap_t const & /* sensorsData */,
+           vectorN_t              & /* uCustom */)
+        {
+            // Empty on purpose
+        };
+    auto controller = std::make_shared<
+        ControllerFunctor<decltype(computeCommand), decltype(internalDynamics)>
+    >(computeCommand, internalDynamics);
+    ASSERT_EQ(controller->initialize(robot), hresult_t::SUCCESS);
+    auto engine = std::make_shared<Engine>();
+    ASSERT_EQ(engine->initialize(robot, controller, callbackNoStop), hresult_t::SUCCESS);
+
+    configHolder_t engineOptions = engine->getOptions();
+    configHolder_t & stepperOptions = boost::get<configHolder_t>(engineOptions.at("stepper"));
+    boost::get<float64_t>(stepperOptions.at("tolAbs")) = TOLERANCE * 1.0e-2;
+    boost::get<float64_t>(stepperOptions.at("tolRel")) = TOLERANCE * 1.0e-2;
+    ASSERT_EQ(engine->setOptions(engineOptions), hresult_t::SUCCESS);
+
+    vectorN_t q0(2);
+    q0 << 1.0, 0.0;
+    vectorN_t const zeros = vectorN_t::Zero(2);
+    float64_t const tEnd = 2.0 / options.currentBandwidth;
+    ASSERT_EQ(engine->simulate(tEnd, q0, zeros), hresult_t::SUCCESS);
+    for (std::size_t i = 0; i < motors.size(); ++i)
+    {
+        float64_t const currentTarget = command[static_cast<Eigen::Index>(i)] / options.torqueConstant;
+        ASSERT_NEAR(motors[i]->getCurrent(),
+                    currentTarget * (1.0 - std::exp(- options.currentBandwidth * tEnd)), 1.0e-7);
+        ASSERT_GT(motors[i]->getTemperature(), options.ambientTemperature);
+    }
+}
+
+
+TEST(Motors, DCMotorEffortFollowsOptions)
+{
+    // Verify that the options updated after resetting the robot are used to compute the
+    // efforts, although the motors are evaluated all at once.
+    std::vector<std::shared_ptr<DCMotor> > motors;
+    auto robot = createDCMotorDoublePendulum(motors);
+    float64_t const mechanicalReduction = 2.0;
+    configHolder_t motorsOptions = robot->getMotorsOptions();
+    for (auto & options : motorsOptions)
+    {
+        configHolder_t & motorOptions = boost::get<configHolder_t>(options.second);
+        boost::get<float64_t>(motorOptions.at("mechanicalReduction")) = mechanicalReduction;
+    }
+    ASSERT_EQ(robot->setMotorsOptions(motorsOptions), hresult_t::SUCCESS);
+
+    vectorN_t command(2);
+    command << 0.5, -0.3;
+    float64_t const torqueConstant = DCMotor::motorOptions_t(motors[0]->getOptions()).torqueConstant;
+    vectorN_t s = robot->getMotorsState();
+    for (std::size_t i = 0; i < motors.size(); ++i)
+    {
+        s[motors[i]->getStateIdx()] = command[static_cast<Eigen::Index>(i)] / torqueConstant;
+    }
+    vectorN_t const zeros = vectorN_t::Zero(2);
+    robot->computeMotorsEfforts(0.0, zeros, zeros, zeros, s, command);
+    vectorN_t const effortRef = mechanicalReduction * command;
+    ASSERT_TRUE(robot->getMotorsEfforts().isApprox(effortRef, TOLERANCE));
+}
+
+
+TEST(Motors, SimpleMotorEffortFollowsOptions)
+{
+    // Verify that the options updated after resetting the robot are used to compute the
+    // efforts, although the motors are evaluated all at once.
+    auto robot = createDoublePendulum();
+    robot->reset();
+    float64_t const frictionViscous = -0.5;
+    configHolder_t motorsOptions = robot->getMotorsOptions();
+    for (auto & options : motorsOptions)
+    {
+        configHolder_t & motorOptions = boost::get<configHolder_t>(options.second);
+        boost::get<bool_t>(motorOptions.at("enableFriction")) = true;
+        boost::get<float64_t>(motorOptions.at("frictionViscousPositive")) = frictionViscous;
+        boost::get<float64_t>(motorOptions.at("frictionViscousNegative")) = frictionViscous;
+    }
+    ASSERT_EQ(robot->setMotorsOptions(motorsOptions), hresult_t::SUCCESS);
+
+    vectorN_t command(2);
+    command << 0.5, -0.3;
+    vectorN_t v(2);
+    v << 1.0, -2.0;
+    vectorN_t const zeros = vectorN_t::Zero(2);
+    robot->computeMotorsEfforts(0.0, zeros, v, zeros, robot->getMotorsState(), command);
+    vectorN_t const effortRef = command + frictionViscous * v;
+    ASSERT_TRUE(robot->getMotorsEfforts().isApprox(effortRef, TOLERANCE));
+}
@@ -0,0 +1,144 @@
+// Test the utilities built on top of pinocchio, independently of the robot.
+// The test systems are minimal models built manually, or the double pendulum for the model cache.
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/geometry.hpp"
+#include "pinocchio/multibody/joint/joints.hpp"
+#include "pinocchio/parsers/urdf.hpp"
+
+#include "jiminy/core/utilities/Pinocchio.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+
+// Create a model made of a single unaligned revolute joint.
+static pinocchio::Model createUnalignedPendulum(vector3_t const & axis)
+{
+    pinocchio::Model model;
+    jointIndex_t const jointIdx = model.addJoint(
+        0, pinocchio::JointModelRevoluteUnaligned(axis), pinocchio::SE3::Identity(), "joint");
+    model.appendBodyToJoint(jointIdx, pinocchio::Inertia::Identity(), pinocchio::SE3::Identity());
+    return model;
+}
+
+
+TEST(Pinocchio, HashModelDependsOnJointAxis)
+{
+    // Verify that the axis of unaligned joints is part of the hash of the model
+    vector3_t const axis = vector3_t(1.0, 1.0, 0.0).normalized();
+    std::size_t const hash = hashModel(createUnalignedPendulum(axis));
+    ASSERT_EQ(hashModel(createUnalignedPendulum(axis)), hash);
+    ASSERT_NE(hashModel(createUnalignedPendulum(vector3_t(0.0, 1.0, 1.0).normalized())), hash);
+}
+
+
+// List the files of a directory.
+static std::vector<boost::filesystem::path> listFiles(boost::filesystem::path const & dirPath)
+{
+    std::vector<boost::filesystem::path> filesPath;
+    for (auto const & entry : boost::filesystem::directory_iterator(dirPath))
+    {
+        filesPath.push_back(entry.path());
+    }
+    return filesPath;
+}
+
+
+TEST(Pinocchio, ModelCacheMatchesUrdf)
+{
+    // Verify that the models are loaded back from the cache rather than rebuilt, that a corrupted
+    // cache is rebuilt, and that the cache depends on the options.
+    std::string const urdfPath = std::string(UNIT_TEST_DATA_DIR) + "/double_pendulum_rigid.urdf";
+    boost::filesystem::path const cacheDir =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    pinocchio::Model pncModelRef, pncModel;
+    pinocchio::GeometryModel collisionModelRef, collisionModel;
+    ASSERT_EQ(buildModelsFromUrdf(urdfPath, false, {}, pncModelRef, collisionModelRef), hresult_t::SUCCESS);
+
+    // The cache is written once built, without leaving any temporary file
+    ASSERT_EQ(buildModelsFromUrdf(urdfPath, false, {}, pncModel, collisionModel,
+                                  std::nullopt, false, cacheDir.string()), hresult_t::SUCCESS);
+    ASSERT_TRUE(pncModel == pncModelRef);
+    std::vector<boost::filesystem::path> const cachePaths = listFiles(cacheDir);
+    ASSERT_EQ(cachePaths.size(), 1U);
+    boost::filesystem::path const & cachePath = cachePaths[0];
+    ASSERT_EQ(cachePath.extension().string(), ".bin");
+
+    // The cache is not written again when loaded from it
+    std::time_t const cacheTime = boost::filesystem::last_write_time(cachePath) - 1000;
+    boost::filesystem::last_write_time(cachePath, cacheTime);
+    pncModel = pinocchio::Model();
+    collisionModel = pinocchio::GeometryModel();
+    ASSERT_EQ(buildModelsFromUrdf(urdfPath, false, {}, pncModel, collisionModel,
+                                  std::nullopt, false, cacheDir.string()), hresult_t::SUCCESS);
+    ASSERT_TRUE(pncModel == pncModelRef);
+    ASSERT_EQ(boost::filesystem::last_write_time(cachePath), cacheTime);
+
+    // A corrupted cache is ignored, then written again
+    {
+        std::ofstream file(cachePath.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file << "corrupted";
+    }
+    pncModel = pinocchio::Model();
+    collisionModel = pinocchio::GeometryModel();
+    ASSERT_EQ(buildModelsFromUrdf(urdfPath, false, {}, pncModel, collisionModel,
+                                  std::nullopt, false, cacheDir.string()), hresult_t::SUCCESS);
+    ASSERT_TRUE(pncModel == pncModelRef);
+    ASSERT_GT(boost::filesystem::file_size(cachePath), 9U);
+
+    // The key depends on the options
+    pinocchio::Model pncModelFreeflyer;
+    pinocchio::GeometryModel collisionModelFreeflyer;
+    ASSERT_EQ(buildModelsFromUrdf(urdfPath, true, {}, pncModelFreeflyer, collisionModelFreeflyer,
+                                  std::nullopt, false, cacheDir.string()), hresult_t::SUCCESS);
+    ASSERT_EQ(listFiles(cacheDir).size(), 2U);
+
+    boost::filesystem::remove_all(cacheDir);
+}
+
+
+TEST(Pinocchio, ParallelMeshLoadingMatchesSequential)
+{
+    // Verify that loading the meshes over several threads gives the same geometry model as
+    // loading them sequentially, and that a mesh failing to load is reported as an error.
+    boost::filesystem::path const dirPath =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dirPath);
+    std::string const meshPath = (dirPath / "tetrahedron.stl").string();
+    writeTetrahedronStl(meshPath);
+
+    std::string urdfPath = writeMeshesUrdf(dirPath.string(), std::vector<std::string>(8U, meshPath));
+    pinocchio::Model model;
+    pinocchio::urdf::buildModel(urdfPath, model);
+    pinocchio::GeometryModel geomModelRef, geomModel;
+    ASSERT_EQ(buildGeomFromUrdf(model, urdfPath, pinocchio::COLLISION, geomModelRef, {}, true, false, 1U),
+              hresult_t::SUCCESS);
+    ASSERT_EQ(buildGeomFromUrdf(model, urdfPath, pinocchio::COLLISION, geomModel, {}, true, false, 4U),
+              hresult_t::SUCCESS);
+    ASSERT_EQ(geomModel.ngeoms, 8U);
+    ASSERT_TRUE(isGeometryModelEqual(geomModel, geomModelRef));
+
+    // A corrupted mesh is an error, no matter which thread loads it
+    std::string const meshCorruptedPath = (dirPath / "corrupted.stl").string();
+    {
+        std::ofstream file(meshCorruptedPath, std::ios::out | std::ios::trunc);
+        file << "corrupted";
+    }
+    std::vector<std::string> meshPaths(8U, meshPath);
+    meshPaths[5] = meshCorruptedPath;
+    urdfPath = writeMeshesUrdf(dirPath.string(), meshPaths);
+    geomModel = pinocchio::GeometryModel();
+    ASSERT_EQ(buildGeomFromUrdf(model, urdfPath, pinocchio::COLLISION, geomModel, {}, true, false, 4U),
+              hresult_t::ERROR_GENERIC);
+
+    boost::filesystem::remove_all(dirPath);
+}
@@ -0,0 +1,62 @@
+// Test the overloads of pinocchio algorithms.
+// The test system is the double pendulum, with a freeflyer.
+#include <gtest/gtest.h>
+
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+
+#include "jiminy/core/robot/PinocchioOverloadAlgorithms.h"
+#include "jiminy/core/robot/Robot.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+
+TEST(PinocchioOverload, ProjectExternalForcesMatchesJacobians)
+{
+    // Verify that projecting the external forces by a backward pass matches the sum of
+    // J_i^T * fext_i, including if some joints are not subject to any external force.
+    std::string const dataDirPath(UNIT_TEST_DATA_DIR);
+    auto robot = std::make_shared<Robot>();
+    robot->initialize(dataDirPath + "/double_pendulum_rigid.urdf", true);
+    pinocchio::Model const & model = robot->pncModel_;
+    pinocchio::Data data(model);
+
+    vectorN_t const q = pinocchio::randomConfiguration(
+        model, vectorN_t::Constant(model.nq, -1.0), vectorN_t::Constant(model.nq, 1.0));
+    vectorN_t const v = vectorN_t::Random(model.nv);
+    pinocchio::forwardKinematics(model, data, q, v);
+
+    for (int32_t jointIdxNoForce = 0; jointIdxNoForce < model.njoints; ++jointIdxNoForce)
+    {
+        // Random external forces, except for one of the joints
+        forceVector_t fext(model.njoints, pinocchio::Force::Zero());
+        for (int32_t i = 1; i < model.njoints; ++i)
+        {
+            if (i != jointIdxNoForce)
+            {
+                fext[i] = pinocchio::Force::Random();
+            }
+        }
+
+        // Reference projection based on the jacobian of every joints
+        vectorN_t const u = vectorN_t::Random(model.nv);
+        vectorN_t uRef = u;
+        pinocchio::computeJointJacobians(model, data, q);
+        for (int32_t i = 1; i < model.njoints; ++i)
+        {
+            matrix6N_t jointJacobian = matrix6N_t::Zero(6, model.nv);
+            pinocchio::getJointJacobian(model, data, i, pinocchio::LOCAL, jointJacobian);
+            uRef += jointJacobian.transpose() * fext[i].toVector();
+        }
+
+        // Projection by a backward pass
+        data.u = u;
+        pinocchio_overload::projectExternalForces(model, data, fext);
+        ASSERT_TRUE(data.u.isApprox(uRef, TOLERANCE));
+    }
+}
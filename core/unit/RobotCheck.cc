@@ -0,0 +1,384 @@
+// Test the robot itself, independently of the engine unless stated otherwise.
+// The test system is the double pendulum, with a motor and an encoder on every joints.
+#include <gtest/gtest.h>
+
+#include <iterator>
+
+#include <boost/filesystem.hpp>
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/robot/BasicMotors.h"
+#include "jiminy/core/robot/BasicSensors.h"
+#include "jiminy/core/constraints/FixedFrameConstraint.h"
+#include "jiminy/core/control/ControllerFunctor.h"
+#include "jiminy/core/utilities/Random.h"
+#include "jiminy/core/utilities/Pinocchio.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+
+// Motor of a user-defined type, deriving from a built-in one.
+class UserDefinedMotor : public SimpleMotor
+{
+public:
+    using SimpleMotor::SimpleMotor;
+};
+
+
+// Create the double pendulum with an encoder on every joints.
+static std::shared_ptr<Robot> createSensedPendulum(void)
+{
+    auto robot = createDoublePendulum();
+    for (std::string const & jointName : DOUBLE_PENDULUM_JOINT_NAMES)
+    {
+        auto encoder = std::make_shared<EncoderSensor>(jointName);
+        robot->attachSensor(encoder);
+        encoder->initialize(jointName);
+    }
+    return robot;
+}
+
+
+// Simulate the double pendulum swinging under the action of a PD controller, and return its final state.
+static vectorN_t simulateControlledSwing(std::shared_ptr<Robot> robot)
+{
+    auto computeCommand =
+        [](float64_t        const & /* t */,
+           vectorN_t        const & q,
+           vectorN_t        const & v,
+           sensorsDataMap_t const & /* sensorsData */,
+           vectorN_t              & command)
+        {
+            command = - 50.0 * q - 2.0 * v;
+        };
+    auto internalDynamics =
+        [](float64_t        const & /* t */,
+           vectorN_t        const & /* q */,
+           vectorN_t        const & /* v */,
+           sensorsDataMap_t const & /* sensorsData */,
+           vectorN_t              & /* uCustom */)
+        {
+            // Empty on purpose
+        };
+    auto controller = std::make_shared<
+        ControllerFunctor<decltype(computeCommand), decltype(internalDynamics)>
+    >(computeCommand, internalDynamics);
+    EXPECT_EQ(controller->initialize(robot), hresult_t::SUCCESS);
+    auto engine = std::make_shared<Engine>();
+    EXPECT_EQ(engine->initialize(robot, controller, callbackNoStop), hresult_t::SUCCESS);
+
+    vectorN_t q0(2);
+    q0 << 1.0, -0.5;
+    vectorN_t const v0 = vectorN_t::Zero(2);
+    EXPECT_EQ(engine->simulate(1.0, q0, v0), hresult_t::SUCCESS);
+
+    systemState_t const * systemState;
+    engine->getSystemState(systemState);
+    vectorN_t x(4);
+    x << systemState->q, systemState->v;
+    return x;
+}
+
+
+TEST(Robot, CloneMatchesOriginalDynamics)
+{
+    // Verify that the clone has the same dynamics as the original, including the options of the
+    // motors, while both can be modified independently.
+    auto robot = createSensedPendulum();
+    configHolder_t motorsOptions = robot->getMotorsOptions();
+    for (auto & options : motorsOptions)
+    {
+        configHolder_t & motorOptions = boost::get<configHolder_t>(options.second);
+        boost::get<float64_t>(motorOptions.at("mechanicalReduction")) = 2.0;
+        boost::get<bool_t>(motorOptions.at("enableArmature")) = true;
+        boost::get<float64_t>(motorOptions.at("armature")) = 0.05;
+    }
+    ASSERT_EQ(robot->setMotorsOptions(motorsOptions), hresult_t::SUCCESS);
+
+    std::shared_ptr<Robot> robotClone;
+    ASSERT_EQ(robot->clone(robotClone), hresult_t::SUCCESS);
+    ASSERT_NE(robotClone, robot);
+    ASSERT_EQ(robotClone->getMotorsNames(), robot->getMotorsNames());
+    ASSERT_EQ(robotClone->getSensorsNames(), robot->getSensorsNames());
+    ASSERT_TRUE(robotClone->pncModel_.inertias == robot->pncModel_.inertias);
+
+    vectorN_t const xRef = simulateControlledSwing(robot);
+    ASSERT_TRUE(simulateControlledSwing(robotClone).isApprox(xRef, TOLERANCE));
+
+    // Altering the clone must not affect the original
+    boost::get<float64_t>(boost::get<configHolder_t>(
+        motorsOptions.begin()->second).at("armature")) = 0.5;
+    ASSERT_EQ(robotClone->setMotorsOptions(motorsOptions), hresult_t::SUCCESS);
+    ASSERT_FALSE(simulateControlledSwing(robotClone).isApprox(xRef, TOLERANCE));
+    ASSERT_TRUE(simulateControlledSwing(robot).isApprox(xRef, TOLERANCE));
+}
+
+
+TEST(Robot, CloneRejectsUserDefinedTypes)
+{
+    // Verify that cloning fails rather than silently dropping or altering what cannot be copied
+    std::shared_ptr<Robot> robotClone;
+
+    // User-registered constraint
+    auto robot = createSensedPendulum();
+    ASSERT_EQ(robot->addConstraint("fixedMass", std::make_shared<FixedFrameConstraint>("PendulumMass")),
+              hresult_t::SUCCESS);
+    ASSERT_NE(robot->clone(robotClone), hresult_t::SUCCESS);
+    ASSERT_FALSE(robotClone);
+
+    // Motor of a user-defined type, even if deriving from a built-in one
+    robot = createDoublePendulum(false);
+    auto motor = std::make_shared<UserDefinedMotor>(DOUBLE_PENDULUM_JOINT_NAMES[0]);
+    ASSERT_EQ(robot->attachMotor(motor), hresult_t::SUCCESS);
+    ASSERT_EQ(motor->initialize(DOUBLE_PENDULUM_JOINT_NAMES[0]), hresult_t::SUCCESS);
+    ASSERT_NE(robot->clone(robotClone), hresult_t::SUCCESS);
+    ASSERT_FALSE(robotClone);
+}
+
+
+TEST(Robot, ModelUpdatesAppliedAtEndOfBatch)
+{
+    // Verify that the changes are applied only once the outermost batch of updates ends, even if
+    // the batch is not ended explicitly.
+    auto robot = createDoublePendulum();
+    ASSERT_NE(robot->endModelUpdate(), hresult_t::SUCCESS);
+
+    {
+        ModelUpdateGuard modelUpdateGuard(*robot);
+        ASSERT_EQ(robot->addFrame("frame1", "PendulumMass", pinocchio::SE3::Identity()), hresult_t::SUCCESS);
+        {
+            ModelUpdateGuard modelUpdateGuardNested(*robot);
+            ASSERT_EQ(robot->addFrame("frame2", "PendulumMass", pinocchio::SE3::Identity()), hresult_t::SUCCESS);
+            ASSERT_EQ(robot->addContactPoints({"frame1", "frame2"}), hresult_t::SUCCESS);
+            ASSERT_EQ(modelUpdateGuardNested.end(), hresult_t::SUCCESS);
+            ASSERT_EQ(modelUpdateGuardNested.end(), hresult_t::SUCCESS);
+        }
+        ASSERT_FALSE(robot->pncModel_.existFrame("frame1"));
+        ASSERT_TRUE(robot->getContactFramesIdx().empty());
+    }
+    ASSERT_TRUE(robot->pncModel_.existFrame("frame1"));
+    ASSERT_TRUE(robot->pncModel_.existFrame("frame2"));
+    std::vector<frameIndex_t> const & contactFramesIdx = robot->getContactFramesIdx();
+    ASSERT_EQ(contactFramesIdx.size(), 2U);
+    ASSERT_EQ(contactFramesIdx[0], robot->pncModel_.getFrameId("frame1"));
+    ASSERT_EQ(contactFramesIdx[1], robot->pncModel_.getFrameId("frame2"));
+
+    // No batch must remain in progress
+    ASSERT_NE(robot->endModelUpdate(), hresult_t::SUCCESS);
+
+    // Outside a batch, every change is applied right away
+    ASSERT_EQ(robot->removeContactPoints({"frame2"}), hresult_t::SUCCESS);
+    ASSERT_EQ(robot->removeFrame("frame2"), hresult_t::SUCCESS);
+    ASSERT_FALSE(robot->pncModel_.existFrame("frame2"));
+    ASSERT_EQ(robot->getContactFramesIdx().size(), 1U);
+    ASSERT_EQ(robot->getContactFramesIdx()[0], robot->pncModel_.getFrameId("frame1"));
+}
+
+
+TEST(Robot, ModelUpdatesReportRegenerationErrors)
+{
+    // Verify that failing to regenerate the models is reported by the update triggering it
+    auto robot = createDoublePendulum();
+    configHolder_t modelOptions = robot->getModelOptions();
+    configHolder_t & dynOptions = boost::get<configHolder_t>(modelOptions.at("dynamics"));
+    boost::get<flexibilityConfig_t>(dynOptions.at("flexibilityConfig")) = {
+        {"NotAFrame", vector3_t::Ones(), vector3_t::Ones(), vector3_t::Ones()}};
+    ASSERT_NE(robot->setModelOptions(modelOptions), hresult_t::SUCCESS);
+}
+
+
+TEST(Robot, VersionsStampedOnUpdates)
+{
+    // Verify that the version of the options changes whenever the options of the robot, of its
+    // motors or of its sensors are updated, or whenever a sensor is attached or detached, and that
+    // the version of the geometry models changes whenever they are regenerated.
+    auto robot = createDoublePendulum();
+    std::size_t optionsVersion = robot->getOptionsVersion();
+    auto const checkOptionsVersionChanged =
+        [&robot, &optionsVersion]()
+        {
+            std::size_t const optionsVersionPrev = optionsVersion;
+            optionsVersion = robot->getOptionsVersion();
+            return optionsVersion > optionsVersionPrev;
+        };
+
+    std::shared_ptr<AbstractMotorBase> motor;
+    ASSERT_EQ(robot->getMotor(DOUBLE_PENDULUM_JOINT_NAMES[0], motor), hresult_t::SUCCESS);
+    ASSERT_EQ(motor->setOptions(motor->getOptions()), hresult_t::SUCCESS);
+    ASSERT_TRUE(checkOptionsVersionChanged());
+
+    auto encoder = std::make_shared<EncoderSensor>(DOUBLE_PENDULUM_JOINT_NAMES[0]);
+    ASSERT_EQ(robot->attachSensor(encoder), hresult_t::SUCCESS);
+    ASSERT_TRUE(checkOptionsVersionChanged());
+    ASSERT_EQ(encoder->setOptions(encoder->getOptions()), hresult_t::SUCCESS);
+    ASSERT_TRUE(checkOptionsVersionChanged());
+    ASSERT_EQ(robot->detachSensor(EncoderSensor::type_, encoder->getName()), hresult_t::SUCCESS);
+    ASSERT_TRUE(checkOptionsVersionChanged());
+
+    ASSERT_EQ(robot->setTelemetryOptions(robot->getTelemetryOptions()), hresult_t::SUCCESS);
+    ASSERT_TRUE(checkOptionsVersionChanged());
+
+    // The versions of distinct robots never coincide, even if they went through the same updates
+    std::size_t const geometryModelsVersion = robot->getGeometryModelsVersion();
+    auto robotOther = createDoublePendulum();
+    ASSERT_NE(robotOther->getGeometryModelsVersion(), geometryModelsVersion);
+    ASSERT_NE(robotOther->getOptionsVersion(), optionsVersion);
+
+    configHolder_t modelOptions = robot->getModelOptions();
+    boost::get<uint32_t>(boost::get<configHolder_t>(modelOptions.at("collisions")).at("maxContactPointsPerBody")) += 1U;
+    ASSERT_EQ(robot->setModelOptions(modelOptions), hresult_t::SUCCESS);
+    ASSERT_TRUE(checkOptionsVersionChanged());
+    ASSERT_GT(robot->getGeometryModelsVersion(), geometryModelsVersion);
+}
+
+
+TEST(Robot, RandomizeModelInPlace)
+{
+    // Verify that resetting the robot samples new biases of the dynamics without reallocating the
+    // model, that the biases only depend on the seed, and that they apply to the nominal dynamics.
+    auto robot = createDoublePendulum();
+    configHolder_t modelOptions = robot->getModelOptions();
+    configHolder_t & dynOptions = boost::get<configHolder_t>(modelOptions.at("dynamics"));
+    boost::get<float64_t>(dynOptions.at("massBodiesBiasStd")) = 0.1;
+    boost::get<float64_t>(dynOptions.at("relativePositionBodiesBiasStd")) = 0.1;
+    ASSERT_EQ(robot->setModelOptions(modelOptions), hresult_t::SUCCESS);
+
+    resetRandomGenerators(0U);
+    robot->reset();
+    auto const inertiasRef = robot->pncModel_.inertias;
+    auto const jointPlacementsRef = robot->pncModel_.jointPlacements;
+    pinocchio::SE3 const * const oMiData = robot->pncData_.oMi.data();
+
+    // New biases are sampled at every reset
+    robot->reset();
+    ASSERT_FALSE(robot->pncModel_.inertias == inertiasRef);
+
+    // The same seed gives the same biases, without reallocating the data
+    resetRandomGenerators(0U);
+    robot->reset();
+    ASSERT_TRUE(robot->pncModel_.inertias == inertiasRef);
+    ASSERT_TRUE(robot->pncModel_.jointPlacements == jointPlacementsRef);
+    ASSERT_EQ(robot->pncData_.oMi.data(), oMiData);
+
+    // Without biases, the nominal dynamics is recovered, including changes of the original model
+    boost::get<float64_t>(dynOptions.at("massBodiesBiasStd")) = 0.0;
+    boost::get<float64_t>(dynOptions.at("relativePositionBodiesBiasStd")) = 0.0;
+    ASSERT_EQ(robot->setModelOptions(modelOptions), hresult_t::SUCCESS);
+    jointIndex_t const jointIdxOrig = robot->pncModelOrig_.getJointId(DOUBLE_PENDULUM_JOINT_NAMES[0]);
+    robot->pncModelOrig_.inertias[jointIdxOrig].mass() *= 2.0;
+    robot->reset();
+    for (std::string const & jointName : DOUBLE_PENDULUM_JOINT_NAMES)
+    {
+        jointIndex_t const jointIdx = robot->pncModel_.getJointId(jointName);
+        jointIndex_t const jointIdxNominal = robot->pncModelOrig_.getJointId(jointName);
+        ASSERT_TRUE(robot->pncModel_.inertias[jointIdx] == robot->pncModelOrig_.inertias[jointIdxNominal]);
+        ASSERT_TRUE(robot->pncModel_.jointPlacements[jointIdx] ==
+                    robot->pncModelOrig_.jointPlacements[jointIdxNominal]);
+    }
+}
+
+
+TEST(Robot, DeferredVisualModelMatchesEager)
+{
+    // Verify that the visual model is only deferred on demand, that it is the same as if built
+    // eagerly once loaded, that it is built once for the robot and its clones, and that loading
+    // it goes through the cache of the models.
+    std::string const urdfPath = std::string(UNIT_TEST_DATA_DIR) + "/double_pendulum_rigid.urdf";
+    auto robotRef = std::make_shared<Robot>();
+    ASSERT_EQ(robotRef->initialize(urdfPath, false), hresult_t::SUCCESS);
+    ASSERT_GT(robotRef->visualModelOrig_.ngeoms, 0U);
+
+    // The visual model is empty until loaded, no matter whether by the robot or its clone
+    auto robot = std::make_shared<Robot>();
+    ASSERT_EQ(robot->initialize(urdfPath, false, {}, false, "", true), hresult_t::SUCCESS);
+    ASSERT_EQ(robot->visualModelOrig_.ngeoms, 0U);
+    std::shared_ptr<Robot> robotClone;
+    ASSERT_EQ(robot->clone(robotClone), hresult_t::SUCCESS);
+    ASSERT_EQ(robotClone->loadVisualModel(), hresult_t::SUCCESS);
+    ASSERT_TRUE(isGeometryModelEqual(robotClone->visualModelOrig_, robotRef->visualModelOrig_));
+    ASSERT_EQ(robotClone->visualData_.oMg.size(), robotClone->visualModel_.geometryObjects.size());
+    ASSERT_EQ(robot->visualModelOrig_.ngeoms, 0U);
+
+    // The robot gets the visual model loaded by its clone, rather than building it again
+    ASSERT_EQ(robot->loadVisualModel(), hresult_t::SUCCESS);
+    ASSERT_EQ(robot->visualModelOrig_.ngeoms, robotRef->visualModelOrig_.ngeoms);
+    ASSERT_EQ(robot->visualModelOrig_.geometryObjects[0].geometry,
+              robotClone->visualModelOrig_.geometryObjects[0].geometry);
+
+    // The deferred visual model is built from the content of the URDF file, not the file itself
+    auto robotMoved = std::make_shared<Robot>();
+    boost::filesystem::path const urdfMovedPath =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.urdf");
+    boost::filesystem::copy_file(urdfPath, urdfMovedPath);
+    ASSERT_EQ(robotMoved->initialize(urdfMovedPath.string(), false, {}, false, "", true), hresult_t::SUCCESS);
+    boost::filesystem::remove(urdfMovedPath);
+    ASSERT_EQ(robotMoved->loadVisualModel(), hresult_t::SUCCESS);
+    ASSERT_TRUE(isGeometryModelEqual(robotMoved->visualModelOrig_, robotRef->visualModelOrig_));
+
+    // The deferred visual model is stored alone in the cache, separately from the other models
+    boost::filesystem::path const cacheDir =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    auto countCacheFiles =
+        [&cacheDir]()
+        {
+            return std::distance(boost::filesystem::directory_iterator(cacheDir),
+                                 boost::filesystem::directory_iterator());
+        };
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        auto robotCached = std::make_shared<Robot>();
+        ASSERT_EQ(robotCached->initialize(urdfPath, false, {}, false, cacheDir.string(), true),
+                  hresult_t::SUCCESS);
+        ASSERT_EQ(countCacheFiles(), static_cast<std::ptrdiff_t>(1 + i));
+        ASSERT_EQ(robotCached->loadVisualModel(), hresult_t::SUCCESS);
+        ASSERT_TRUE(isGeometryModelEqual(robotCached->visualModelOrig_, robotRef->visualModelOrig_));
+        ASSERT_EQ(countCacheFiles(), 2);
+    }
+
+    // Whereas the eager visual model is stored along with the other models
+    auto robotCached = std::make_shared<Robot>();
+    ASSERT_EQ(robotCached->initialize(urdfPath, false, {}, false, cacheDir.string(), false),
+              hresult_t::SUCCESS);
+    ASSERT_EQ(countCacheFiles(), 3);
+
+    boost::filesystem::remove_all(cacheDir);
+}
+
+
+TEST(Robot, MeshesLoadedInParallelOnInitialization)
+{
+    // Verify that the number of threads loading the meshes is forwarded when initializing the
+    // robot, without altering the geometry models, and that a mesh failing to load is an error.
+    boost::filesystem::path const dirPath =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dirPath);
+    std::string const meshPath = (dirPath / "tetrahedron.stl").string();
+    writeTetrahedronStl(meshPath);
+    std::vector<std::string> meshPaths(8U, meshPath);
+    std::string const urdfPath = writeMeshesUrdf(dirPath.string(), meshPaths);
+
+    auto robotRef = std::make_shared<Robot>();
+    ASSERT_EQ(robotRef->initialize(urdfPath, true, {}, false, "", false, 1U), hresult_t::SUCCESS);
+    for (uint32_t const nThreads : {0U, 4U})
+    {
+        auto robot = std::make_shared<Robot>();
+        ASSERT_EQ(robot->initialize(urdfPath, true, {}, false, "", false, nThreads), hresult_t::SUCCESS);
+        ASSERT_TRUE(isGeometryModelEqual(robot->collisionModelOrig_, robotRef->collisionModelOrig_));
+    }
+
+    std::string const meshCorruptedPath = (dirPath / "corrupted.stl").string();
+    {
+        std::ofstream file(meshCorruptedPath, std::ios::out | std::ios::trunc);
+        file << "corrupted";
+    }
+    meshPaths[5] = meshCorruptedPath;
+    auto robot = std::make_shared<Robot>();
+    ASSERT_EQ(robot->initialize(writeMeshesUrdf(dirPath.string(), meshPaths), true, {}, false, "", false, 4U),
+              hresult_t::ERROR_GENERIC);
+
+    boost::filesystem::remove_all(dirPath);
+}
@@ -0,0 +1,168 @@
+// Test the sensors of the robot during a simulation.
+// The test system is the double pendulum, with an encoder and an effort sensor on every joints.
+#include <gtest/gtest.h>
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/robot/BasicSensors.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+float64_t const SENSORS_UPDATE_PERIOD = 1.0e-3;
+
+
+// Create the double pendulum with an encoder and an effort sensor on every joints.
+static std::shared_ptr<Robot> createInstrumentedDoublePendulum(void)
+{
+    auto robot = createDoublePendulum();
+    for (std::string const & jointName : DOUBLE_PENDULUM_JOINT_NAMES)
+    {
+        auto encoder = std::make_shared<EncoderSensor>(jointName);
+        robot->attachSensor(encoder);
+        encoder->initialize(jointName);
+
+        auto effortSensor = std::make_shared<EffortSensor>(jointName);
+        robot->attachSensor(effortSensor);
+        effortSensor->initialize(jointName);
+    }
+    return robot;
+}
+
+
+// Create an engine updating the sensors periodically.
+static std::shared_ptr<Engine> createSwingEngine(std::shared_ptr<Robot> robot)
+{
+    auto engine = std::make_shared<Engine>();
+    engine->initialize(robot, callbackNoStop);
+    configHolder_t simuOptions = engine->getDefaultEngineOptions();
+    configHolder_t & stepperOptions = boost::get<configHolder_t>(simuOptions.at("stepper"));
+    boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod")) = SENSORS_UPDATE_PERIOD;
+    boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod")) = SENSORS_UPDATE_PERIOD;
+    EXPECT_EQ(engine->setOptions(simuOptions), hresult_t::SUCCESS);
+    return engine;
+}
+
+
+// Start a simulation with the first pendulum released away from its equilibrium.
+static void startSwing(std::shared_ptr<Engine> engine)
+{
+    vectorN_t q0 = vectorN_t::Zero(2);
+    q0[0] = 1.0;
+    vectorN_t v0 = vectorN_t::Zero(2);
+    EXPECT_EQ(engine->start(q0, v0), hresult_t::SUCCESS);
+}
+
+
+TEST(Sensors, DelayedMeasurementMatchesPastState)
+{
+    // Verify that the measurements of a delayed sensor are the real data recorded one delay
+    // earlier, long after the history of the sensors started to be recycled.
+    std::size_t const delaySteps = 20;
+    auto robot = createInstrumentedDoublePendulum();
+    configHolder_t encodersOptions;
+    robot->getSensorsOptions(EncoderSensor::type_, encodersOptions);
+    for (auto & encoderOptions : encodersOptions)
+    {
+        configHolder_t & options = boost::get<configHolder_t>(encoderOptions.second);
+        boost::get<float64_t>(options.at("delay")) = static_cast<float64_t>(delaySteps) * SENSORS_UPDATE_PERIOD;
+        boost::get<uint32_t>(options.at("delayInterpolationOrder")) = 0U;
+    }
+    ASSERT_EQ(robot->setSensorsOptions(EncoderSensor::type_, encodersOptions), hresult_t::SUCCESS);
+    auto engine = createSwingEngine(robot);
+    startSwing(engine);
+
+    std::vector<vectorN_t> qLog;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        systemState_t const * systemState;
+        engine->getSystemState(systemState);
+        qLog.push_back(systemState->q);
+
+        // The oldest state is measured until enough data has been recorded
+        vectorN_t const & qDelayed = qLog[i < delaySteps ? 0 : i - delaySteps];
+        for (std::size_t j = 0; j < DOUBLE_PENDULUM_JOINT_NAMES.size(); ++j)
+        {
+            float64_t const qMeasured = robot->getSensorData(
+                EncoderSensor::type_, DOUBLE_PENDULUM_JOINT_NAMES[j])[0];
+            ASSERT_NEAR(qMeasured, qDelayed[static_cast<Eigen::Index>(j)], TOLERANCE);
+        }
+
+        ASSERT_EQ(engine->step(SENSORS_UPDATE_PERIOD), hresult_t::SUCCESS);
+    }
+    engine->stop();
+}
+
+
+TEST(Sensors, FlatBufferMatchesSensorsData)
+{
+    // Verify that the contiguous buffer of measurements is updated in-place with the data
+    // of every sensors, at the location given by the offsets.
+    auto robot = createInstrumentedDoublePendulum();
+    auto engine = createSwingEngine(robot);
+    startSwing(engine);
+
+    vectorN_t const & sensorsDataFlat = robot->getSensorsDataFlat();
+    float64_t const * const sensorsDataFlatPtr = sensorsDataFlat.data();
+    Robot::sensorsDataOffsets_t const & sensorsDataOffsets = robot->getSensorsDataOffsets();
+    ASSERT_EQ(sensorsDataOffsets.size(), 2U);
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(engine->step(SENSORS_UPDATE_PERIOD), hresult_t::SUCCESS);
+        ASSERT_EQ(sensorsDataFlat.data(), sensorsDataFlatPtr);
+        for (auto const & sensorTypeOffsets : sensorsDataOffsets)
+        {
+            ASSERT_EQ(sensorTypeOffsets.second.size(), DOUBLE_PENDULUM_JOINT_NAMES.size());
+            for (auto const & sensorOffset : sensorTypeOffsets.second)
+            {
+                Eigen::Ref<vectorN_t const> sensorData =
+                    robot->getSensorData(sensorTypeOffsets.first, sensorOffset.first);
+                ASSERT_TRUE(sensorsDataFlat.segment(sensorOffset.second, sensorData.size()) == sensorData);
+            }
+        }
+    }
+    engine->stop();
+}
+
+
+TEST(Sensors, NoiseAndBiasFollowOptions)
+{
+    // Verify that the noise and bias set after resetting the robot are applied to the
+    // measurements of every sensors, and that noiseless components are left untouched.
+    auto robot = createInstrumentedDoublePendulum();
+    auto engine = createSwingEngine(robot);
+    engine->reset();
+
+    vectorN_t bias(2);
+    bias << 0.1, -0.2;
+    vectorN_t noiseStd(2);
+    noiseStd << 0.0, 0.1;
+    configHolder_t encodersOptions;
+    robot->getSensorsOptions(EncoderSensor::type_, encodersOptions);
+    for (auto & encoderOptions : encodersOptions)
+    {
+        configHolder_t & options = boost::get<configHolder_t>(encoderOptions.second);
+        boost::get<vectorN_t>(options.at("bias")) = bias;
+        boost::get<vectorN_t>(options.at("noiseStd")) = noiseStd;
+    }
+    ASSERT_EQ(robot->setSensorsOptions(EncoderSensor::type_, encodersOptions), hresult_t::SUCCESS);
+    startSwing(engine);
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(engine->step(SENSORS_UPDATE_PERIOD), hresult_t::SUCCESS);
+        systemState_t const * systemState;
+        engine->getSystemState(systemState);
+        for (std::size_t j = 0; j < DOUBLE_PENDULUM_JOINT_NAMES.size(); ++j)
+        {
+            Eigen::Index const jointIdx = static_cast<Eigen::Index>(j);
+            Eigen::Ref<vectorN_t const> encoderData = robot->getSensorData(
+                EncoderSensor::type_, DOUBLE_PENDULUM_JOINT_NAMES[j]);
+            ASSERT_NEAR(encoderData[0], systemState->q[jointIdx] + bias[0], TOLERANCE);
+            ASSERT_NE(encoderData[1], systemState->v[jointIdx] + bias[1]);
+        }
+    }
+    engine->stop();
+}
@@ -0,0 +1,135 @@
+// Test the integration schemes of the simulation engine.
+// The test system is the double pendulum, without contact.
+#include <gtest/gtest.h>
+
+#include "jiminy/core/engine/Engine.h"
+#include "jiminy/core/Types.h"
+
+#include "Utilities.h"
+
+
+using namespace jiminy;
+
+
+// Simulate the double pendulum swinging freely and return the log of its state.
+static void simulateSwing(bool_t    const & denseOutput,
+                          vectorN_t       & timeLog,
+                          matrixN_t       & stateLog)
+{
+    auto robot = createDoublePendulum();
+    auto engine = std::make_shared<Engine>();
+    engine->initialize(robot, callbackNoStop);
+
+    configHolder_t simuOptions = engine->getDefaultEngineOptions();
+    configHolder_t & stepperOptions = boost::get<configHolder_t>(simuOptions.at("stepper"));
+    boost::get<bool_t>(stepperOptions.at("denseOutput")) = denseOutput;
+    boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod")) = 1.0e-3;
+    boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod")) = 2.0e-2;
+    boost::get<float64_t>(stepperOptions.at("tolAbs")) = 1.0e-8;
+    boost::get<float64_t>(stepperOptions.at("tolRel")) = 1.0e-8;
+    ASSERT_EQ(engine->setOptions(simuOptions), hresult_t::SUCCESS);
+
+    vectorN_t q0 = vectorN_t::Zero(2);
+    q0[0] = 1.0;
+    vectorN_t v0 = vectorN_t::Zero(2);
+    ASSERT_EQ(engine->simulate(1.0, q0, v0), hresult_t::SUCCESS);
+
+    std::vector<std::string> fieldnames;
+    matrixN_t logData;
+    engine->getLogData(fieldnames, logData);
+    timeLog = getLogFieldValue("Global.Time", fieldnames, logData);
+    std::vector<std::string> stateFieldnames = robot->getPositionFieldnames();
+    for (std::vector<std::string> const & names : {robot->getVelocityFieldnames(),
+                                                   robot->getAccelerationFieldnames()})
+    {
+        stateFieldnames.insert(stateFieldnames.end(), names.begin(), names.end());
+    }
+    stateLog = getLogFieldsValue(stateFieldnames, fieldnames, logData);
+}
+
+
+TEST(Stepper, DenseOutputMatchesBreakpoints)
+{
+    // Verify that sampling the sensors and the telemetry inside the steps, based on the dense
+    // output of the stepper, matches stopping the stepper at every update time.
+    vectorN_t timeRef;
+    matrixN_t stateRef;
+    simulateSwing(false, timeRef, stateRef);
+    vectorN_t timeDense;
+    matrixN_t stateDense;
+    simulateSwing(true, timeDense, stateDense);
+
+    // The same update times must be logged
+    ASSERT_EQ(timeDense.rows(), timeRef.rows());
+    ASSERT_TRUE(timeDense.isApprox(timeRef, TOLERANCE));
+
+    // The interpolated state, including the acceleration, must match up to integration tolerance
+    ASSERT_TRUE(stateDense.isApprox(stateRef, 1.0e-5));
+}
+
+
+// Simulate three double pendulums, the first two being coupled by a spring, and return their final state.
+static std::map<std::string, vectorN_t> simulateCoupledSwing(bool_t const & multiRate)
+{
+    std::vector<std::string> const systemNames{"slow", "fast", "free"};
+
+    auto engine = std::make_shared<EngineMultiRobot>();
+    std::map<std::string, std::shared_ptr<Robot> > robots;
+    std::map<std::string, vectorN_t> qInit, vInit;
+    for (std::size_t i = 0; i < systemNames.size(); ++i)
+    {
+        robots[systemNames[i]] = createDoublePendulum();
+        engine->addSystem(systemNames[i], robots[systemNames[i]], callbackNoStop);
+        qInit[systemNames[i]] = vectorN_t::Constant(2, 0.3 * static_cast<float64_t>(i + 1));
+        vInit[systemNames[i]] = vectorN_t::Zero(2);
+    }
+    engine->registerViscoelasticDirectionalForceCoupling(
+        "slow", "fast", "SecondPendulumMass", "SecondPendulumMass", 10.0, 1.0);
+
+    configHolder_t simuOptions = engine->getOptions();
+    configHolder_t & stepperOptions = boost::get<configHolder_t>(simuOptions.at("stepper"));
+    boost::get<bool_t>(stepperOptions.at("multiRate")) = multiRate;
+    boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod")) = 1.0e-2;
+    boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod")) = 1.0e-2;
+    boost::get<float64_t>(stepperOptions.at("tolAbs")) = 1.0e-8;
+    boost::get<float64_t>(stepperOptions.at("tolRel")) = 1.0e-8;
+    EXPECT_EQ(engine->setOptions(simuOptions), hresult_t::SUCCESS);
+    EXPECT_EQ(engine->simulate(1.0, qInit, vInit), hresult_t::SUCCESS);
+
+    std::map<std::string, vectorN_t> stateFinal;
+    for (std::string const & systemName : systemNames)
+    {
+        systemState_t const * systemState;
+        engine->getSystemState(systemName, systemState);
+        stateFinal[systemName] = vectorN_t(4);
+        stateFinal[systemName] << systemState->q, systemState->v;
+    }
+    return stateFinal;
+}
+
+
+TEST(Stepper, MultiRateMatchesSingleRate)
+{
+    // Verify that integrating each system with its own step size matches integrating them
+    // together, exactly for uncoupled systems and approximately for coupled ones.
+    std::map<std::string, vectorN_t> stateRef = simulateCoupledSwing(false);
+    std::map<std::string, vectorN_t> stateMultiRate = simulateCoupledSwing(true);
+    ASSERT_TRUE(stateMultiRate["free"].isApprox(stateRef["free"], 1.0e-6));
+    ASSERT_TRUE(stateMultiRate["slow"].isApprox(stateRef["slow"], 1.0e-3));
+    ASSERT_TRUE(stateMultiRate["fast"].isApprox(stateRef["fast"], 1.0e-3));
+}
+
+
+TEST(Stepper, MultiRateRejectsLoggingInternalSteps)
+{
+    // Verify that logging the internal steps is not silently ignored by multi-rate integration
+    auto engine = std::make_shared<EngineMultiRobot>();
+    engine->addSystem("system", createDoublePendulum(), callbackNoStop);
+    configHolder_t simuOptions = engine->getOptions();
+    configHolder_t & stepperOptions = boost::get<configHolder_t>(simuOptions.at("stepper"));
+    boost::get<bool_t>(stepperOptions.at("multiRate")) = true;
+    boost::get<bool_t>(stepperOptions.at("logInternalStepperSteps")) = true;
+    boost::get<float64_t>(stepperOptions.at("sensorsUpdatePeriod")) = 1.0e-2;
+    boost::get<float64_t>(stepperOptions.at("controllerUpdatePeriod")) = 1.0e-2;
+    ASSERT_EQ(engine->setOptions(simuOptions), hresult_t::ERROR_BAD_INPUT);
+}
@@ -0,0 +1,223 @@
+// Helpers shared by the unit tests.
+// The test system is the double inverted pendulum stored in the data folder.
+#ifndef JIMINY_UNIT_UTILITIES_H
+#define JIMINY_UNIT_UTILITIES_H
+
+#include <fstream>
+
+#include "pinocchio/multibody/geometry.hpp"
+#include "hpp/fcl/BVH/BVH_model.h"
+
+#include "jiminy/core/engine/EngineMultiRobot.h"
+#include "jiminy/core/robot/Robot.h"
+#include "jiminy/core/robot/BasicMotors.h"
+#include "jiminy/core/robot/BasicSensors.h"
+#include "jiminy/core/utilities/Helpers.h"
+#include "jiminy/core/Constants.h"
+#include "jiminy/core/Types.h"
+
+
+namespace jiminy
+{
+    float64_t const TOLERANCE = 1e-9;
+
+    std::vector<std::string> const DOUBLE_PENDULUM_JOINT_NAMES{"PendulumJoint", "SecondPendulumJoint"};
+
+    // Callback never stopping the simulation
+    inline bool_t callbackNoStop(float64_t const & /* t */,
+                                 vectorN_t const & /* q */,
+                                 vectorN_t const & /* v */)
+    {
+        return true;
+    }
+
+    /// \brief Load the double pendulum, without position, velocity nor command limits.
+    ///
+    /// \param[in] withMotors Whether to attach a simple motor to every joints.
+    inline std::shared_ptr<Robot> createDoublePendulum(bool_t const & withMotors = true)
+    {
+        std::string const dataDirPath(UNIT_TEST_DATA_DIR);
+        auto const urdfPath = dataDirPath + "/double_pendulum_rigid.urdf";
+
+        auto robot = std::make_shared<Robot>();
+        robot->initialize(urdfPath, false);
+        if (withMotors)
+        {
+            for (std::string const & jointName : DOUBLE_PENDULUM_JOINT_NAMES)
+            {
+                auto motor = std::make_shared<SimpleMotor>(jointName);
+                robot->attachMotor(motor);
+                motor->initialize(jointName);
+            }
+
+            configHolder_t motorsOptions = robot->getMotorsOptions();
+            for (auto & options : motorsOptions)
+            {
+                configHolder_t & motorOptions = boost::get<configHolder_t>(options.second);
+                boost::get<bool_t>(motorOptions.at("enableCommandLimit")) = false;
+            }
+            robot->setMotorsOptions(motorsOptions);
+        }
+
+        configHolder_t modelOptions = robot->getModelOptions();
+        boost::get<bool_t>(boost::get<configHolder_t>(modelOptions.at("joints")).at("enablePositionLimit")) = false;
+        boost::get<bool_t>(boost::get<configHolder_t>(modelOptions.at("joints")).at("enableVelocityLimit")) = false;
+        robot->setModelOptions(modelOptions);
+
+        return robot;
+    }
+
+    /// \brief Load the double pendulum, with a DC motor on every joints, without command nor
+    ///        voltage limits.
+    ///
+    /// \param[out] motors        DC motors of the robot, in the order of the joints.
+    /// \param[in]  withEncoders  Whether to attach an encoder to every joints.
+    inline std::shared_ptr<Robot> createDCMotorDoublePendulum(std::vector<std::shared_ptr<DCMotor> > & motors,
+                                                              bool_t const & withEncoders = false)
+    {
+        auto robot = createDoublePendulum(false);
+        motors.clear();
+        for (std::string const & jointName : DOUBLE_PENDULUM_JOINT_NAMES)
+        {
+            auto motor = std::make_shared<DCMotor>(jointName);
+            robot->attachMotor(motor);
+            motor->initialize(jointName);
+            motors.push_back(motor);
+
+            if (withEncoders)
+            {
+                auto encoder = std::make_shared<EncoderSensor>(jointName);
+                robot->attachSensor(encoder);
+                encoder->initialize(jointName);
+            }
+        }
+
+        configHolder_t motorsOptions = robot->getMotorsOptions();
+        for (auto & options : motorsOptions)
+        {
+            configHolder_t & motorOptions = boost::get<configHolder_t>(options.second);
+            boost::get<bool_t>(motorOptions.at("enableCommandLimit")) = false;
+            boost::get<bool_t>(motorOptions.at("enableVoltageLimit")) = false;
+        }
+        robot->setMotorsOptions(motorsOptions);
+        robot->reset();
+
+        return robot;
+    }
+
+    /// \brief Whether two geometry models are the same, comparing the content of the geometries
+    ///        rather than their address.
+    inline bool_t isGeometryModelEqual(pinocchio::GeometryModel const & geomModel1,
+                                       pinocchio::GeometryModel const & geomModel2)
+    {
+        if (geomModel1.ngeoms != geomModel2.ngeoms
+         || geomModel1.collisionPairs.size() != geomModel2.collisionPairs.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < geomModel1.ngeoms; ++i)
+        {
+            pinocchio::GeometryObject const & geom1 = geomModel1.geometryObjects[i];
+            pinocchio::GeometryObject const & geom2 = geomModel2.geometryObjects[i];
+            if (geom1.name != geom2.name
+             || geom1.parentFrame != geom2.parentFrame
+             || geom1.parentJoint != geom2.parentJoint
+             || !(geom1.placement == geom2.placement)
+             || geom1.meshPath != geom2.meshPath
+             || geom1.meshScale != geom2.meshScale
+             || !geom1.geometry != !geom2.geometry)
+            {
+                return false;
+            }
+            if (!geom1.geometry)
+            {
+                continue;
+            }
+            hpp::fcl::CollisionGeometry const & geometry1 = *geom1.geometry;
+            hpp::fcl::CollisionGeometry const & geometry2 = *geom2.geometry;
+            if (geometry1.getObjectType() != geometry2.getObjectType()
+             || geometry1.getNodeType() != geometry2.getNodeType()
+             || geometry1.aabb_local.min_ != geometry2.aabb_local.min_
+             || geometry1.aabb_local.max_ != geometry2.aabb_local.max_)
+            {
+                return false;
+            }
+            if (geometry1.getObjectType() == hpp::fcl::OT_BVH)
+            {
+                auto const & bvh1 = static_cast<hpp::fcl::BVHModelBase const &>(geometry1);
+                auto const & bvh2 = static_cast<hpp::fcl::BVHModelBase const &>(geometry2);
+                if (bvh1.num_vertices != bvh2.num_vertices || bvh1.num_tris != bvh2.num_tris)
+                {
+                    return false;
+                }
+                for (int32_t j = 0; j < static_cast<int32_t>(bvh1.num_vertices); ++j)
+                {
+                    if (bvh1.vertices[j] != bvh2.vertices[j])
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    /// \brief Write an ASCII STL file describing the unit tetrahedron.
+    inline void writeTetrahedronStl(std::string const & meshPath)
+    {
+        std::ofstream file(meshPath, std::ios::out | std::ios::trunc);
+        file << "solid tetrahedron\n";
+        float64_t const vertices[4][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+        int32_t const faces[4][3] = {{0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3}};
+        for (auto const & face : faces)
+        {
+            file << "facet normal 0 0 0\nouter loop\n";
+            for (int32_t const & vertexIdx : face)
+            {
+                float64_t const * vertex = vertices[vertexIdx];
+                file << "vertex " << vertex[0] << " " << vertex[1] << " " << vertex[2] << "\n";
+            }
+            file << "endloop\nendfacet\n";
+        }
+        file << "endsolid tetrahedron\n";
+    }
+
+    /// \brief Write a URDF file made of a single body, with a collision mesh for each given mesh
+    ///        file, whose scale increases with its index, so that every geometry is different.
+    ///
+    /// \return Path of the URDF file, in the given directory.
+    inline std::string writeMeshesUrdf(std::string              const & dirPath,
+                                       std::vector<std::string> const & meshPaths)
+    {
+        std::string const urdfPath = dirPath + "/meshes.urdf";
+        std::ofstream file(urdfPath, std::ios::out | std::ios::trunc);
+        file << "<?xml version=\"1.0\" ?>\n<robot name=\"meshes\">\n  <link name=\"body\">\n";
+        for (std::size_t i = 0; i < meshPaths.size(); ++i)
+        {
+            float64_t const scale = static_cast<float64_t>(i + 1);
+            file << "    <collision>\n      <geometry>\n"
+                 << "        <mesh filename=\"" << meshPaths[i] << "\" scale=\""
+                 << scale << " " << scale << " " << scale << "\"/>\n"
+                 << "      </geometry>\n    </collision>\n";
+        }
+        file << "  </link>\n</robot>\n";
+        return urdfPath;
+    }
+
+    /// \brief Extract the log of several variables of the engine telemetry, one per column.
+    inline matrixN_t getLogFieldsValue(std::vector<std::string> const & fieldnamesEngine,
+                                       std::vector<std::string> const & fieldnames,
+                                       matrixN_t                const & logData)
+    {
+        matrixN_t values(logData.rows(), static_cast<Eigen::Index>(fieldnamesEngine.size()));
+        for (std::size_t i = 0; i < fieldnamesEngine.size(); ++i)
+        {
+            values.col(static_cast<Eigen::Index>(i)) = getLogFieldValue(
+                ENGINE_TELEMETRY_NAMESPACE + TELEMETRY_FIELDNAME_DELIMITER + fieldnamesEngine[i],
+                fieldnames, logData);
+        }
+        return values;
+    }
+}
+
+#endif  // JIMINY_UNIT_UTILITIES_H
@@ -0,0 +1,151 @@
+"""
+@brief This file aims at verifying that the controllers implemented in Python
+       by inheriting from jiminy.BaseController behave the same as their
+       functor-based counterpart, whether or not each callback is overridden,
+       and that the arguments passed to Python callables are safe to keep.
+"""
+import unittest
+import numpy as np
+
+import jiminy_py.core as jiminy
+
+from utilities import (
+    load_urdf_default,
+    setup_controller_and_engine,
+    simulate_and_get_state_evolution)
+
+
+# Gains of the control law and stiffness of the internal dynamics
+KP, KD = 50.0, 2.0
+K_SPRING = 20.0
+
+
+class ControllerComputeCommandOnly(jiminy.BaseController):
+    """
+    @brief Controller only overriding 'compute_command'.
+    """
+    def compute_command(self, t, q, v, command):
+        command[:] = - KP * q - KD * v
+
+
+class ControllerInternalDynamicsOnly(jiminy.BaseController):
+    """
+    @brief Controller only overriding 'internal_dynamics', counting the number
+           of times it is called.
+    """
+    def __init__(self):
+        super().__init__()
+        self.n_calls = 0
+
+    def internal_dynamics(self, t, q, v, u_custom):
+        self.n_calls += 1
+        u_custom[:] = - K_SPRING * q
+
+
+class ControllerNoCallback(jiminy.BaseController):
+    """
+    @brief Controller overriding neither 'compute_command' nor
+           'internal_dynamics'.
+    """
+
+
+class PythonControllers(unittest.TestCase):
+    """
+    @brief Simulate the double pendulum with controllers implemented in
+           Python, comparing against the equivalent controller functor.
+    """
+    def setUp(self):
+        self.urdf_name = "double_pendulum.urdf"
+        self.motors_names = ["PendulumJoint", "SecondPendulumJoint"]
+        self.x0 = np.array([0.1, -0.2, 0.0, 0.0])
+        self.tf = 1.0
+
+    def _simulate(self, controller=None, compute_command=None,
+                  internal_dynamics=None):
+        """
+        @brief Simulate the double pendulum, either using the given instance
+               of jiminy.BaseController, or otherwise a functor wrapping the
+               given callbacks.
+        """
+        robot = load_urdf_default(self.urdf_name, self.motors_names)
+        engine = jiminy.Engine()
+        if controller is not None:
+            controller.initialize(robot)
+            engine.initialize(robot, controller)
+        else:
+            setup_controller_and_engine(
+                engine, robot, compute_command, internal_dynamics)
+        return simulate_and_get_state_evolution(
+            engine, self.tf, self.x0, split=False)
+
+    def test_compute_command_only(self):
+        """
+        @brief Check that the command computed by a Python controller
+               overriding only 'compute_command' is applied.
+        """
+        def compute_command(t, q, v, sensors_data, command):
+            command[:] = - KP * q - KD * v
+
+        time_ref, x_ref = self._simulate(compute_command=compute_command)
+        time, x = self._simulate(ControllerComputeCommandOnly())
+        self.assertTrue(np.array_equal(time, time_ref))
+        self.assertTrue(np.allclose(x, x_ref))
+
+        # The controller must actually have an effect on the dynamics
+        _, x_free = self._simulate()
+        self.assertFalse(np.allclose(x, x_free))
+
+    def test_internal_dynamics_only(self):
+        """
+        @brief Check that 'internal_dynamics' is called when overridden, even
+               though 'compute_command' is not.
+        """
+        def internal_dynamics(t, q, v, sensors_data, u_custom):
+            u_custom[:] = - K_SPRING * q
+
+        time_ref, x_ref = self._simulate(internal_dynamics=internal_dynamics)
+        controller = ControllerInternalDynamicsOnly()
+        time, x = self._simulate(controller)
+        self.assertGreater(controller.n_calls, 0)
+        self.assertTrue(np.array_equal(time, time_ref))
+        self.assertTrue(np.allclose(x, x_ref))
+
+    def test_no_callback(self):
+        """
+        @brief Check that a Python controller overriding no callback is
+               equivalent to having no controller at all.
+        """
+        time_ref, x_ref = self._simulate()
+        time, x = self._simulate(ControllerNoCallback())
+        self.assertTrue(np.array_equal(time, time_ref))
+        self.assertTrue(np.allclose(x, x_ref))
+
+    def test_arguments_retained_by_python(self):
+        """
+        @brief Check that the state passed to Python callables is read-only,
+               and that arrays kept by Python are never modified afterward.
+        """
+        q_all, q_copy_all, writeable_all = [], [], []
+
+        def compute_command(t, q, v, sensors_data, command):
+            q_all.append(q)
+            q_copy_all.append(q.copy())
+            writeable_all.append(q.flags.writeable or v.flags.writeable)
+            command[:] = - KP * q - KD * v
+
+        time, x = self._simulate(compute_command=compute_command)
+        self.assertFalse(any(writeable_all))
+
+        # Every retained array must still hold the state of its own call
+        self.assertGreater(len(q_all), 2)
+        for q, q_copy in zip(q_all, q_copy_all):
+            self.assertTrue(np.array_equal(q, q_copy))
+        self.assertFalse(np.array_equal(q_all[-1], q_all[1]))
+
+        # The command written by the callable must be applied anyway
+        _, x_free = self._simulate()
+        self.assertFalse(np.allclose(x, x_free))
+
+
+if __name__ == '__main__':
+    unittest.main()
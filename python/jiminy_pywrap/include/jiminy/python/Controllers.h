@@ -8,6 +8,9 @@ namespace python
 {
     void exposeAbstractController(void);
     void exposeControllerFunctor(void);
+    void exposeControllerPlugin(void);
+    void exposeMlpController(void);
+    void exposePDController(void);
 }  // End of namespace python.
 }  // End of namespace jiminy.
 
@@ -9,6 +9,7 @@ namespace python
     void exposeForces(void);
     void exposeStepperState(void);
     void exposeSystemState(void);
+    void exposeEngineState(void);
     void exposeSystem(void);
     void exposeEngineMultiRobot(void);
     void exposeEngine(void);
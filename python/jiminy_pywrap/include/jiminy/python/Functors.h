@@ -1,6 +1,9 @@
 #ifndef FUNCTORS_WRAPPERS_PYTHON_H
 #define FUNCTORS_WRAPPERS_PYTHON_H
 
+#include <tuple>
+#include <utility>
+
 #include "jiminy/core/Types.h"
 
 #include <boost/python.hpp>
@@ -75,6 +78,119 @@ namespace python
         return boost::ref(arg);
     }
 
+    /// \brief Python object of an argument of a Python callable, which is only re-created if
+    ///        necessary. Passing the buffers of the engine to Python then costs nothing more than
+    ///        the function call itself.
+    ///
+    /// \details Arithmetic types are passed by value, without any intermediary copy.
+    template<typename T, typename = void>
+    struct FctPyWrapperArgCache
+    {
+        T const & get(T const & arg) const
+        {
+            return arg;
+        }
+    };
+
+    /// \details Eigen objects are copied in a numpy array owned by the cache, instead of being
+    ///          passed by reference. The array can be reused regardless of the address of the
+    ///          C++ buffer, which changes at every step for the stepper alternating between its
+    ///          buffers, and it never dangles. It is re-created if the shape changes, or if the
+    ///          callable kept a reference on it, so that arrays retained by Python are left
+    ///          untouched afterward.
+    template<typename T>
+    struct FctPyWrapperArgCache<T, std::enable_if_t<is_eigen_v<T> > >
+    {
+    public:
+        using PlainObjectType = typename T::PlainObject;
+        using Scalar = typename T::Scalar;
+
+    public:
+        FctPyWrapperArgCache(void) :
+        argPy_()
+        {
+            // Empty on purpose
+        }
+
+        /// \brief Read-only array holding a copy of an input argument.
+        template<typename U>
+        bp::handle<> const & get(U const & arg)
+        {
+            PyArrayObject * array = bind(arg);
+            PyArray_CLEARFLAGS(array, NPY_ARRAY_WRITEABLE);
+            return argPy_;
+        }
+
+        /// \brief Writable array holding a copy of an output argument. The result must be copied
+        ///        back by calling 'commit' once the callable returns.
+        template<typename U>
+        bp::handle<> const & getMutable(U const & arg)
+        {
+            PyArrayObject * array = bind(arg);
+            PyArray_ENABLEFLAGS(array, NPY_ARRAY_WRITEABLE);
+            return argPy_;
+        }
+
+        /// \brief Copy back the content of the array returned by 'getMutable'.
+        template<typename U>
+        void commit(U & arg) const
+        {
+            PyArrayObject * array = reinterpret_cast<PyArrayObject *>(argPy_.get());
+            arg = Eigen::Map<PlainObjectType const>(
+                static_cast<Scalar const *>(PyArray_DATA(array)), arg.rows(), arg.cols());
+        }
+
+    private:
+        template<typename U>
+        PyArrayObject * bind(U const & arg)
+        {
+            PyArrayObject * array = reinterpret_cast<PyArrayObject *>(argPy_.get());
+            if (!array || Py_REFCNT(argPy_.get()) > 1
+             || PyArray_DIM(array, 0) != arg.rows()
+             || (PlainObjectType::ColsAtCompileTime != 1 && PyArray_DIM(array, 1) != arg.cols()))
+            {
+                // The array is column-major to match the memory layout of Eigen
+                int const nd = (PlainObjectType::ColsAtCompileTime == 1) ? 1 : 2;
+                npy_intp dims[2] = {npy_intp(arg.rows()), npy_intp(arg.cols())};
+                argPy_ = bp::handle<>(PyArray_New(&PyArray_Type, nd, dims, getPyType(Scalar()),
+                                                  NULL, NULL, 0, NPY_ARRAY_F_CONTIGUOUS, NULL));
+                array = reinterpret_cast<PyArrayObject *>(argPy_.get());
+            }
+            Eigen::Map<PlainObjectType>(
+                static_cast<Scalar *>(PyArray_DATA(array)), arg.rows(), arg.cols()) = arg;
+            return array;
+        }
+
+    private:
+        bp::handle<> argPy_;
+    };
+
+    template<typename T>
+    struct FctPyWrapperArgCache<T, std::enable_if_t<std::is_same<T, sensorsDataMap_t>::value> >
+    {
+    public:
+        FctPyWrapperArgCache(void) :
+        data_(nullptr),
+        argPy_()
+        {
+            // Empty on purpose
+        }
+
+        bp::object const & get(T const & arg)
+        {
+            if (&arg != data_)
+            {
+                argPy_ = bp::object(FctPyWrapperArgToPython(arg));
+                data_ = &arg;
+            }
+            return argPy_;
+        }
+
+    private:
+        T const * data_;
+        bp::object argPy_;
+    };
+
     template<typename OutputArg, typename ... InputArgs>
     struct FctPyWrapper
     {
@@ -87,6 +203,7 @@ namespace python
     public:
         FctPyWrapper(bp::object const & objPy) :
         funcPyPtr_(objPy),
+        argsPy_(),
         outPtr_(createInternalBuffer<OutputArg>()),
         outData_(setDataInternalBuffer(outPtr_)),
         outPyPtr_(nullptr)
@@ -97,6 +214,7 @@ namespace python
         // Copy constructor, same as the normal constructor
         FctPyWrapper(FctPyWrapper const & other) :
         funcPyPtr_(other.funcPyPtr_),
+        argsPy_(),
         outPtr_(createInternalBuffer<OutputArg>()),
         outData_(setDataInternalBuffer(outPtr_)),
         outPyPtr_(nullptr)
@@ -108,6 +226,7 @@ namespace python
         // Move constructor, takes a rvalue reference &&
         FctPyWrapper(FctPyWrapper&& other) :
         funcPyPtr_(other.funcPyPtr_),
+        argsPy_(std::move(other.argsPy_)),
         outPtr_(nullptr),
         outData_(other.outData_),
         outPyPtr_(nullptr)
@@ -135,6 +254,7 @@ namespace python
             /* "other" is soon going to be destroyed, so we let it destroy our current resource
                instead and we take "other"'s current resource via swapping */
             std::swap(funcPyPtr_, other.funcPyPtr_);
+            std::swap(argsPy_, other.argsPy_);
             std::swap(outPtr_, other.outPtr_);
             std::swap(outData_, other.outData_);
             std::swap(outPyPtr_, other.outPyPtr_);
@@ -142,15 +262,23 @@ namespace python
         }
 
         OutputArg const & operator() (InputArgs const & ... args)
+        {
+            return call(std::index_sequence_for<InputArgs...>{}, args...);
+        }
+
+    private:
+        template<std::size_t ... Is>
+        OutputArg const & call(std::index_sequence<Is...>, InputArgs const & ... args)
         {
             PyArray_FILLWBYTE(reinterpret_cast<PyArrayObject *>(outPyPtr_), 0);  // Reset to 0 systematically
             bp::handle<> outPy(bp::borrowed(outPyPtr_));
-            funcPyPtr_(FctPyWrapperArgToPython(args)..., outPy);
+            funcPyPtr_(std::get<Is>(argsPy_).get(args)..., outPy);
             return *outPtr_;
         }
 
     private:
         bp::object funcPyPtr_;
+        std::tuple<FctPyWrapperArgCache<InputArgs>...> argsPy_;
         OutputArg * outPtr_;
         OutputBufferType outData_;
         PyObject * outPyPtr_;
@@ -176,15 +304,35 @@ namespace python
     struct FctInOutPyWrapper
     {
     public:
-        FctInOutPyWrapper(bp::object const & objPy) : funcPyPtr_(objPy) {}
+        FctInOutPyWrapper(bp::object const & objPy) :
+        funcPyPtr_(objPy),
+        argsInPy_(),
+        argOutPy_()
+        {
+            // Empty on purpose
+        }
+
         void operator() (InputArgs const & ... argsIn,
                          vectorN_t       &     argOut)
         {
-            funcPyPtr_(FctPyWrapperArgToPython(argsIn)...,
-                       FctPyWrapperArgToPython(argOut));
+            call(std::index_sequence_for<InputArgs...>{}, argsIn..., argOut);
         }
+
+    private:
+        template<std::size_t ... Is>
+        void call(std::index_sequence<Is...>,
+                  InputArgs const & ... argsIn,
+                  vectorN_t       &     argOut)
+        {
+            funcPyPtr_(std::get<Is>(argsInPy_).get(argsIn)...,
+                       argOutPy_.getMutable(argOut));
+            argOutPy_.commit(argOut);
+        }
+
     private:
         bp::object funcPyPtr_;
+        std::tuple<FctPyWrapperArgCache<InputArgs>...> argsInPy_;
+        FctPyWrapperArgCache<vectorN_t> argOutPy_;
     };
 
     using ControllerFctWrapper = FctInOutPyWrapper<vectorN_t /* OutputType */,
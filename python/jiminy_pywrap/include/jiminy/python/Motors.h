@@ -8,6 +8,7 @@ namespace python
 {
     void exposeAbstractMotor(void);
     void exposeSimpleMotor(void);
+    void exposeDCMotor(void);
 }  // End of namespace python.
 }  // End of namespace jiminy.
 
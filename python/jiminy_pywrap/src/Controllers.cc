@@ -1,5 +1,8 @@
 #include "jiminy/core/control/AbstractController.h"
 #include "jiminy/core/control/ControllerFunctor.h"
+#include "jiminy/core/control/ControllerPlugin.h"
+#include "jiminy/core/control/MlpController.h"
+#include "jiminy/core/control/PDController.h"
 
 #include <boost/python.hpp>
 
@@ -22,6 +25,29 @@ namespace python
     class AbstractControllerWrapper: public AbstractControllerImpl, public bp::wrapper<AbstractControllerImpl>
     {
     public:
+        AbstractControllerWrapper(void) :
+        AbstractControllerImpl(),
+        bp::wrapper<AbstractControllerImpl>(),
+        hasComputeCommand_(true),
+        qCommandPy_(),
+        vCommandPy_(),
+        commandPy_(),
+        qDynamicsPy_(),
+        vDynamicsPy_(),
+        uCustomPy_()
+        {
+            // Empty on purpose
+        }
+
+        hresult_t initialize(std::weak_ptr<Robot const> robot)
+        {
+            /* Check once and for all whether the methods are overridden in Python, to avoid
+               acquiring the GIL and calling Python at every integration step if not. */
+            hasComputeCommand_ = static_cast<bool_t>(this->get_override("compute_command"));
+            hasInternalDynamics_ = static_cast<bool_t>(this->get_override("internal_dynamics"));
+            return AbstractController::initialize(robot);
+        }
+
         hresult_t reset(bool_t const & resetDynamicTelemetry)
         {
             bp::override func = this->get_override("reset");
@@ -43,13 +69,14 @@ namespace python
                                  vectorN_t const & v,
                                  vectorN_t       & command)
         {
-            bp::override func = this->get_override("compute_command");
-            if (func)
+            if (hasComputeCommand_)
             {
-                func(t,
-                     FctPyWrapperArgToPython(q),
-                     FctPyWrapperArgToPython(v),
-                     FctPyWrapperArgToPython(command));
+                bp::override func = this->get_override("compute_command");
+                if (func)
+                {
+                    func(t, qCommandPy_.get(q), vCommandPy_.get(v), commandPy_.getMutable(command));
+                    commandPy_.commit(command);
+                }
             }
             return hresult_t::SUCCESS;
         }
@@ -59,16 +86,28 @@ namespace python
                                    vectorN_t const & v,
                                    vectorN_t       & uCustom)
         {
-            bp::override func = this->get_override("internal_dynamics");
-            if (func)
+            if (hasInternalDynamics_)
             {
-                func(t,
-                     FctPyWrapperArgToPython(q),
-                     FctPyWrapperArgToPython(v),
-                     FctPyWrapperArgToPython(uCustom));
+                bp::override func = this->get_override("internal_dynamics");
+                if (func)
+                {
+                    func(t, qDynamicsPy_.get(q), vDynamicsPy_.get(v), uCustomPy_.getMutable(uCustom));
+                    uCustomPy_.commit(uCustom);
+                }
             }
             return hresult_t::SUCCESS;
         }
+
+    private:
+        bool_t hasComputeCommand_;
+        /* The arguments of each method are cached separately, so that the arrays passed
+           to one of them are never overwritten by calling the other. */
+        FctPyWrapperArgCache<vectorN_t> qCommandPy_;
+        FctPyWrapperArgCache<vectorN_t> vCommandPy_;
+        FctPyWrapperArgCache<vectorN_t> commandPy_;
+        FctPyWrapperArgCache<vectorN_t> qDynamicsPy_;
+        FctPyWrapperArgCache<vectorN_t> vDynamicsPy_;
+        FctPyWrapperArgCache<vectorN_t> uCustomPy_;
     };
 
     struct PyAbstractControllerVisitor
@@ -345,19 +384,13 @@ namespace python
                                 sensorsDataMap_t const & /* sensorsData */,
                                 vectorN_t              & /* command */) {};
             }
+            /* Leave the internal dynamics empty if not specified, so that the engine
+               can skip it altogether instead of calling a no-op at every integration step. */
             ControllerFct internalDynamicsFct;
             if (!internalDynamicsPy.is_none())
             {
                 internalDynamicsFct = ControllerFctWrapper(internalDynamicsPy);
             }
-            else
-            {
-                internalDynamicsFct = [](float64_t        const & /* t */,
-                                         vectorN_t        const & /* q */,
-                                         vectorN_t        const & /* v */,
-                                         sensorsDataMap_t const & /* sensorsData */,
-                                         vectorN_t              & /* command */) {};
-            }
             return std::make_shared<CtrlFunctor>(std::move(commandFct),
                                                  std::move(internalDynamicsFct));
         }
@@ -385,5 +418,126 @@ namespace python
     };
 
     BOOST_PYTHON_VISITOR_EXPOSE(ControllerFunctor)
+
+    // ***************************** PyControllerPluginVisitor ***********************************
+
+    struct PyControllerPluginVisitor
+        : public bp::def_visitor<PyControllerPluginVisitor>
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+        template<class PyClass>
+        void visit(PyClass & cl) const
+        {
+            cl
+                .def("compute_command", &AbstractController::computeCommand,
+                                        (bp::arg("self"), "t", "q", "v", "command"))
+                .def("internal_dynamics", &AbstractController::internalDynamics,
+                                          (bp::arg("self"), "t", "q", "v", "u_custom"))
+                ;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<ControllerPlugin, bp::bases<AbstractController>,
+                       std::shared_ptr<ControllerPlugin>,
+                       boost::noncopyable>("ControllerPlugin")
+                .def(PyControllerPluginVisitor());
+        }
+    };
+
+    BOOST_PYTHON_VISITOR_EXPOSE(ControllerPlugin)
+
+    // ***************************** PyMlpControllerVisitor ***********************************
+
+    struct PyMlpControllerVisitor
+        : public bp::def_visitor<PyMlpControllerVisitor>
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+        template<class PyClass>
+        void visit(PyClass & cl) const
+        {
+            cl
+                .def("compute_command", &AbstractController::computeCommand,
+                                        (bp::arg("self"), "t", "q", "v", "command"))
+                .def("save_network", &PyMlpControllerVisitor::saveNetwork,
+                                     (bp::arg("filename"), "weights", "biases"))
+                .staticmethod("save_network")
+                ;
+        }
+
+        static hresult_t saveNetwork(std::string const & filename,
+                                     bp::object  const & weightsPy,
+                                     bp::object  const & biasesPy)
+        {
+            return MlpController::saveNetwork(filename,
+                                              convertFromPython<std::vector<matrixN_t> >(weightsPy),
+                                              convertFromPython<std::vector<vectorN_t> >(biasesPy));
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<MlpController, bp::bases<AbstractController>,
+                       std::shared_ptr<MlpController>,
+                       boost::noncopyable>("MlpController")
+                .def(PyMlpControllerVisitor());
+        }
+    };
+
+    BOOST_PYTHON_VISITOR_EXPOSE(MlpController)
+
+    // ***************************** PyPDControllerVisitor ***********************************
+
+    struct PyPDControllerVisitor
+        : public bp::def_visitor<PyPDControllerVisitor>
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+        template<class PyClass>
+        void visit(PyClass & cl) const
+        {
+            cl
+                .def("compute_command", &AbstractController::computeCommand,
+                                        (bp::arg("self"), "t", "q", "v", "command"))
+                .def("set_target", &PDController::setTarget,
+                                   (bp::arg("self"), "q_target", "v_target",
+                                    bp::arg("u_target") = vectorN_t()))
+                /* Return writable views, so that a higher-level policy can update
+                   the targets in-place without going through 'set_target'. */
+                .add_property("q_target", bp::make_function(&PDController::getPositionTarget,
+                                          bp::return_value_policy<result_converter<false> >()))
+                .add_property("v_target", bp::make_function(&PDController::getVelocityTarget,
+                                          bp::return_value_policy<result_converter<false> >()))
+                .add_property("u_target", bp::make_function(&PDController::getEffortTarget,
+                                          bp::return_value_policy<result_converter<false> >()))
+                ;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<PDController, bp::bases<AbstractController>,
+                       std::shared_ptr<PDController>,
+                       boost::noncopyable>("PDController")
+                .def(PyPDControllerVisitor());
+        }
+    };
+
+    BOOST_PYTHON_VISITOR_EXPOSE(PDController)
 }  // End of namespace python.
 }  // End of namespace jiminy.
@@ -125,6 +125,10 @@ namespace python
                                    bp::return_value_policy<result_converter<false> >()))
                 .add_property("a", bp::make_getter(&stepperState_t::aSplit,
                                    bp::return_value_policy<result_converter<false> >()))
+                .add_property("s", bp::make_getter(&stepperState_t::sSplit,
+                                   bp::return_value_policy<result_converter<false> >()))
+                .add_property("ds", bp::make_getter(&stepperState_t::dsSplit,
+                                    bp::return_value_policy<result_converter<false> >()))
                 .def("__repr__", &PyStepperStateVisitor::repr)
                 ;
         }
@@ -188,6 +192,10 @@ namespace python
                                    bp::return_value_policy<result_converter<false> >()))
                 .add_property("a", bp::make_getter(&systemState_t::a,
                                    bp::return_value_policy<result_converter<false> >()))
+                .add_property("s", bp::make_getter(&systemState_t::s,
+                                   bp::return_value_policy<result_converter<false> >()))
+                .add_property("ds", bp::make_getter(&systemState_t::ds,
+                                    bp::return_value_policy<result_converter<false> >()))
                 .add_property("command", bp::make_getter(&systemState_t::command,
                                          bp::return_value_policy<result_converter<false> >()))
                 .add_property("u", bp::make_getter(&systemState_t::u,
@@ -239,6 +247,38 @@ namespace python
 
     BOOST_PYTHON_VISITOR_EXPOSE(SystemState)
 
+    // ***************************** PyEngineStateVisitor ***********************************
+
+    struct PyEngineStateVisitor
+        : public bp::def_visitor<PyEngineStateVisitor>
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+        template<class PyClass>
+        void visit(PyClass & cl) const
+        {
+            cl
+                .add_property("stepper_state", bp::make_getter(&engineState_t::stepper,
+                                               bp::return_internal_reference<>()))
+                ;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<engineState_t,
+                       std::shared_ptr<engineState_t>,
+                       boost::noncopyable>("EngineState", bp::init<>())
+                .def(PyEngineStateVisitor());
+        }
+    };
+
+    BOOST_PYTHON_VISITOR_EXPOSE(EngineState)
+
     // ***************************** PySystemVisitor ***********************************
 
     struct PySystemVisitor
@@ -300,7 +340,7 @@ namespace python
 
                 .def("reset",
                     static_cast<
-                        void (EngineMultiRobot::*)(bool_t const &, bool_t const &)
+                        hresult_t (EngineMultiRobot::*)(bool_t const &, bool_t const &)
                     >(&EngineMultiRobot::reset),
                     (bp::arg("self"),
                      bp::arg("reset_random_generator") = false,
@@ -311,6 +351,10 @@ namespace python
                 .def("step", &PyEngineMultiRobotVisitor::step,
                              (bp::arg("self"), bp::arg("dt_desired") = -1))
                 .def("stop", &EngineMultiRobot::stop, (bp::arg("self")))
+                .def("save_state", &EngineMultiRobot::saveState,
+                                   (bp::arg("self"), "engine_state"))
+                .def("restore_state", &EngineMultiRobot::restoreState,
+                                      (bp::arg("self"), "engine_state"))
                 .def("simulate", &PyEngineMultiRobotVisitor::simulate,
                                  (bp::arg("self"), "t_end", "q_init_list", "v_init_list",
                                   bp::arg("a_init_list") = bp::object()))
@@ -318,7 +362,8 @@ namespace python
                                                    (bp::arg("system"), "q", "v", "a"))
                 .staticmethod("compute_forward_kinematics")
                 .def("compute_systems_dynamics", &PyEngineMultiRobotVisitor::computeSystemsDynamics,
-                                                 (bp::arg("self"), "t_end", "q_list", "v_list"))
+                                                 (bp::arg("self"), "t_end", "q_list", "v_list",
+                                                  bp::arg("s_list") = bp::object()))
 
                 .def("get_log", &PyEngineMultiRobotVisitor::getLog)
                 .def("write_log", &EngineMultiRobot::writeLog,
@@ -431,8 +476,11 @@ namespace python
 
                 .def("remove_all_forces", &EngineMultiRobot::removeAllForces)
 
-                .def("get_options", &EngineMultiRobot::getOptions)
+                .def("get_options", &EngineMultiRobot::getOptions,
+                                    bp::return_value_policy<result_converter<true> >())
                 .def("set_options", &PyEngineMultiRobotVisitor::setOptions)
+                .def("set_option", &PyEngineMultiRobotVisitor::setOption,
+                                   (bp::arg("self"), "path", "value"))
 
                 .add_property("systems", bp::make_getter(&EngineMultiRobot::systems_,
                                          bp::return_internal_reference<>()))
@@ -576,14 +624,24 @@ namespace python
         static bp::object computeSystemsDynamics(EngineMultiRobot       & self,
                                                  float64_t        const & endTime,
                                                  bp::list         const & qSplitPy,
-                                                 bp::list         const & vSplitPy)
+                                                 bp::list         const & vSplitPy,
+                                                 bp::object       const & sSplitPy)
         {
+            // Use the current internal state of the motors if not specified
+            std::vector<vectorN_t> sSplit = self.getStepperState().sSplit;
+            if (!sSplitPy.is_none())
+            {
+                sSplit = convertFromPython<std::vector<vectorN_t> >(sSplitPy);
+            }
             static std::vector<vectorN_t> aSplit;
+            static std::vector<vectorN_t> dsSplit;
             self.computeSystemsDynamics(
                 endTime,
                 convertFromPython<std::vector<vectorN_t> >(qSplitPy),
                 convertFromPython<std::vector<vectorN_t> >(vSplitPy),
-                aSplit
+                sSplit,
+                aSplit,
+                dsSplit
             );
             return convertToPython<std::vector<vectorN_t> >(aSplit, true);
         }
@@ -778,6 +836,24 @@ namespace python
             return self.setOptions(config);
         }
 
+        static hresult_t setOption(EngineMultiRobot       & self,
+                                   std::string      const & path,
+                                   bp::object               valuePy)
+        {
+            // Only the current value of the option is copied, to get its type
+            configField_t const * field;
+            hresult_t returnCode = getConfigField(self.getOptions(), path, field);
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                configField_t value = *field;
+                AppendPythonToBoostVariant visitor;
+                visitor.objPy_ = &valuePy;
+                boost::apply_visitor(visitor, value);
+                returnCode = self.setOption(path, value);
+            }
+            return returnCode;
+        }
+
         ///////////////////////////////////////////////////////////////////////////////
         /// \brief Expose.
         ///////////////////////////////////////////////////////////////////////////////
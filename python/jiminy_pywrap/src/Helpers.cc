@@ -68,7 +68,8 @@ namespace python
                                                bp::object const & typePy,
                                                bp::list const & packageDirsPy,
                                                bool_t const & loadMeshes,
-                                               bool_t const & makeMeshesConvex)
+                                               bool_t const & makeMeshesConvex,
+                                               uint32_t const & nThreads)
     {
         /* Note that enum bindings interoperability is buggy, so that `pin.GeometryType`
            is not properly converted from Python to C++ automatically in some cases. */
@@ -81,7 +82,8 @@ namespace python
                                     geometryModel,
                                     packageDirs,
                                     loadMeshes,
-                                    makeMeshesConvex);
+                                    makeMeshesConvex,
+                                    nThreads);
         return geometryModel;
     }
 
@@ -89,7 +91,9 @@ namespace python
                                   bool_t const & hasFreeflyer,
                                   bp::list const & packageDirsPy,
                                   bool_t const & buildVisualModel,
-                                  bool_t const & loadVisualMeshes)
+                                  bool_t const & loadVisualMeshes,
+                                  std::string const & cacheDir,
+                                  uint32_t const & nThreads)
     {
         /* Note that enum bindings interoperability is buggy, so that `pin.GeometryType`
            is not properly converted from Python to C++ automatically in some cases. */
@@ -108,7 +112,9 @@ namespace python
                                       model,
                                       collisionModel,
                                       visualModelOptional,
-                                      loadVisualMeshes);
+                                      loadVisualMeshes,
+                                      cacheDir,
+                                      nThreads);
         if (buildVisualModel)
         {
             return bp::make_tuple(model, collisionModel, visualModel);
@@ -154,13 +160,16 @@ namespace python
                                         (bp::arg("pinocchio_model"), "urdf_filename", "geom_type",
                                          bp::arg("mesh_package_dirs") = bp::list(),
                                          bp::arg("load_meshes") = true,
-                                         bp::arg("make_meshes_convex") = false));
+                                         bp::arg("make_meshes_convex") = false,
+                                         bp::arg("n_threads") = 1U));
 
         bp::def("build_models_from_urdf", &buildModelsFromUrdf,
                                           (bp::arg("urdf_path"), "has_freeflyer",
                                            bp::arg("mesh_package_dirs") = bp::list(),
                                            bp::arg("build_visual_model") = false,
-                                           bp::arg("load_visual_meshes") = false));
+                                           bp::arg("load_visual_meshes") = false,
+                                           bp::arg("cache_dir") = std::string(),
+                                           bp::arg("n_threads") = 1U));
 
         bp::def("load_from_binary", &::jiminy::loadFromBinary<pinocchio::Model>,
                                    (bp::arg("model"), "dump"));
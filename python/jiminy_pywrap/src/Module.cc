@@ -132,13 +132,18 @@ namespace python
         exposeConstraintsHolder();
         exposeAbstractMotor();
         exposeSimpleMotor();
+        exposeDCMotor();
         exposeAbstractSensor();
         exposeBasicSensors();
         exposeAbstractController();
         exposeControllerFunctor();
+        exposeControllerPlugin();
+        exposeMlpController();
+        exposePDController();
         exposeForces();
         exposeStepperState();
         exposeSystemState();
+        exposeEngineState();
         exposeSystem();
         exposeEngineMultiRobot();
         exposeEngine();
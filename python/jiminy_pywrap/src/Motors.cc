@@ -121,5 +121,43 @@ namespace python
     };
 
     BOOST_PYTHON_VISITOR_EXPOSE(SimpleMotor)
+
+    // ***************************** PyDCMotorVisitor ***********************************
+
+    struct PyDCMotorVisitor
+        : public bp::def_visitor<PyDCMotorVisitor>
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose C++ API through the visitor.
+        ///////////////////////////////////////////////////////////////////////////////
+
+        template<class PyClass>
+        void visit(PyClass & cl) const
+        {
+            cl
+                .def("initialize", &DCMotor::initialize)
+                .add_property("current", bp::make_function(&DCMotor::getCurrent,
+                                         bp::return_value_policy<bp::copy_const_reference>()))
+                .add_property("temperature", bp::make_function(&DCMotor::getTemperature,
+                                             bp::return_value_policy<bp::copy_const_reference>()))
+                ;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Expose.
+        ///////////////////////////////////////////////////////////////////////////////
+        static void expose()
+        {
+            bp::class_<DCMotor, bp::bases<AbstractMotorBase>,
+                       std::shared_ptr<DCMotor>,
+                       boost::noncopyable>("DCMotor",
+                       bp::init<std::string const &>(
+                       bp::args("self", "motor_name")))
+                .def(PyDCMotorVisitor());
+        }
+    };
+
+    BOOST_PYTHON_VISITOR_EXPOSE(DCMotor)
 }  // End of namespace python.
 }  // End of namespace jiminy.
@@ -27,6 +27,9 @@ namespace python
         void visit(PyClass & cl) const
         {
             cl
+                .def("begin_model_update", &Model::beginModelUpdate)
+                .def("end_model_update", &Model::endModelUpdate)
+                .def("randomize_model", &Model::randomizeModel)
                 .def("add_frame",
                     static_cast<
                         hresult_t (Model::*)(std::string const &, std::string const &, pinocchio::SE3 const &)
@@ -74,6 +77,7 @@ namespace python
                                                               (bp::arg("self"), "flexible_position"))
                 .def("get_rigid_velocity_from_flexible", &PyModelVisitor::getRigidVelocityFromFlexible,
                                                          (bp::arg("self"), "flexible_velocity"))
+                .def("load_visual_model", &Model::loadVisualModel)
 
                 .add_property("pinocchio_model_th", bp::make_getter(&Model::pncModelOrig_,
                                                     bp::return_internal_reference<>()))
@@ -83,11 +87,11 @@ namespace python
                                                     bp::return_internal_reference<>()))
                 .add_property("collision_model", bp::make_getter(&Model::collisionModel_,
                                                  bp::return_internal_reference<>()))
-                .add_property("visual_model_th", bp::make_getter(&Model::visualModelOrig_,
+                .add_property("visual_model_th", bp::make_function(&PyModelVisitor::getVisualModelOrig,
                                                  bp::return_internal_reference<>()))
-                .add_property("visual_model", bp::make_getter(&Model::visualModel_,
+                .add_property("visual_model", bp::make_function(&PyModelVisitor::getVisualModel,
                                               bp::return_internal_reference<>()))
-                .add_property("visual_data", bp::make_getter(&Model::visualData_,
+                .add_property("visual_data", bp::make_function(&PyModelVisitor::getVisualData,
                                              bp::return_internal_reference<>()))
                 .add_property("pinocchio_data_th", bp::make_getter(&Model::pncDataOrig_,
                                                    bp::return_internal_reference<>()))
@@ -273,6 +277,35 @@ namespace python
             return self.mdlOptions_->dynamics.enableFlexibleModel;
         }
 
+        /* The visual model is built on first access if it has been deferred. Failing to do so
+           raises an exception, rather than returning an empty model silently. */
+        static void ensureVisualModelLoaded(Model & self)
+        {
+            if (self.loadVisualModel() != hresult_t::SUCCESS)
+            {
+                PyErr_SetString(PyExc_RuntimeError, "Impossible to build the visual model.");
+                bp::throw_error_already_set();
+            }
+        }
+
+        static pinocchio::GeometryModel & getVisualModelOrig(Model & self)
+        {
+            ensureVisualModelLoaded(self);
+            return self.visualModelOrig_;
+        }
+
+        static pinocchio::GeometryModel & getVisualModel(Model & self)
+        {
+            ensureVisualModelLoaded(self);
+            return self.visualModel_;
+        }
+
+        static pinocchio::GeometryData & getVisualData(Model & self)
+        {
+            ensureVisualModelLoaded(self);
+            return self.visualData_;
+        }
+
         ///////////////////////////////////////////////////////////////////////////////
         /// \brief Expose.
         ///////////////////////////////////////////////////////////////////////////////
@@ -303,12 +336,16 @@ namespace python
                                    (bp::arg("self"), "urdf_path",
                                     bp::arg("has_freeflyer") = false,
                                     bp::arg("mesh_package_dirs") = bp::list(),
-                                    bp::arg("load_visual_meshes") = false))
+                                    bp::arg("load_visual_meshes") = false,
+                                    bp::arg("cache_dir") = std::string(),
+                                    bp::arg("defer_visual_model") = false,
+                                    bp::arg("n_threads") = 1U))
                 .def("initialize",
                     static_cast<
                         hresult_t (Robot::*)(pinocchio::Model const &, pinocchio::GeometryModel const &, pinocchio::GeometryModel const &)
                     >(&Robot::initialize),
                     (bp::arg("self"), "pinocchio_model", "collision_model", "visual_model"))
+                .def("clone", &PyRobotVisitor::clone)
 
                 .add_property("is_locked", bp::make_function(&Robot::getIsLocked,
                                            bp::return_value_policy<bp::copy_const_reference>()))
@@ -338,6 +375,9 @@ namespace python
                                    (bp::arg("self"), "sensor_type", "sensor_name"))
 
                 .add_property("sensors_data", &PyRobotVisitor::getSensorsData)
+                .add_property("sensors_data_flat", bp::make_function(&Robot::getSensorsDataFlat,
+                                                   bp::return_value_policy<result_converter<false> >()))
+                .add_property("sensors_data_offsets", &PyRobotVisitor::getSensorsDataOffsets)
 
                 .def("set_options", &PyRobotVisitor::setOptions,
                                     (bp::arg("self"), "robot_options"))
@@ -382,10 +422,25 @@ namespace python
                                     std::string const & urdfPath,
                                     bool_t      const & hasFreeflyer,
                                     bp::list    const & meshPackageDirsPy,
-                                    bool_t      const & loadVisualMeshes)
+                                    bool_t      const & loadVisualMeshes,
+                                    std::string const & cacheDir,
+                                    bool_t      const & deferVisualModel,
+                                    uint32_t    const & nThreads)
         {
             auto meshPackageDirs = convertFromPython<std::vector<std::string> >(meshPackageDirsPy);
-            return self.initialize(urdfPath, hasFreeflyer, meshPackageDirs, loadVisualMeshes);
+            return self.initialize(urdfPath, hasFreeflyer, meshPackageDirs, loadVisualMeshes, cacheDir,
+                                   deferVisualModel, nThreads);
+        }
+
+        static std::shared_ptr<Robot> clone(Robot const & self)
+        {
+            std::shared_ptr<Robot> robot;
+            if (self.clone(robot) != hresult_t::SUCCESS)
+            {
+                PyErr_SetString(PyExc_RuntimeError, "Impossible to clone the robot.");
+                bp::throw_error_already_set();
+            }
+            return robot;
         }
 
         static hresult_t detachMotors(Robot          & self,
@@ -421,6 +476,21 @@ namespace python
             return std::make_shared<sensorsDataMap_t>(self.getSensorsData());
         }
 
+        static bp::dict getSensorsDataOffsets(Robot & self)
+        {
+            bp::dict sensorsDataOffsetsPy;
+            for (auto const & sensorTypeOffsets : self.getSensorsDataOffsets())
+            {
+                bp::dict sensorTypeOffsetsPy;
+                for (auto const & sensorOffset : sensorTypeOffsets.second)
+                {
+                    sensorTypeOffsetsPy[sensorOffset.first] = sensorOffset.second;
+                }
+                sensorsDataOffsetsPy[sensorTypeOffsets.first] = sensorTypeOffsetsPy;
+            }
+            return sensorsDataOffsetsPy;
+        }
+
         static bp::dict getSensorsNames(Robot & self)
         {
             bp::dict sensorsNamesPy;